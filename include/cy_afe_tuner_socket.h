@@ -0,0 +1,171 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_tuner_socket.h
+ * @brief Reference tuner transport for POSIX host builds, serving the tuner protocol over a local
+ *        Unix domain or TCP socket.
+ *
+ * Built when CY_AFE_TUNER_SOCKET_TRANSPORT is defined along with CY_AFE_ENABLE_TUNING_FEATURE. One client
+ * is served at a time; TCP is bound to the loopback address only. The application calls the read and write
+ * functions from its tuner callbacks, for example:
+ *
+ *     static cy_rslt_t app_read_request(cy_afe_t handle, cy_afe_tuner_buffer_t *request_buffer, void *user_arg)
+ *     {
+ *         return cy_afe_tuner_socket_read(&app_tuner_socket, request_buffer);
+ *     }
+ *
+ * read_timeout_ms lets the tuner task sleep in the socket till data arrives, so poll_interval_ms can be 0
+ * with CY_AFE_TUNER_TRANSPORT_POLL.
+ */
+
+#ifndef AUDIO_FRONT_END_TUNER_SOCKET_H__
+#define AUDIO_FRONT_END_TUNER_SOCKET_H__
+
+#include "cy_audio_front_end.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CY_AFE_ENABLE_TUNING_FEATURE) && defined(CY_AFE_TUNER_SOCKET_TRANSPORT)
+
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/** Longest Unix domain socket path, including the terminating null */
+#define CY_AFE_TUNER_SOCKET_MAX_PATH_LEN     (108)
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+/**
+ * Socket family of the tuner transport
+ */
+typedef enum
+{
+    CY_AFE_TUNER_SOCKET_UNIX = 0,   /* Unix domain stream socket bound to path */
+    CY_AFE_TUNER_SOCKET_TCP         /* TCP socket bound to the loopback address and port */
+} cy_afe_tuner_socket_type_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+/**
+ * Tuner socket transport configuration
+ */
+typedef struct
+{
+    /** Socket family */
+    cy_afe_tuner_socket_type_t type;
+
+    /** Path of the socket with CY_AFE_TUNER_SOCKET_UNIX. An existing file at the path is removed. */
+    const char *path;
+
+    /** Port with CY_AFE_TUNER_SOCKET_TCP */
+    uint16_t port;
+
+    /**
+     * Time in ms a read waits for a connection or data before returning no data. 0 does not wait,
+     * a negative value waits till data arrives.
+     */
+    int read_timeout_ms;
+} cy_afe_tuner_socket_config_t;
+
+/**
+ * Tuner socket transport instance, owned by the application
+ */
+typedef struct
+{
+    cy_afe_tuner_socket_type_t type;
+    char path[CY_AFE_TUNER_SOCKET_MAX_PATH_LEN];
+    int read_timeout_ms;
+    int listen_fd;                  /* Listening socket, -1 when closed */
+    int client_fd;                  /* Connected client, -1 when none */
+    bool client_dropped;            /* A client was dropped and the next read has not reported it yet */
+} cy_afe_tuner_socket_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Create the listening socket of the tuner transport
+ *
+ * @param[out] tuner_socket     Transport instance
+ * @param[in]  config           Transport configuration
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG on invalid configuration;
+ *            CY_RSLT_AFE_SYSTEM_MODULE_ERROR if the socket cannot be created.
+ */
+cy_rslt_t cy_afe_tuner_socket_open(cy_afe_tuner_socket_t *tuner_socket, const cy_afe_tuner_socket_config_t *config);
+
+/**
+ * Close the client connection and the listening socket. The Unix domain socket path is removed.
+ *
+ * @param[in]  tuner_socket     Transport instance
+ *
+ * @return    CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_tuner_socket_close(cy_afe_tuner_socket_t *tuner_socket);
+
+/**
+ * Read request data, to be called from \ref cy_afe_read_request_callback_t. Accepts a client if none is
+ * connected. request_buffer->length is 0 if no data arrived within read_timeout_ms or the client disconnected.
+ *
+ * @param[in]  tuner_socket     Transport instance
+ * @param[out] request_buffer   Request buffer passed to the callback
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TUNER_DISCONNECTED once after a client was dropped, by
+ *            this read or by a failed write, to be returned from the callback; an error code on failure.
+ */
+cy_rslt_t cy_afe_tuner_socket_read(cy_afe_tuner_socket_t *tuner_socket, cy_afe_tuner_buffer_t *request_buffer);
+
+/**
+ * Send a response to the connected client, to be called from \ref cy_afe_write_response_callback_t
+ *
+ * @param[in]  tuner_socket     Transport instance
+ * @param[in]  response_buffer  Response buffer passed to the callback
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TUNER_GENERIC_ERROR if no client is connected or the
+ *            client disconnected.
+ */
+cy_rslt_t cy_afe_tuner_socket_write(cy_afe_tuner_socket_t *tuner_socket, cy_afe_tuner_buffer_t *response_buffer);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_TUNER_SOCKET_H__ */
@@ -95,6 +95,19 @@ extern "C" {
 
 #endif
 
+/**
+ * Maximum number of AEC reference channels downmixed by AFE.
+ */
+#ifndef CY_AFE_AEC_REF_MAX_CHANNELS
+#define CY_AFE_AEC_REF_MAX_CHANNELS (8)
+#endif
+
+/**
+ * Alignment in bytes of every allocation made from the memory passed to \ref cy_afe_create_static.
+ * Allocation sizes are rounded up to this alignment.
+ */
+#define CY_AFE_MEMORY_ALIGNMENT (16)
+
 /** \} group_afe_macros */
 /******************************************************
  *                    Constants
@@ -184,6 +197,72 @@ typedef enum {
     CY_AFE_COMPONENT_AEC
 } cy_afe_component_t;
 
+/**
+ * AFE processing mode
+ */
+typedef enum
+{
+    CY_AFE_PROCESSING_MODE_TASK = 0,    /* Frames fed by \ref cy_afe_feed are queued and processed in the AFE processing task */
+    CY_AFE_PROCESSING_MODE_SYNC,        /* No AFE processing task is created. Frames are processed in the caller context by \ref cy_afe_process or \ref cy_afe_feed */
+    CY_AFE_PROCESSING_MODE_ADAPTIVE     /* \ref cy_afe_feed processes the frame in the caller context when called from a task and no frame is pending,
+                                           else the frame is queued to the AFE processing task. A frame fed while a frame is processed in the
+                                           caller is queued and processed after it; frames are still queued by one feed at a time, refer
+                                           \ref cy_afe_feed. */
+} cy_afe_processing_mode_t;
+
+/**
+ * AFE output delivery mode
+ */
+typedef enum
+{
+    CY_AFE_OUTPUT_MODE_CALLBACK = 0,    /* Output is pushed to application through \ref cy_afe_output_callback_t */
+    CY_AFE_OUTPUT_MODE_PULL             /* Output is queued and application reads it with \ref cy_afe_read_output */
+} cy_afe_output_mode_t;
+
+/**
+ * AFE input buffer ownership mode
+ */
+typedef enum
+{
+    CY_AFE_INPUT_MODE_REFERENCE = 0,    /* Input and AEC reference buffers are used in place and are returned through \ref cy_afe_output_callback_t */
+    CY_AFE_INPUT_MODE_COPY              /* Input and AEC reference are copied to AFE internal buffers by \ref cy_afe_feed, application
+                                           may reuse its buffers once feed returns */
+} cy_afe_input_mode_t;
+
+/**
+ * Layout of stereo input samples
+ */
+typedef enum
+{
+    CY_AFE_INPUT_LAYOUT_NON_INTERLEAVED = 0, /* One frame of channel-1 followed by one frame of channel-2 */
+    CY_AFE_INPUT_LAYOUT_INTERLEAVED          /* Channel-1 and channel-2 samples alternate, as delivered by I2S/TDM drivers */
+} cy_afe_input_layout_t;
+
+/**
+ * Sample format of application input, AEC reference and output buffers. Speech enhancement always runs on 16 bit samples.
+ */
+typedef enum
+{
+    CY_AFE_SAMPLE_FORMAT_S16 = 0,       /* 16 bit signed samples (CY_AFE_DATA_T) */
+    CY_AFE_SAMPLE_FORMAT_S32,           /* 32 bit signed samples, full scale 32 bit. 24 bit samples left justified in 32 bit words are fed in this format */
+    CY_AFE_SAMPLE_FORMAT_S24_IN_32,     /* 24 bit signed samples right justified in 32 bit words. On input the upper byte is ignored, on output it holds the sign extension */
+    CY_AFE_SAMPLE_FORMAT_F32            /* 32 bit float samples, full scale +/-1.0. Out of range input saturates */
+} cy_afe_sample_format_t;
+
+/**
+ * Policy applied by \ref cy_afe_feed when the input frame queue is full
+ */
+typedef enum
+{
+    CY_AFE_OVERLOAD_POLICY_DROP_NEWEST = 0, /* Frame being fed is not queued and \ref cy_afe_feed returns CY_RSLT_AFE_QUEUE_FULL */
+    CY_AFE_OVERLOAD_POLICY_BLOCK,           /* \ref cy_afe_feed waits up to overload_block_timeout_ms for a free slot. When called from ISR
+                                               or when the wait times out, frame is dropped as in CY_AFE_OVERLOAD_POLICY_DROP_NEWEST */
+    CY_AFE_OVERLOAD_POLICY_DROP_OLDEST      /* Oldest queued frame is discarded together with its AEC reference, so that input and reference
+                                               stay aligned, and the frame being fed is queued. Discarded frames are returned through
+                                               \ref cy_afe_output_callback_t; if input_queue_size discarded frames are still to be returned,
+                                               frame being fed is dropped as in CY_AFE_OVERLOAD_POLICY_DROP_NEWEST */
+} cy_afe_overload_policy_t;
+
 /**
  * Memory ID configuration
  */
@@ -201,9 +280,24 @@ typedef enum
     CY_AFE_MEM_ID_ALGORITHM_ES_MEMORY, /* AFE algorithm DSES memory - Required 16byte aligned buffer address */
     CY_AFE_MEM_ID_GDE_PERSISTENT_MEM,  /* GDE persistent memory */
     CY_AFE_MEM_ID_GENERIC_MEMORY, /* Generic memory */
+    CY_AFE_MEM_ID_AFE_INPUT_QUEUE, /* AFE input frame queue */
+    CY_AFE_MEM_ID_AFE_OUTPUT_QUEUE, /* AFE output dispatch queue */
+    CY_AFE_MEM_ID_AFE_RESAMPLE_BUFFER, /* AFE resampler history and core rate frames */
     CY_AFE_MEM_ID_MAX
 } cy_afe_mem_id_t;
 
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+/**
+ * How the AFE tuner task waits for requests from the configurator tool
+ */
+typedef enum
+{
+    CY_AFE_TUNER_TRANSPORT_POLL = 0,  /* read_request_callback is invoked again poll_interval_ms after a read returned no data */
+    CY_AFE_TUNER_TRANSPORT_NOTIFY     /* Tuner task blocks till the application calls \ref cy_afe_tuner_notify_rx, typically from
+                                         the receive interrupt of the transport, then reads till no data is returned */
+} cy_afe_tuner_transport_t;
+#endif
+
 /** \} group_afe_enums */
 
  /**
@@ -237,6 +331,164 @@ typedef enum
 #endif
  }cy_afe_buffer_info_t;
 
+/**
+ * Circular input buffer written by the application's input driver (for example a PDM or I2S DMA
+ * in circular mode). AFE reads the frames in place and the driver only notifies the number of
+ * new samples with \ref cy_afe_notify_input_samples.
+ */
+typedef struct
+{
+    /**
+     * Circular buffer of size_in_samples samples per channel. For stereo, the channel-2 ring
+     * immediately follows the channel-1 ring (non-interleaved, same as \ref cy_afe_feed).
+     */
+    CY_AFE_DATA_T *input_buffer;
+    /** Circular buffer of size_in_samples mono AEC reference samples, written in step with input_buffer. Can be NULL. */
+    CY_AFE_DATA_T *aec_ref_buffer;
+    /**
+     * Number of samples of one channel in the ring, at least two frames. A multiple of the frame size
+     * (frame_size_ms worth of samples) keeps every frame contiguous, else frames crossing the end of the ring are copied.
+     */
+    uint32_t size_in_samples;
+} cy_afe_input_ring_t;
+
+/**
+ * Sample format descriptor of application buffers. Samples are converted to or from 16 bit with rounding and saturation.
+ */
+typedef struct
+{
+    /** Sample format. Refer \ref cy_afe_sample_format_t. */
+    cy_afe_sample_format_t sample_format;
+    /**
+     * Add triangular dither of +/-1 LSB when samples are reduced to 16 bit, which turns the quantization error of low level
+     * signals into noise. Used only for input formats other than CY_AFE_SAMPLE_FORMAT_S16.
+     */
+    bool dither;
+} cy_afe_format_t;
+
+/**
+ * Input queue overload counters of an AFE instance. Counters are updated by the context feeding the frames.
+ */
+typedef struct cy_afe_overload_stats_s
+{
+    /** Number of frames rejected by \ref cy_afe_feed / \ref cy_afe_feed_batch, including the frames rejected after a block timeout */
+    uint32_t frames_dropped_newest;
+    /** Number of queued frames discarded to make room for newer frames (CY_AFE_OVERLOAD_POLICY_DROP_OLDEST) */
+    uint32_t frames_dropped_oldest;
+    /** Number of times feed had to wait for a free slot (CY_AFE_OVERLOAD_POLICY_BLOCK) */
+    uint32_t block_count;
+    /** Number of waits which timed out (CY_AFE_OVERLOAD_POLICY_BLOCK) */
+    uint32_t block_timeout_count;
+    /** Longest time in ms feed had to wait for a free slot */
+    uint32_t max_block_time_ms;
+    /** Highest number of frames queued at once */
+    uint32_t max_queue_depth;
+    /** Number of frames currently queued */
+    uint32_t queue_depth;
+    /** Number of times AFE processing task had to wait for the output consumer (output_queue_size configured) */
+    uint32_t output_stall_count;
+    /** Longest time in ms processing had to wait for the output dispatch task */
+    uint32_t max_output_stall_ms;
+    /** Highest number of outputs queued to the output dispatch task at once */
+    uint32_t max_output_queue_depth;
+    /**
+     * Number of times all internal output buffers were held. AFE processing task waits for a release up to
+     * AFE_OUTPUT_WAIT_TIMEOUT_MS; a frame processed in the caller context fails at once with CY_RSLT_AFE_QUEUE_FULL.
+     */
+    uint32_t output_pool_exhausted_count;
+    /**
+     * Number of outputs dropped because the output queue stayed full. Only AFE processing task waits for the
+     * consumer, up to AFE_OUTPUT_WAIT_TIMEOUT_MS; when a frame is processed in the caller context, the
+     * output is dropped at once and the call returns CY_RSLT_AFE_QUEUE_FULL.
+     */
+    uint32_t output_drop_count;
+} cy_afe_overload_stats_t;
+
+/**
+ * Memory held by an AFE instance, including the memory of the speech enhancement library. Memory is requested
+ * by \ref cy_afe_create and by \ref cy_afe_bd_calc_init, and returned by \ref cy_afe_bd_calc_deinit and when
+ * the speech enhancement library releases it.
+ */
+typedef struct cy_afe_memory_usage_s
+{
+    /** Bytes currently held for each memory ID, indexed by \ref cy_afe_mem_id_t */
+    uint32_t bytes[CY_AFE_MEM_ID_MAX];
+    /** Sum of all memory IDs */
+    uint32_t total_bytes;
+} cy_afe_memory_usage_t;
+
+/**
+ * Memory currently held by the speech enhancement library of an AFE instance, per component. Which components are
+ * instantiated is decided by the filter settings, refer \ref cy_afe_update_filter_settings.
+ */
+typedef struct
+{
+    /** Beamformer persistent memory */
+    uint32_t bf_bytes;
+    /** DSNS (deep subband noise suppression) model memory */
+    uint32_t dsns_bytes;
+    /** DSES (deep subband echo suppression) model memory */
+    uint32_t dses_bytes;
+    /** GDE persistent memory */
+    uint32_t gde_bytes;
+    /** Persistent memory shared by HPF, AEC, NS, ES, DRVB and analysis / synthesis */
+    uint32_t shared_persistent_bytes;
+    /** Scratch memory shared by all components */
+    uint32_t scratch_bytes;
+    /** Library handle and other memory */
+    uint32_t other_bytes;
+    /** Sum of all fields */
+    uint32_t total_bytes;
+} cy_afe_component_memory_t;
+
+/**
+ * Memory required by an AFE instance for one memory ID
+ */
+typedef struct
+{
+    /** Bytes required, including the rounding of each allocation to CY_AFE_MEMORY_ALIGNMENT */
+    uint32_t size;
+    /** Required alignment in bytes of a region holding this memory ID */
+    uint32_t alignment;
+} cy_afe_memory_requirement_t;
+
+/**
+ * Memory required by an AFE instance, returned by \ref cy_afe_get_memory_requirements
+ */
+typedef struct
+{
+    /** Requirement of each memory ID, indexed by \ref cy_afe_mem_id_t */
+    cy_afe_memory_requirement_t mem[CY_AFE_MEM_ID_MAX];
+    /** Size of a single arena holding all memory IDs */
+    uint32_t total_size;
+} cy_afe_memory_requirements_t;
+
+/**
+ * Memory region provided by the application
+ */
+typedef struct
+{
+    /** Start of the region, aligned to CY_AFE_MEMORY_ALIGNMENT */
+    void *buffer;
+    /** Size of the region in bytes */
+    uint32_t size;
+} cy_afe_memory_region_t;
+
+/**
+ * Memory passed to \ref cy_afe_create_static. All memory of the instance is carved from these regions,
+ * the heap and the alloc_memory / free_memory callbacks are not used.
+ */
+typedef struct
+{
+    /** Region holding every memory ID which has no region of its own */
+    cy_afe_memory_region_t arena;
+    /**
+     * Optional region of each memory ID, indexed by \ref cy_afe_mem_id_t, to place a memory ID in a specific memory
+     * (for example CY_AFE_MEM_ID_ALGORITHM_NS_MEMORY in SOCMEM). Regions whose buffer is NULL are not used.
+     */
+    cy_afe_memory_region_t regions[CY_AFE_MEM_ID_MAX];
+} cy_afe_static_memory_t;
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 /**
  * AFE tuner buffer for request - response
@@ -260,6 +512,20 @@ typedef struct cy_afe_tuner_buffer_s
 
 }cy_afe_tuner_buffer_t;
 
+/**
+ * Tuner parameter update counters. Parameters set by the tuner are staged and applied by the processing
+ * context at the next frame boundary.
+ */
+typedef struct
+{
+    /** Number of staged updates applied. Commands received while an update is still staged are merged into it. */
+    uint32_t updates_applied;
+    /** Time in ms from the set command to the change being applied, for the latest update */
+    uint32_t last_apply_latency_ms;
+    /** Highest time in ms from a set command to the change being applied */
+    uint32_t max_apply_latency_ms;
+} cy_afe_tuner_stats_t;
+
 /**
  * Audio front end configuration settings are provided based on settings received over UART dynamically through audio configurator
  * tool.
@@ -312,11 +578,15 @@ typedef struct {
  * Callback to get filtered audio data from audio front end middleware
  *
  * The callback will be invoked in the audio front end middleware thread context, next AFE input data will be only processed
- * once application returns from callback. Application can make use of \ref cy_afe_buffer_info_t buffer pointers to free the allocated memory
+ * once application returns from callback. If output_queue_size is configured, the callback is invoked from a separate output
+ * dispatch thread and next frames are processed while application is handling the output. Application can make use of \ref cy_afe_buffer_info_t buffer pointers to free the allocated memory
  * for output buffer, input buffer and AEC buffer (If AEC submodule is enabled) pointers for which memory allocated by
  * application will be provided. If output buffer memory is allocated by AFE middleware then application doesnt need to
  * free the memory..
  *
+ * With CY_AFE_OVERLOAD_POLICY_DROP_OLDEST, the callback is also invoked for each discarded frame with output_buf set to NULL,
+ * so that application can free/reuse the input and AEC buffers of that frame.
+ *
  * @param[in] handle                Pointer to AFE middleware instance which was created during \ref cy_afe_create API
  * @param[in] output_buffer         Pointer to \ref cy_afe_buffer_info_t with output buffer, input buffer, AEC buffer pointers
  * @param[in] user_arg              User argument
@@ -339,7 +609,7 @@ typedef cy_rslt_t (*cy_afe_output_callback_t)(cy_afe_t handle, cy_afe_buffer_inf
  * memory will be reused in subsequent calls of \ref cy_afe_output_callback_t.
  *
  * @param[in] handle                Pointer to AFE middleware instance which was created during \ref cy_afe_create API
- * @param[out] output_buffer        Pointer to output buffer to fill the filtered output data
+ * @param[out] output_buffer        Pointer to output buffer to fill the filtered output data, one frame in the configured output_format
  * @param[in] user_arg              User argument
  *
  * @return    cy_rslt_t
@@ -396,11 +666,15 @@ typedef cy_rslt_t (*cy_afe_write_response_callback_t)(cy_afe_t handle, cy_afe_tu
  * Callback function to receive request from configurator tool over transport (Ex. UART)
  *
  * Application can choose to block (to wait for data from transport) or return the context back to AFE middleware. Once the
- * context is returned back to AFE middleware, callback will be invoked after poll_timeout configured during AFE initialization.
+ * context is returned back to AFE middleware, callback will be invoked after poll_timeout configured during AFE initialization,
+ * or on the next \ref cy_afe_tuner_notify_rx with CY_AFE_TUNER_TRANSPORT_NOTIFY.
  *
  * AFE middleware will allocate memory for request_buffer, hence application need to copy the data to \ref cy_afe_tuner_buffer_t.
  * freeing the memory for \ref cy_afe_tuner_buffer_t will be taken care by middleware.
  *
+ * Return CY_RSLT_AFE_TUNER_DISCONNECTED when the configurator tool disconnected: the partially received command is
+ * dropped and an open tuner transaction is aborted, so the next connection starts from a clean state.
+ *
  * @param[in]  handle               Pointer to AFE middleware instance which was passed during \ref cy_afe_create API
  * @param[out] request_buffer       Pointer to request_buffer. memory for the request buffer (data) will be allocated by the middleware.
  * @param[in]  user_arg             User argument
@@ -508,10 +782,10 @@ typedef struct
      *
      * User may choose to register the callback to provide the memory for the output buffer. If callback is registered,
      * then AFE middleware will invoke the callback to get memory for output buffer. And ownership of freeing the buffer
-     * is with the application. If callback is not registered, AFE middleware will have the default implementation of callback
-     * through which static buffer memory will be used, output data will be filled and provided to application through
-     * \ref cy_afe_output_callback_t callback. Note that, static buffer memory will be used in subsequent output callbacks and
-     * user doesn't need to free the memory.
+     * is with the application. If callback is not registered, AFE middleware will use a pre-allocated pool of output_pool_size
+     * buffers, output data will be filled and provided to application through \ref cy_afe_output_callback_t callback. The buffer
+     * returns to the pool once the callback returns, unless application holds it with \ref cy_afe_hold_output. User doesn't
+     * need to free the memory.
      */
     cy_afe_get_output_buffer_callback_t afe_get_buffer_callback;
 
@@ -532,6 +806,25 @@ typedef struct
      * Configure poll_interval in ms. poll_interval will be used by AFE middleware to invoke read_callback periodically.
      */
     int poll_interval_ms;
+
+    /**
+     * Transport mode of the tuner. Refer \ref cy_afe_tuner_transport_t. poll_interval_ms is not used
+     * with CY_AFE_TUNER_TRANSPORT_NOTIFY.
+     */
+    cy_afe_tuner_transport_t tuner_transport;
+
+    /**
+     * Size in bytes of the request buffer passed to read_request_callback, up to 65535.
+     * If 0 is passed, CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE (default 100) is used.
+     */
+    uint32_t tuner_request_buffer_size;
+
+    /**
+     * Size in bytes of the buffer accumulating received data till a command is complete, up to 65535. It bounds
+     * the longest command and the number of commands which can be batched in one read.
+     * If 0 is passed, CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE (default 500) is used.
+     */
+    uint32_t tuner_command_buffer_size;
 #endif
 
     /** Memory Callback to get memory from the application. */
@@ -540,6 +833,124 @@ typedef struct
     /** Memory Callback to free memory back to the application. */
     cy_afe_free_memory_callback_t  free_memory;
 
+    /**
+     * Maximum number of input frames which can be queued by \ref cy_afe_feed before they are
+     * processed. If 0 is passed, AFE_AUDIO_PROCESSING_MSG_QUEUE_SIZE (default 30) is used.
+     */
+    uint32_t input_queue_size;
+
+    /**
+     * Processing mode of the AFE instance. Refer \ref cy_afe_processing_mode_t.
+     * afe_output_callback is optional in CY_AFE_PROCESSING_MODE_SYNC mode.
+     */
+    cy_afe_processing_mode_t processing_mode;
+
+    /**
+     * Policy applied when the input frame queue is full. Refer \ref cy_afe_overload_policy_t.
+     */
+    cy_afe_overload_policy_t overload_policy;
+
+    /**
+     * Maximum time in ms \ref cy_afe_feed waits for a free slot with CY_AFE_OVERLOAD_POLICY_BLOCK.
+     * CY_RTOS_NEVER_TIMEOUT waits till a slot is free.
+     */
+    uint32_t overload_block_timeout_ms;
+
+    /**
+     * Maximum number of outputs queued to the output dispatch thread. If 0 is passed, afe_output_callback is invoked
+     * from the processing context. Not used when CY_AFE_ENABLE_TUNING_FEATURE is enabled.
+     */
+    uint32_t output_queue_size;
+
+    /**
+     * Output delivery mode. Refer \ref cy_afe_output_mode_t. afe_output_callback is not used in CY_AFE_OUTPUT_MODE_PULL mode.
+     * In pull mode, output_queue_size is the number of outputs which can be queued for \ref cy_afe_read_output
+     * (default 8 if 0 is passed), and output_queue_size + 2 internal output buffers are allocated if afe_get_buffer_callback
+     * is not registered. Holding more buffers at a time reduces the number of outputs which can be queued.
+     */
+    cy_afe_output_mode_t output_mode;
+
+    /**
+     * Number of internal output buffers, used if afe_get_buffer_callback is not registered. If 0 is passed, output_queue_size + 2
+     * buffers are allocated when outputs are queued, else AFE_OUTPUT_POOL_SIZE (default 4). When all the buffers are held,
+     * output_pool_exhausted_count is incremented and the frame fails with CY_RSLT_AFE_QUEUE_FULL, after a bounded wait for
+     * a release in AFE processing task.
+     */
+    uint32_t output_pool_size;
+
+    /**
+     * Input buffer ownership mode. Refer \ref cy_afe_input_mode_t. In CY_AFE_INPUT_MODE_COPY mode, input_queue_size + 2
+     * internal input frames are allocated and input_buf and input_aec_ref_buf of \ref cy_afe_buffer_info_t are NULL.
+     */
+    cy_afe_input_mode_t input_mode;
+
+    /**
+     * Circular input buffer read in place by AFE. If input_ring.input_buffer is NULL, input is passed with \ref cy_afe_feed.
+     * Else input is notified with \ref cy_afe_notify_input_samples and \ref cy_afe_feed is not used. Not supported
+     * in CY_AFE_PROCESSING_MODE_SYNC mode; input_mode and overload_policy are not used. If AFE does not keep up, the oldest
+     * frames about to be overwritten by the driver are skipped and counted in frames_dropped_oldest.
+     */
+    cy_afe_input_ring_t input_ring;
+
+    /**
+     * Input sample rate in Hz. If 0 is passed, AFE_FRAME_RATE_SPS of the configurator generated settings is used.
+     * Supported values: 16000, and 48000 which is decimated to 16000 inside AFE. Input, AEC reference and output
+     * frames are at this rate, debug outputs are at the 16000 rate of speech enhancement.
+     */
+    uint32_t sample_rate;
+
+    /**
+     * Frame duration in ms. If 0 is passed, AFE_FRAME_SIZE_MS of the configurator generated settings is used.
+     * Supported value: 10.
+     */
+    uint32_t frame_size_ms;
+
+    /**
+     * Number of input channels, 1 (mono) or 2 (stereo). If 0 is passed, AFE_INPUT_NUMBER_CHANNELS of the configurator
+     * generated settings is used. Must match the number of microphones of filter_settings.
+     */
+    uint32_t num_channels;
+
+    /**
+     * Layout of stereo input. Refer \ref cy_afe_input_layout_t. Interleaved input is split by AFE while it is copied in
+     * CY_AFE_INPUT_MODE_COPY mode and by \ref cy_afe_feed_samples, else just before processing. Also the layout of AEC reference
+     * of more than one channel. Not used for mono input and mono reference, and not supported with input_ring.
+     */
+    cy_afe_input_layout_t input_layout;
+
+    /**
+     * Sample format of input and AEC reference buffers. Refer \ref cy_afe_format_t. Formats other than CY_AFE_SAMPLE_FORMAT_S16 are
+     * converted while the input is copied in CY_AFE_INPUT_MODE_COPY mode and by \ref cy_afe_feed_samples, else just before
+     * processing. Buffer sizes passed to AFE scale with the sample size. Not supported with input_ring.
+     */
+    cy_afe_format_t input_format;
+
+    /**
+     * Sample format of output buffers. Refer \ref cy_afe_format_t. Output buffers, including the ones returned by
+     * afe_get_buffer_callback, hold one frame in this format. Debug outputs stay 16 bit.
+     */
+    cy_afe_format_t output_format;
+
+    /**
+     * Number of AEC reference channels, 1 to CY_AFE_AEC_REF_MAX_CHANNELS. If 0 is passed, mono reference is used. Reference of more
+     * than one channel is laid out as input_layout (for interleaved layout, one sample of every channel per sample period) and is
+     * downmixed to mono while it is copied or converted, the same as the input. Multi-channel reference is not supported with input_ring.
+     */
+    uint32_t aec_ref_num_channels;
+
+    /**
+     * Downmix weight of each AEC reference channel in Q15 (32767 is 1.0), aec_ref_num_channels entries. If NULL, all channels
+     * are averaged. Sum of the absolute weights must not exceed 65535. Copied by \ref cy_afe_create.
+     */
+    const int16_t *aec_ref_downmix_weights;
+
+    /**
+     * Lend the scratch memory of speech enhancement to the application between frames. The scratch memory
+     * (CY_AFE_MEM_ID_ALGORITHM_SCRATCH_MEMORY) is used only while a frame is processed; if set, the application
+     * can borrow it with \ref cy_afe_acquire_scratch_memory, for example for a keyword detection stage run on the output.
+     */
+    bool share_scratch_memory;
+
 } cy_afe_config_t;
 
 
@@ -558,7 +969,8 @@ typedef struct
  ******************************************************/
 
 /**
- * Creates an instance of AFE middleware
+ * Creates an instance of AFE middleware. Instances can be created and deleted from different threads at the
+ * same time; the speech enhancement library setup of each is serialized internally.
  *
  * @param[in]   config_init       Configuration for audio front end middleware initialization
  * @param[out]  handle            Audio front end middleware handle which is allocated by middleware
@@ -568,26 +980,297 @@ typedef struct
 cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle);
 
 /**
- * Feed the audio data to audio front end middleware (10ms worth of data)
+ * Get the memory required by an AFE instance created with config_init, per memory ID. Memory owned by AFE is
+ * computed from config_init; no instance, task or queue is created. The speech enhancement library is initialized
+ * and de-initialized once to collect the memory it requests, so that memory and a temporary AFE context are
+ * allocated with the alloc_memory callback of config_init, else from the heap, while this API runs. Memory of the
+ * bulk delay measurement (\ref cy_afe_bd_calc_init) is not included. No headroom is added for
+ * \ref cy_afe_update_filter_settings: a static instance reserves the library memory of the filter settings it is
+ * created with, and later settings must fit in that reservation.
+ *
+ * @param[in]   config_init       Configuration which will be passed to \ref cy_afe_create_static
+ * @param[out]  requirements      Memory requirements
+ *
+ * @return    CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_get_memory_requirements(cy_afe_config_t *config_init, cy_afe_memory_requirements_t *requirements);
+
+/**
+ * Creates an instance of AFE middleware in application provided memory. Memory is carved from the regions of
+ * memory with a bump allocator, the heap is not used by the instance after this API returns. Sizes are obtained
+ * with \ref cy_afe_get_memory_requirements. The memory must stay valid until \ref cy_afe_delete returns.
+ * Threads and RTOS objects of the instance are created by the RTOS. Memory of the speech enhancement library
+ * which has no region of its own is reserved in the arena at creation, refer \ref cy_afe_update_filter_settings.
+ *
+ * @param[in]   config_init       Configuration for audio front end middleware initialization.
+ *                                alloc_memory and free_memory are not used.
+ * @param[in]   memory            Memory of the instance
+ * @param[out]  handle            Audio front end middleware handle
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_OUT_OF_MEMORY if memory is too small; an error code on failure.
+ */
+cy_rslt_t cy_afe_create_static(cy_afe_config_t *config_init, const cy_afe_static_memory_t *memory, cy_afe_t *handle);
+
+/**
+ * Feed the audio data to audio front end middleware (one frame, frame_size_ms worth of data)
  *
  * Memory for the input buffer & aec reference data (if AEC is enabled) need to be allocated by application. Application shall not free/reuse
  * input buffer & AEC reference buffer till AFE middleware provides \ref cy_afe_output_callback_t callback. Application may have choice to
  * handle (free/reuse) the input & aec reference buffers on \ref cy_afe_output_callback_t callback.
+ * With CY_AFE_INPUT_MODE_COPY, the data is copied before feed returns and application may reuse both buffers right away.
  *
- * If Application needs to feed stereo data, then the data format must be non-interleaved format. example: For stereo data of 10ms
- * worth, first 320bytes must be of channel-1 and then next 320bytes must be channel-2. application must pass enough number of
+ * If Application needs to feed stereo data, then the data format must be non-interleaved format unless input_layout is
+ * CY_AFE_INPUT_LAYOUT_INTERLEAVED. example: For non-interleaved stereo data of 10ms worth at 16kHz, first 320bytes must be of
+ * channel-1 and then next 320bytes must be channel-2. application must pass enough number of
  * bytes, if it doesn't pass then AFE middleware can go into unexpected state.
  *
- * AEC reference data shall be mono only.
+ * AEC reference data holds aec_ref_num_channels channels, in the same layout as the input; reference of more than one
+ * channel is downmixed to mono by AFE.
+ *
+ * Can be called from a task, or from ISR context unless processing mode is CY_AFE_PROCESSING_MODE_SYNC. Frames of an instance
+ * are queued by one feed at a time: a feed which starts while another feed of the same instance is queueing frames, for example
+ * from an ISR which preempted it, is rejected with CY_RSLT_AFE_BUSY and its frame is not queued. Application feeding one
+ * instance from more than one context must serialize the feeds. A frame processed in the caller context does not hold off
+ * other feeds, in CY_AFE_PROCESSING_MODE_SYNC frames fed from different tasks are processed one at a time.
  *
  * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
  * @param[in]  input_buffer     Pointer to input buffer to pass the audio data
- * @param[in]  aec_ref          AEC reference mono audio data
+ * @param[in]  aec_ref          AEC reference audio data of aec_ref_num_channels channels
  *
- * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_QUEUE_FULL if the frame is not queued, or if it is processed in the
+ *             caller context and its output is dropped; CY_RSLT_AFE_BUSY if another feed of the instance is in progress;
+ *             an error code on failure.
  */
 cy_rslt_t cy_afe_feed(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref);
 
+/**
+ * Feed a block of consecutive audio frames (num_frames x frame_size_ms worth of data) to audio front end middleware
+ *
+ * Frames are laid out back to back in input_buffer, each frame in the same format as \ref cy_afe_feed
+ * (for non-interleaved stereo: one frame of channel-1 followed by one frame of channel-2). AEC reference, if passed, holds
+ * num_frames reference frames back to back. Either all or none of the frames are accepted, and the AFE processing
+ * task is woken up only once for the whole block. \ref cy_afe_output_callback_t is invoked once per frame,
+ * application may reuse the block after the callback of the last frame, or once feed returns with CY_AFE_INPUT_MODE_COPY.
+ * Can be called from the same contexts as \ref cy_afe_feed, with the same restriction of one feed at a time.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  input_buffer     Pointer to num_frames frames of audio data
+ * @param[in]  aec_ref          num_frames frames of AEC reference audio data, can be NULL
+ * @param[in]  num_frames       Number of frames in the block
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BUSY if another feed of the instance is in progress; an error code on failure.
+ */
+cy_rslt_t cy_afe_feed_batch(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref, uint32_t num_frames);
+
+/**
+ * Feed any number of audio samples to audio front end middleware
+ *
+ * Samples are gathered into frames of frame_size_ms inside AFE, so that input periods of other durations (for example 4ms, 8ms or 16ms)
+ * can be fed directly. Each sample is copied once, straight into the internal frame which is processed, and application may
+ * reuse both buffers once the call returns. Input is in the configured input_layout: for non-interleaved stereo, num_samples samples
+ * of channel-1 followed by num_samples samples of channel-2, for interleaved stereo num_samples sample pairs. AEC reference, if passed, holds num_samples samples per reference channel; it should be passed
+ * with every call or never, missing reference samples of a frame are zero.
+ *
+ * Requires CY_AFE_INPUT_MODE_COPY unless processing mode is CY_AFE_PROCESSING_MODE_SYNC. Must not be mixed with \ref cy_afe_feed
+ * and \ref cy_afe_feed_batch on the same instance. If a complete frame can not be queued, the frame is dropped, the remaining samples
+ * are still consumed so that later frames stay aligned, and CY_RSLT_AFE_QUEUE_FULL is returned. Samples are gathered by one call at a
+ * time, a call made while another call of the same instance is in progress is rejected with CY_RSLT_AFE_BUSY and its samples are not consumed.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  input_buffer     Pointer to num_samples samples per channel
+ * @param[in]  aec_ref          num_samples samples per channel of AEC reference audio data, can be NULL
+ * @param[in]  num_samples      Number of samples per channel
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_feed_samples(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref, uint32_t num_samples);
+
+/**
+ * Notify new samples written to the circular input buffer registered with input_ring of \ref cy_afe_config_t
+ *
+ * Can be called from ISR context, typically from the DMA interrupt of the input driver. num_samples is the number of
+ * samples per channel written since the last notification. Complete frames are processed in place by the AFE processing task.
+ * AEC reference, if registered, must have been written up to the same position.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  num_samples      Number of new samples per channel
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_INVALID_PROCESSING_MODE if no input ring is registered.
+ */
+cy_rslt_t cy_afe_notify_input_samples(cy_afe_t handle, uint32_t num_samples);
+
+/**
+ * Process the audio data (one frame, frame_size_ms worth of data) in the caller context and return the output synchronously
+ *
+ * This API is available only when the instance is created with CY_AFE_PROCESSING_MODE_SYNC and shall not be
+ * called from ISR context. Input buffer format is same as \ref cy_afe_feed. If afe_output_callback is registered,
+ * it is also invoked before this API returns. Buffers returned in output are valid till the next call of this API.
+ * With CY_AFE_OUTPUT_MODE_PULL, output must be NULL and the output is read with \ref cy_afe_read_output.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  input_buffer     Pointer to input buffer to pass the audio data
+ * @param[in]  aec_ref          AEC reference audio data of aec_ref_num_channels channels
+ * @param[out] output           Output buffer information. Can be NULL if output is consumed in afe_output_callback.
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_QUEUE_FULL if the output queue is full and the output is dropped,
+ *             output is not filled then; an error code on failure.
+ */
+cy_rslt_t cy_afe_process(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref, cy_afe_buffer_info_t *output);
+
+/**
+ * Read the next processed frame of an instance created with CY_AFE_OUTPUT_MODE_PULL
+ *
+ * Output is returned without copy. output_buf points to an internal buffer (or to the buffer provided by
+ * afe_get_buffer_callback) which stays valid till it is returned with \ref cy_afe_release_output. Input and AEC
+ * buffers passed in \ref cy_afe_feed are returned in input_buf and input_aec_ref_buf. Frames dropped with
+ * CY_AFE_OVERLOAD_POLICY_DROP_OLDEST are returned with output_buf set to NULL.
+ *
+ * This API shall be called from a single thread at a time, and shall not wait (timeout_ms != 0) from ISR context.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] output           Output buffer information
+ * @param[in]  timeout_ms       Time to wait for a processed frame. 0 returns immediately, CY_RTOS_NEVER_TIMEOUT waits forever.
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TIMEOUT if no frame was ready in time; an error code on failure.
+ */
+cy_rslt_t cy_afe_read_output(cy_afe_t handle, cy_afe_buffer_info_t *output, uint32_t timeout_ms);
+
+/**
+ * Read any number of processed output samples of an instance created with CY_AFE_OUTPUT_MODE_PULL
+ *
+ * Output frames are split across calls as needed, so that output periods other than frame_size_ms can be read directly.
+ * Internal output buffers are released as soon as all their samples are read. Frames dropped by the input queue
+ * overload policy do not produce samples. Must not be mixed with \ref cy_afe_read_output on the same instance.
+ *
+ * @param[in]   handle          Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out]  output          Buffer of num_samples samples in the configured output_format
+ * @param[in]   num_samples     Number of samples to read
+ * @param[out]  samples_read    Number of samples read, can be NULL
+ * @param[in]   timeout_ms      Maximum time to wait for num_samples samples. 0 returns the samples available right away.
+ *
+ * @return     CY_RSLT_SUCCESS if num_samples samples were read; CY_RSLT_AFE_TIMEOUT if fewer samples were available in time;
+ *             CY_RSLT_AFE_INVALID_PROCESSING_MODE if the instance is not in pull mode.
+ */
+cy_rslt_t cy_afe_read_output_samples(cy_afe_t handle, CY_AFE_DATA_T *output, uint32_t num_samples,
+        uint32_t *samples_read, uint32_t timeout_ms);
+
+/**
+ * Hold the internal output buffer of an output, so that it is not reused for next frames
+ *
+ * Each hold adds a reference to the buffer, which must be dropped with \ref cy_afe_release_output. This allows several
+ * consumers to share an output frame without copy. It can be called in \ref cy_afe_output_callback_t or on an output read
+ * with \ref cy_afe_read_output, and from any thread.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  output           Output buffer information provided by AFE middleware
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if output_buf is not an internal buffer in use.
+ */
+cy_rslt_t cy_afe_hold_output(cy_afe_t handle, cy_afe_buffer_info_t *output);
+
+/**
+ * Drop a reference of the output buffer read with \ref cy_afe_read_output or held with \ref cy_afe_hold_output.
+ * The buffer returns to the AFE middleware once the last reference is dropped. Can be called from any thread.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  output           Output buffer information returned by \ref cy_afe_read_output
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_release_output(cy_afe_t handle, cy_afe_buffer_info_t *output);
+
+/**
+ * Get the input queue overload counters of the AFE instance
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] stats            Overload counters
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_get_overload_stats(cy_afe_t handle, cy_afe_overload_stats_t *stats);
+
+/**
+ * Get the memory currently held by the AFE instance per memory ID. Single microphone instances do not request
+ * CY_AFE_MEM_ID_ALGORITHM_BF_MEMORY.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] usage            Memory usage
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_get_memory_usage(cy_afe_t handle, cy_afe_memory_usage_t *usage);
+
+/**
+ * Get the memory currently held by each speech enhancement component of the AFE instance
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] report           Bytes held per component
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_get_component_memory(cy_afe_t handle, cy_afe_component_memory_t *report);
+
+/**
+ * Replace the filter settings of the AFE instance. The speech enhancement library allocates the memory of a component
+ * when it is initialized with filter settings enabling it, and disabling a component with the tuner does not release its
+ * memory. To release the memory of a component disabled for good, pass filter settings generated by the configurator
+ * with the component disabled: its memory is returned through free_memory. A component is allocated on first use by
+ * passing settings which enable it. The library state (AEC convergence, noise estimates) restarts. If the new settings
+ * can not be applied, the previous settings are restored and an error is returned.
+ *
+ * Can be called while frames are fed: the call waits for the frame being processed, if any, and frames still queued
+ * are processed with the new settings. Must not be called from afe_output_callback. Instances created with \ref cy_afe_create_static reuse the
+ * regions dedicated to library memory IDs and the library memory reserved in the arena at creation, both are emptied before
+ * the new settings are applied. Settings needing more library memory than the settings the instance was created with are
+ * rejected and the current settings stay in use; to switch between settings, create the instance with the settings needing
+ * the most memory, or size dedicated regions for the largest.
+ *
+ * @param[in]  handle             Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  filter_settings    Filter settings generated by the audio front end configurator, for the same number of microphones
+ * @param[in]  mw_settings        Middleware settings generated by the configurator, can be NULL
+ * @param[in]  mw_settings_length Length of mw_settings
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_update_filter_settings(cy_afe_t handle, uint32_t *filter_settings, uint8_t *mw_settings,
+        uint32_t mw_settings_length);
+
+/**
+ * Get the scratch memory of speech enhancement, which the application can borrow between frames when the
+ * instance is created with share_scratch_memory. The region is used by AFE only while a frame is processed and its
+ * content is not kept from one frame to the next. It moves when \ref cy_afe_update_filter_settings is called.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] region           Scratch memory region
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED if share_scratch_memory is not set;
+ *             an error code on failure.
+ */
+cy_rslt_t cy_afe_get_scratch_memory(cy_afe_t handle, cy_afe_memory_region_t *region);
+
+/**
+ * Borrow the scratch memory returned by \ref cy_afe_get_scratch_memory. Waits until the frame being processed, if any,
+ * is done with it. Processing of the next frame waits until \ref cy_afe_release_scratch_memory is called, so the
+ * region shall be released before feeding the next frame in CY_AFE_PROCESSING_MODE_SYNC mode. Can be called from
+ * afe_output_callback, the scratch memory is no longer used once the output is ready. Not to be called from an ISR.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  timeout_ms       Maximum time to wait in ms, CY_RTOS_NEVER_TIMEOUT to wait till the region is free
+ *
+ * @return     CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TIMEOUT if the region is still in use after timeout_ms;
+ *             CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED if share_scratch_memory is not set; an error code on failure.
+ */
+cy_rslt_t cy_afe_acquire_scratch_memory(cy_afe_t handle, uint32_t timeout_ms);
+
+/**
+ * Give back the scratch memory borrowed with \ref cy_afe_acquire_scratch_memory
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ *
+ * @return     CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_release_scratch_memory(cy_afe_t handle);
+
 /**
  * Destroy created AFE middleware instance
  *
@@ -621,6 +1304,29 @@ cy_rslt_t cy_afe_bd_calc_init(cy_afe_t handle, bdm_init_out_params_t *bdm_out);
  */
 cy_rslt_t cy_afe_bd_calc_deinit(cy_afe_t handle);
 
+/**
+ * Get the tuner parameter update counters of the AFE instance
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[out] stats            Tuner parameter update counters
+ *
+ * @return    CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t cy_afe_get_tuner_stats(cy_afe_t handle, cy_afe_tuner_stats_t *stats);
+
+/**
+ * Signal that data from the configurator tool is available, with CY_AFE_TUNER_TRANSPORT_NOTIFY. The tuner task
+ * wakes up and invokes read_request_callback till no data is returned. Signals received while the task is
+ * reading are not lost. Can be called from ISR.
+ *
+ * @param[in]  handle           Handle to audio front end instance created by the \ref cy_afe_create API
+ * @param[in]  in_isr           true if called from ISR
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED if tuner_transport is not
+ *            CY_AFE_TUNER_TRANSPORT_NOTIFY; an error code on failure.
+ */
+cy_rslt_t cy_afe_tuner_notify_rx(cy_afe_t handle, bool in_isr);
+
 #endif
 
 /** \} group_afe_functions */
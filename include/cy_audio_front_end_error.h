@@ -118,6 +118,16 @@ extern "C" {
 #define CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED      ( CY_RSLT_AFE_ERR_BASE + 16 )
 /** Audio front end hw input gain out of range */
 #define CY_RSLT_AFE_TUNER_HW_INPUT_GAIN_OUT_OF_RANGE    ( CY_RSLT_AFE_ERR_BASE + 17 )
+/** Audio front end input queue is full */
+#define CY_RSLT_AFE_QUEUE_FULL                   ( CY_RSLT_AFE_ERR_BASE + 18 )
+/** Audio front end operation not supported in the configured processing mode */
+#define CY_RSLT_AFE_INVALID_PROCESSING_MODE      ( CY_RSLT_AFE_ERR_BASE + 19 )
+/** Audio front end operation timed out */
+#define CY_RSLT_AFE_TIMEOUT                      ( CY_RSLT_AFE_ERR_BASE + 20 )
+/** Audio front end input is being fed by another caller */
+#define CY_RSLT_AFE_BUSY                         ( CY_RSLT_AFE_ERR_BASE + 21 )
+/** Audio front end tuner client disconnected, a partial command and an open transaction are dropped */
+#define CY_RSLT_AFE_TUNER_DISCONNECTED           ( CY_RSLT_AFE_ERR_BASE + 22 )
 
 /** \} group_afe_macros */
 #ifdef __cplusplus
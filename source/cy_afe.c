@@ -41,19 +41,23 @@
 #include "cy_afe_audio_internal.h"
 #include "cy_afe_audio_speech_enh.h"
 #include "cy_afe_audio_task.h"
+#include "cy_afe_audio_memory.h"
+#include "cy_afe_audio_dispatch.h"
+#include "cy_afe_audio_reframe.h"
+#include "cy_afe_audio_process.h"
+#include "cy_afe_audio_format.h"
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 #include "cy_afe_tuner_task.h"
+#include "cy_afe_tuner_process.h"
 #endif
 #include "cyabs_rtos_internal.h"
 #include "cy_audio_license.h"
+#include <string.h>
+#include <stdlib.h>
 
 /******************************************************
  *                     Macros
  ******************************************************/
-#if CY_AFE_FRAME_SIZE_MS != 10 || CY_AFE_SAMPLE_FREQ != 16000 || AFE_INPUT_NUMBER_CHANNELS > 2 || AFE_INPUT_NUMBER_CHANNELS == 0
-#error "Invalid configuration for AFE middleware. Supported values are:[frame_size:10ms,sample_freq:16K,number_channel:mono/stereo]"
-#endif
-
 #ifndef ENABLE_AFE_MW_SUPPORT
 #error "macro ENABLE_AFE_MW_SUPPORT to be defined"
 #endif
@@ -76,15 +80,6 @@
 /******************************************************
  *                 Global Variables
  ******************************************************/
-/* As AFE supports only single instance, global_handle is stored/initialized when
- * cy_afe_create API is called first time, later any call of cy_afe_create will
- * return error.
- */
-cy_afe_t global_handle = NULL;
-
-cy_afe_alloc_memory_callback_t afe_alloc_memory = NULL;
-
-cy_afe_free_memory_callback_t  afe_free_memory = NULL;
 
 /******************************************************
  *               Static Functions
@@ -110,59 +105,128 @@ cy_rslt_t cy_afe_default_internal_get_output_buf_callback(cy_afe_t afe_handle, u
         return result;
     }
 
-    /* Allocate AFE output buffer */
-    if (NULL == handle->internal_output_buffer)
+    /* Take a frame from the pre-allocated output buffer pool */
+    *output_buf = afe_dispatch_get_pool_buffer(handle);
+    if (NULL == *output_buf)
     {
-        if(afe_alloc_memory)
-        {
-            afe_alloc_memory(CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, CY_AFE_MONO_FRAME_SIZE_IN_BYTES,
-                    (void **)&handle->internal_output_buffer);
-        }
-        else
-        {
-            handle->internal_output_buffer = calloc(1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
-        }
-        if (NULL == handle->internal_output_buffer)
-        {
-            result = CY_RSLT_AFE_OUT_OF_MEMORY;
-            cy_afe_log_err(result,
-                    "failed to allocate memory for output buffer");
-            return result;
-        }
+        result = (NULL == handle->output_pool_buffer) ? CY_RSLT_AFE_OUT_OF_MEMORY : CY_RSLT_AFE_QUEUE_FULL;
+        cy_afe_log_err(result, "No output buffer available in the pool");
+        return result;
     }
 
-    *output_buf = handle->internal_output_buffer;
-
     return result;
 }
 
 /**
- * Creates AFE instance, AFE processing thread, AFE queue & AFE tuner thread
- * & AFE tuner queue if tuner functionality is enabled
+ * Check the configuration of an AFE instance, before any memory is allocated
  */
-cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
+static cy_rslt_t afe_validate_config(cy_afe_config_t *config_init)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t sample_rate = 0;
+    uint32_t frame_size_ms = 0;
+    uint32_t num_channels = 0;
+    uint32_t frame_samples = 0;
+    uint32_t core_sample_rate = 0;
+    uint32_t aec_ref_channels = 0;
+    uint32_t weight_sum = 0;
+    uint32_t channel = 0;
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    uint32_t tuner_request_size = 0;
+    uint32_t tuner_command_size = 0;
+#endif
 
-    if (NULL != global_handle)
+    /* Audio format not set in the configuration defaults to the configurator settings */
+    sample_rate = (0 != config_init->sample_rate) ? config_init->sample_rate : CY_AFE_SAMPLE_FREQ;
+    frame_size_ms = (0 != config_init->frame_size_ms) ? config_init->frame_size_ms : CY_AFE_FRAME_SIZE_MS;
+    num_channels = (0 != config_init->num_channels) ? config_init->num_channels : CY_AFE_INPUT_NUM_OF_CHANNELS;
+
+    /* Input at a higher rate is resampled to the rate of speech enhancement inside AFE */
+    core_sample_rate = afe_resample_get_core_rate(sample_rate);
+    result = afe_speech_enhancement_validate_format(core_sample_rate, frame_size_ms, num_channels);
+    if (CY_RSLT_SUCCESS != result)
     {
-        result = CY_RSLT_AFE_ALREADY_INITIALIZED;
-        cy_afe_log_err(result, "AFE context is already initialized");
         return result;
     }
+    frame_samples = (sample_rate * frame_size_ms) / 1000;
 
-    /* Check for null parameters */
-    if (NULL == config_init || NULL == handle)
+    if (config_init->processing_mode > CY_AFE_PROCESSING_MODE_ADAPTIVE)
     {
         result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err(result,
-                "Invalid argument passed. config_init:[%p], handle:[%p]",
-                config_init, handle);
+        cy_afe_log_err(result, "Invalid processing mode:[%d]", config_init->processing_mode);
+        return result;
+    }
+
+    if (config_init->overload_policy > CY_AFE_OVERLOAD_POLICY_DROP_OLDEST)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid overload policy:[%d]", config_init->overload_policy);
+        return result;
+    }
+
+    if (config_init->output_mode > CY_AFE_OUTPUT_MODE_PULL)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid output mode:[%d]", config_init->output_mode);
+        return result;
+    }
+
+    if (config_init->input_mode > CY_AFE_INPUT_MODE_COPY)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid input mode:[%d]", config_init->input_mode);
+        return result;
+    }
+
+    if (config_init->input_layout > CY_AFE_INPUT_LAYOUT_INTERLEAVED ||
+        (CY_AFE_INPUT_LAYOUT_INTERLEAVED == config_init->input_layout && NULL != config_init->input_ring.input_buffer))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid input layout:[%d]", config_init->input_layout);
+        return result;
+    }
+
+    /* Frames of the input ring are read in place and are not converted */
+    if (0 == afe_format_sample_size(config_init->input_format.sample_format) ||
+        0 == afe_format_sample_size(config_init->output_format.sample_format) ||
+        (CY_AFE_SAMPLE_FORMAT_S16 != config_init->input_format.sample_format && NULL != config_init->input_ring.input_buffer))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid sample format. input:[%d], output:[%d]",
+                config_init->input_format.sample_format, config_init->output_format.sample_format);
+        return result;
+    }
+
+    /* Weights are bounded so that the downmix accumulator can not overflow */
+    aec_ref_channels = (0 == config_init->aec_ref_num_channels) ? 1 : config_init->aec_ref_num_channels;
+    for (channel = 0; channel < aec_ref_channels && NULL != config_init->aec_ref_downmix_weights; channel++)
+    {
+        weight_sum += (uint32_t)abs(config_init->aec_ref_downmix_weights[channel]);
+    }
+    if (aec_ref_channels > CY_AFE_AEC_REF_MAX_CHANNELS || weight_sum > UINT16_MAX ||
+        (aec_ref_channels > 1 && NULL != config_init->input_ring.input_buffer))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid AEC reference. channels:[%"PRIu32"], weight sum:[%"PRIu32"]",
+                aec_ref_channels, weight_sum);
+        return result;
+    }
+
+    /* Input ring is read by the AFE processing task */
+    if (NULL != config_init->input_ring.input_buffer &&
+        (CY_AFE_PROCESSING_MODE_SYNC == config_init->processing_mode ||
+         config_init->input_ring.size_in_samples < (2 * frame_samples)))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid input ring. size_in_samples:[%"PRIu32"], processing mode:[%d]",
+                config_init->input_ring.size_in_samples, config_init->processing_mode);
         return result;
     }
 
-    /* Check for AFE output callback */
-    if (NULL == config_init->afe_output_callback)
+    /* Check for AFE output callback, output can be returned synchronously in sync mode or read in pull mode */
+    if (NULL == config_init->afe_output_callback &&
+        CY_AFE_PROCESSING_MODE_SYNC != config_init->processing_mode &&
+        CY_AFE_OUTPUT_MODE_PULL != config_init->output_mode)
     {
         result = CY_RSLT_AFE_BAD_ARG;
         cy_afe_log_err(result, "AFE output cb cannot be passed as NULL");
@@ -176,32 +240,124 @@ cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
         return result;
     }
 
-    afe_alloc_memory = config_init->alloc_memory;
-    afe_free_memory = config_init->free_memory;
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    /* Received data is copied to the command buffer, which also keeps one byte to terminate a text command */
+    tuner_request_size = (0 != config_init->tuner_request_buffer_size) ?
+            config_init->tuner_request_buffer_size : CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE;
+    tuner_command_size = (0 != config_init->tuner_command_buffer_size) ?
+            config_init->tuner_command_buffer_size : CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE;
+    if (config_init->tuner_transport > CY_AFE_TUNER_TRANSPORT_NOTIFY ||
+        tuner_command_size > UINT16_MAX || tuner_command_size <= tuner_request_size)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid tuner configuration. transport:[%d], request buffer:[%"PRIu32"], command buffer:[%"PRIu32"]",
+                config_init->tuner_transport, tuner_request_size, tuner_command_size);
+        return result;
+    }
+#endif
+
+    if( (NULL == config_init->alloc_memory && NULL != config_init->free_memory)  ||
+        (NULL != config_init->alloc_memory && NULL == config_init->free_memory))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "alloc_memory and free_memory both needs to be valid");
+        return result;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Derive the frame and sample sizes of all buffers of the instance from its configuration
+ */
+static void afe_init_audio_format(afe_internal_context_t *context, cy_afe_config_t *config_init)
+{
+    uint32_t sample_rate = (0 != config_init->sample_rate) ? config_init->sample_rate : CY_AFE_SAMPLE_FREQ;
+    uint32_t frame_size_ms = (0 != config_init->frame_size_ms) ? config_init->frame_size_ms : CY_AFE_FRAME_SIZE_MS;
+    uint32_t num_channels = (0 != config_init->num_channels) ? config_init->num_channels : CY_AFE_INPUT_NUM_OF_CHANNELS;
+    uint32_t frame_samples = (sample_rate * frame_size_ms) / 1000;
+    uint32_t core_sample_rate = afe_resample_get_core_rate(sample_rate);
+    uint32_t aec_ref_channels = (0 == config_init->aec_ref_num_channels) ? 1 : config_init->aec_ref_num_channels;
+    uint32_t channel = 0;
+
+    context->sample_rate = sample_rate;
+    context->frame_size_ms = frame_size_ms;
+    context->num_channels = num_channels;
+    context->frame_samples = frame_samples;
+    context->mono_frame_size = frame_samples * CY_AFE_SAMPLE_SIZE_IN_BYTES;
+    context->input_frame_size = num_channels * context->mono_frame_size;
+    context->input_interleaved = (CY_AFE_AUDIO_STEREO_CHANNEL == num_channels &&
+            CY_AFE_INPUT_LAYOUT_INTERLEAVED == config_init->input_layout);
+    context->input_convert = (true == context->input_interleaved ||
+            CY_AFE_SAMPLE_FORMAT_S16 != config_init->input_format.sample_format);
+    context->input_sample_size = afe_format_sample_size(config_init->input_format.sample_format);
+    context->aec_ref_channels = aec_ref_channels;
+    context->aec_ref_interleaved = (aec_ref_channels > 1 && CY_AFE_INPUT_LAYOUT_INTERLEAVED == config_init->input_layout);
+    context->aec_ref_convert = (aec_ref_channels > 1 ||
+            CY_AFE_SAMPLE_FORMAT_S16 != config_init->input_format.sample_format);
+    for (channel = 0; channel < aec_ref_channels && aec_ref_channels > 1; channel++)
+    {
+        /* Channels are averaged unless application provides the weights */
+        context->aec_ref_weights[channel] = (NULL != config_init->aec_ref_downmix_weights) ?
+                config_init->aec_ref_downmix_weights[channel] : (int16_t)((32768u + (aec_ref_channels / 2)) / aec_ref_channels);
+    }
+    context->app_aec_ref_frame_size = aec_ref_channels * frame_samples * context->input_sample_size;
+    context->app_input_frame_size = num_channels * frame_samples * context->input_sample_size;
+    context->output_sample_size = afe_format_sample_size(config_init->output_format.sample_format);
+    context->app_output_frame_size = frame_samples * context->output_sample_size;
+    context->core_sample_rate = core_sample_rate;
+    context->core_frame_samples = (core_sample_rate * frame_size_ms) / 1000;
+    context->core_frame_size = context->core_frame_samples * CY_AFE_SAMPLE_SIZE_IN_BYTES;
+}
+
+/**
+ * Creates AFE instance, AFE processing thread, AFE queue & AFE tuner thread
+ * & AFE tuner queue if tuner functionality is enabled. Memory of the instance is
+ * carved from memory if it is not NULL.
+ */
+static cy_rslt_t afe_create(cy_afe_config_t *config_init, const cy_afe_static_memory_t *memory, cy_afe_t *handle)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    afe_memory_static_t static_memory;
 
-    if( (NULL == afe_alloc_memory && NULL != afe_free_memory)  ||
-        (NULL != afe_alloc_memory && NULL == afe_free_memory))
+    /* Check for null parameters */
+    if (NULL == config_init || NULL == handle)
     {
         result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err(result, "afe_alloc_memory and afe_free_memory both needs to be valid");
+        cy_afe_log_err(result,
+                "Invalid argument passed. config_init:[%p], handle:[%p]",
+                config_init, handle);
         return result;
     }
 
-    cy_afe_log_dbg(
-            "config params:[no_of_channels:%d, frame_size:%d, sample_freq:%d,afe_output_cb:%p,get_buffer_cb:%p]",
-            CY_AFE_INPUT_NUM_OF_CHANNELS, CY_AFE_FRAME_SIZE_MS,
-            CY_AFE_SAMPLE_FREQ, config_init->afe_output_callback,
-            config_init->afe_get_buffer_callback);
+    result = afe_validate_config(config_init);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
 
     /* Set the AFE context to NULL */
     *handle = NULL;
 
     /* Allocate memory for the internal AFE context */
     afe_internal_context_t *context = NULL;
-    if(afe_alloc_memory)
+    if(NULL != memory)
+    {
+        result = afe_memory_static_init(&static_memory, memory);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+        context = afe_memory_static_alloc(&static_memory, CY_AFE_MEM_ID_AFE_CONTEXT, sizeof(afe_internal_context_t));
+    }
+    else if(config_init->alloc_memory)
     {
-        afe_alloc_memory(CY_AFE_MEM_ID_AFE_CONTEXT, sizeof(afe_internal_context_t),
+        config_init->alloc_memory(CY_AFE_MEM_ID_AFE_CONTEXT, sizeof(afe_internal_context_t),
                 (void **)&context);
+        if (NULL != context)
+        {
+            memset(context, 0, sizeof(afe_internal_context_t));
+        }
     }
     else
     {
@@ -214,19 +370,69 @@ cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
         return result;
     }
 
+    /* All further allocations of this instance are done through its own allocator callbacks */
+    context->config_init = *config_init;
+    if(NULL != memory)
+    {
+        context->static_memory = static_memory;
+    }
+    context->memory_usage[CY_AFE_MEM_ID_AFE_CONTEXT] = sizeof(afe_internal_context_t);
+    context->memory_required[CY_AFE_MEM_ID_AFE_CONTEXT] = AFE_MEMORY_ALIGN(sizeof(afe_internal_context_t));
+
+    /* All buffers of this instance are sized from its audio format */
+    afe_init_audio_format(context, config_init);
 
+    cy_afe_log_dbg(
+            "config params:[no_of_channels:%"PRIu32", frame_size:%"PRIu32", sample_freq:%"PRIu32",afe_output_cb:%p,get_buffer_cb:%p]",
+            context->num_channels, context->frame_size_ms,
+            context->sample_rate, config_init->afe_output_callback,
+            config_init->afe_get_buffer_callback);
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    /* Start with the configurator provided debug output channel selection */
+    context->usb_settings = MY_AFE_USB_SETTINGS;
+#endif
+
+    /* Frames are processed one at a time, whether in AFE processing task or in the caller */
+    result = cy_rtos_mutex_init(&context->process_mutex, false);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to create the processing mutex");
+        result = CY_RSLT_AFE_GENERIC_ERROR;
+        goto CLEAN_RETURN;
+    }
+    context->process_mutex_initialized = true;
+
+    /* Feeds of the instance queue frames one at a time, concurrent feeds are rejected */
+    atomic_flag_clear(&context->producer_busy);
+    atomic_flag_clear(&context->reframe_busy);
 
     /*
-     * Setup the audio processing task and queue
+     * Setup the output buffer pool and the output dispatch task and queue, if configured
      */
-    result = afe_setup_audio_processing_task(context);
+    result = afe_setup_output_dispatch(context);
     if (CY_RSLT_SUCCESS != result)
     {
-        cy_afe_log_err(result, "Failed to setup the audio processing task");
+        cy_afe_log_err(result, "Failed to setup the output dispatch task");
         result = CY_RSLT_AFE_GENERIC_ERROR;
         goto CLEAN_RETURN;
     }
 
+    /*
+     * Setup the audio processing task and queue. Not required when frames
+     * are always processed in the caller context.
+     */
+    if (CY_AFE_PROCESSING_MODE_SYNC != config_init->processing_mode)
+    {
+        result = afe_setup_audio_processing_task(context);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to setup the audio processing task");
+            result = CY_RSLT_AFE_GENERIC_ERROR;
+            goto CLEAN_RETURN;
+        }
+    }
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 
 
@@ -254,14 +460,32 @@ cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
 
 #endif
 
-    /* Initialize AFE system components for speech enhancement */
-    result = afe_speech_enhancement_init((int32_t *)config_init->filter_settings, config_init->mw_settings,
-                                        config_init->mw_settings_length, &context->sp_enh_context);
+    /* Scratch memory of AFE and of the speech enhancement library is one arena */
+    context->scratch_arena_min_size = afe_format_get_scratch_size(context);
+    if (true == config_init->share_scratch_memory)
+    {
+        result = cy_rtos_mutex_init(&context->scratch_mutex, false);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to create the scratch memory mutex");
+            result = CY_RSLT_AFE_GENERIC_ERROR;
+            goto CLEAN_RETURN;
+        }
+        context->scratch_mutex_initialized = true;
+    }
+
+    /* Initialize AFE system components for speech enhancement. Library memory of a static instance
+     * is reserved apart from AFE memory, so that filter setting updates reuse it.
+     */
+    afe_memory_library_begin(context);
+    result = afe_speech_enhancement_init(context, (int32_t *)config_init->filter_settings, config_init->mw_settings,
+                                        config_init->mw_settings_length);
     if (CY_RSLT_SUCCESS != result)
     {
         cy_afe_log_err(result, "Failed to initialize speech enhancement");
         goto CLEAN_RETURN;
     }
+    afe_memory_library_end(context);
 
     /* Use application provided function for getting AFE output buffer
      * else use the internal function to allocate static memory */
@@ -274,26 +498,37 @@ cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
         context->get_output_buffer_cb = config_init->afe_get_buffer_callback;
     }
 
-    context->config_init = *config_init;
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,
+            CY_AFE_MONITOR_OUT_MAX_FRAMES * context->core_frame_size,
+            (void **)&context->ifx_internal_output);
+    if(CY_RSLT_SUCCESS != result)
+    {
+         cy_afe_log_err(result, "Out of mem sz: %"PRIu32, CY_AFE_MONITOR_OUT_MAX_FRAMES * context->core_frame_size);
+         goto CLEAN_RETURN;
+    }
 
-    if(afe_alloc_memory)
+    result = afe_setup_format_conversion(context);
+    if(CY_RSLT_SUCCESS != result)
     {
-        afe_alloc_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, CY_AFE_MONITOR_OUT_MAX_SIZE,
-                (void *)&context->ifx_internal_output);
+         cy_afe_log_err(result, "Failed to setup the sample format conversion");
+         goto CLEAN_RETURN;
     }
-    else
+
+    result = afe_setup_resampler(context);
+    if(CY_RSLT_SUCCESS != result)
     {
-        context->ifx_internal_output = (uint16_t *) malloc(CY_AFE_MONITOR_OUT_MAX_SIZE);
+         cy_afe_log_err(result, "Failed to setup the resampler");
+         goto CLEAN_RETURN;
     }
 
-    if(NULL == context->ifx_internal_output)
+    result = afe_setup_reframe(context);
+    if(CY_RSLT_SUCCESS != result)
     {
-         cy_afe_log_err(result, "Out of mem sz: %d",CY_AFE_MONITOR_OUT_MAX_SIZE);
+         cy_afe_log_err(result, "Failed to setup the reframing buffer");
          goto CLEAN_RETURN;
     }
 
     *handle = context;
-    global_handle = (void*) context;
 
     cy_afe_log_info("cy_afe_create success");
 
@@ -304,6 +539,120 @@ CLEAN_RETURN:
     return result;
 }
 
+cy_rslt_t cy_afe_create(cy_afe_config_t *config_init, cy_afe_t *handle)
+{
+    return afe_create(config_init, NULL, handle);
+}
+
+cy_rslt_t cy_afe_create_static(cy_afe_config_t *config_init, const cy_afe_static_memory_t *memory, cy_afe_t *handle)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == memory)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. memory:[%p]", memory);
+        return result;
+    }
+
+    return afe_create(config_init, memory, handle);
+}
+
+cy_rslt_t cy_afe_get_memory_requirements(cy_afe_config_t *config_init, cy_afe_memory_requirements_t *requirements)
+{
+    afe_internal_context_t *context = NULL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t mem_id = 0;
+
+    if (NULL == config_init || NULL == requirements)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. config_init:[%p], requirements:[%p]", config_init, requirements);
+        return result;
+    }
+
+    result = afe_validate_config(config_init);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    /* Temporary context, only used to size the instance and to initialize the speech enhancement library */
+    if (NULL != config_init->alloc_memory)
+    {
+        config_init->alloc_memory(CY_AFE_MEM_ID_AFE_CONTEXT, sizeof(afe_internal_context_t), (void **)&context);
+        if (NULL != context)
+        {
+            memset(context, 0, sizeof(afe_internal_context_t));
+        }
+    }
+    else
+    {
+        context = calloc(1, sizeof(afe_internal_context_t));
+    }
+    if (NULL == context)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        cy_afe_log_err(result, "Unable to allocate memory for AFE context");
+        return result;
+    }
+
+    context->config_init = *config_init;
+    afe_init_audio_format(context, config_init);
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    context->usb_settings = MY_AFE_USB_SETTINGS;
+#endif
+
+    /* Memory owned by AFE follows from the configuration, no task or queue is created */
+    context->memory_required[CY_AFE_MEM_ID_AFE_CONTEXT] = AFE_MEMORY_ALIGN(sizeof(afe_internal_context_t));
+    afe_require_output_dispatch_memory(context);
+    afe_require_audio_processing_memory(context);
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    afe_require_audio_tuner_memory(context, config_init);
+#endif
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, CY_AFE_MONITOR_OUT_MAX_FRAMES * context->core_frame_size);
+    afe_require_format_conversion_memory(context);
+    result = afe_require_resampler_memory(context);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+
+    afe_require_reframe_memory(context);
+
+    /* Memory of the speech enhancement library is known only once it is initialized. It is also the
+     * reservation a static instance keeps for filter updates, so no headroom is added for them.
+     */
+    context->scratch_arena_min_size = afe_format_get_scratch_size(context);
+    result = afe_speech_enhancement_init(context, (int32_t *)config_init->filter_settings, config_init->mw_settings,
+                                        config_init->mw_settings_length);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to initialize speech enhancement");
+        goto CLEAN_RETURN;
+    }
+    afe_speech_enhancement_deinit(context);
+
+    requirements->total_size = 0;
+    for (mem_id = 0; mem_id < CY_AFE_MEM_ID_MAX; mem_id++)
+    {
+        requirements->mem[mem_id].size = context->memory_required[mem_id];
+        requirements->mem[mem_id].alignment = CY_AFE_MEMORY_ALIGNMENT;
+        requirements->total_size += context->memory_required[mem_id];
+    }
+
+CLEAN_RETURN:
+    if (NULL != config_init->free_memory)
+    {
+        config_init->free_memory(CY_AFE_MEM_ID_AFE_CONTEXT, context);
+    }
+    else
+    {
+        free(context);
+    }
+    return result;
+}
+
 /**
  * Feed audio input data
  */
@@ -328,14 +677,6 @@ cy_rslt_t cy_afe_feed(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_
         return result;
     }
 
-    if (global_handle != context)
-    {
-        result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err_on_no_isr(result, "Invalid handle passed. handle:[%p]",
-                handle);
-        return result;
-    }
-
     /* Check for the license expiry of AFE audio library */
     if(cy_afe_lib_is_license_expired())
     {
@@ -344,7 +685,7 @@ cy_rslt_t cy_afe_feed(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_
         return result;
     }
 
-    result = afe_push_audio_data_to_queue(context, input_buffer, aec_ref_buf);
+    result = afe_feed_audio_data(context, input_buffer, aec_ref_buf);
     if (CY_RSLT_SUCCESS != result)
     {
         cy_afe_log_err_on_no_isr(result,
@@ -360,41 +701,501 @@ cy_rslt_t cy_afe_feed(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_
 }
 
 /**
- * Cleanup the AFE thread, queue and deletes instance
+ * Feed a block of audio input frames
  */
-cy_rslt_t cy_afe_delete(cy_afe_t *handle)
+cy_rslt_t cy_afe_feed_batch(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref_buf, uint32_t num_frames)
 {
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
     cy_rslt_t result = CY_RSLT_SUCCESS;
-    afe_internal_context_t *context = (afe_internal_context_t*) *handle;
 
-    if (NULL == context)
+    if (NULL == context || NULL == input_buffer || 0 == num_frames)
     {
         result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err(result, "Invalid argument passed. handle : [%p]",
-                context);
+        cy_afe_log_err_on_no_isr(result,
+                "Invalid argument passed. context:[%p], input_buffer:[%p], num_frames:[%"PRIu32"]",
+                context, input_buffer, num_frames);
         return result;
     }
 
-    if (context != global_handle)
+    /* Check for the license expiry of AFE audio library */
+    if(cy_afe_lib_is_license_expired())
     {
-        result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err(result, "Invalid handle passed. handle : [%p]", handle);
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err_on_no_isr(result, "AFE library license is expired.");
         return result;
     }
 
-    /*
-     * Cleanup the audio processing task and resources
-     */
-    if (true == context->audio_processing_thread_running)
+    result = afe_feed_audio_data_batch(context, input_buffer, aec_ref_buf, num_frames);
+    if (CY_RSLT_SUCCESS != result)
     {
-        result = afe_cleanup_audio_processing_task(context);
-        if (CY_RSLT_SUCCESS != result)
-        {
-            cy_afe_log_err(result, "Failed to cleanup the audio processing task resources");
-            return result;
-        }
-    }
-
+        cy_afe_log_err_on_no_isr(result,
+                "Push to audio processing queue failed");
+        return result;
+    }
+
+    return result;
+}
+
+/**
+ * Feed any number of audio input samples
+ */
+cy_rslt_t cy_afe_feed_samples(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref_buf, uint32_t num_samples)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == input_buffer)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result,
+                "Invalid argument passed. context:[%p], input_buffer:[%p]",
+                context, input_buffer);
+        return result;
+    }
+
+    /* Check for the license expiry of AFE audio library */
+    if(cy_afe_lib_is_license_expired())
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err_on_no_isr(result, "AFE library license is expired.");
+        return result;
+    }
+
+    result = afe_reframe_feed(context, input_buffer, aec_ref_buf, num_samples);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err_on_no_isr(result, "Failed to feed %"PRIu32" samples", num_samples);
+        return result;
+    }
+
+    return result;
+}
+
+/**
+ * Notify new samples in the input ring
+ */
+cy_rslt_t cy_afe_notify_input_samples(cy_afe_t handle, uint32_t num_samples)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p]", context);
+        return result;
+    }
+
+    result = afe_notify_input_ring_samples(context, num_samples);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err_on_no_isr(result, "No input ring registered");
+        return result;
+    }
+
+    return result;
+}
+
+/**
+ * Process audio input data in the caller context
+ */
+cy_rslt_t cy_afe_process(cy_afe_t handle, CY_AFE_DATA_T *input_buffer, CY_AFE_DATA_T *aec_ref_buf, cy_afe_buffer_info_t *output)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == input_buffer)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result,
+                "Invalid argument passed. context:[%p], input_buffer:[%p]",
+                context, input_buffer);
+        return result;
+    }
+
+    if (CY_AFE_PROCESSING_MODE_SYNC != context->config_init.processing_mode || is_in_isr())
+    {
+        result = CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+        cy_afe_log_err_on_no_isr(result, "cy_afe_process is allowed only in sync mode from task context");
+        return result;
+    }
+
+    /* Pulled outputs are owned by the reader, output is not returned here */
+    if (CY_AFE_OUTPUT_MODE_PULL == context->config_init.output_mode && NULL != output)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Output is read with cy_afe_read_output in pull mode");
+        return result;
+    }
+
+    /* Check for the license expiry of AFE audio library */
+    if(cy_afe_lib_is_license_expired())
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err(result, "AFE library license is expired.");
+        return result;
+    }
+
+    if (NULL != output)
+    {
+        memset(output, 0, sizeof(cy_afe_buffer_info_t));
+    }
+
+    result = afe_process_audio_data_in_caller(context, input_buffer, aec_ref_buf, output);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to process audio data");
+        return result;
+    }
+
+    return result;
+}
+
+/**
+ * Read the next processed frame in pull mode
+ */
+cy_rslt_t cy_afe_read_output(cy_afe_t handle, cy_afe_buffer_info_t *output, uint32_t timeout_ms)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == output || (0 != timeout_ms && is_in_isr()))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], output:[%p]", context, output);
+        return result;
+    }
+
+    if (CY_AFE_OUTPUT_MODE_PULL != context->config_init.output_mode)
+    {
+        result = CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+        cy_afe_log_err_on_no_isr(result, "cy_afe_read_output is allowed only in pull mode");
+        return result;
+    }
+
+    return afe_dispatch_read_output(context, output, timeout_ms);
+}
+
+/**
+ * Read any number of processed samples in pull mode
+ */
+cy_rslt_t cy_afe_read_output_samples(cy_afe_t handle, CY_AFE_DATA_T *output, uint32_t num_samples,
+        uint32_t *samples_read, uint32_t timeout_ms)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == output || (0 != timeout_ms && is_in_isr()))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], output:[%p]", context, output);
+        return result;
+    }
+
+    if (CY_AFE_OUTPUT_MODE_PULL != context->config_init.output_mode)
+    {
+        result = CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+        cy_afe_log_err_on_no_isr(result, "cy_afe_read_output_samples is allowed only in pull mode");
+        return result;
+    }
+
+    return afe_reframe_read_output(context, output, num_samples, samples_read, timeout_ms);
+}
+
+cy_rslt_t cy_afe_hold_output(cy_afe_t handle, cy_afe_buffer_info_t *output)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == output)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], output:[%p]", context, output);
+        return result;
+    }
+
+    result = afe_dispatch_hold_output(context, output);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err_on_no_isr(result, "Output buffer [%p] is not an internal buffer in use", output->output_buf);
+        return result;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_release_output(cy_afe_t handle, cy_afe_buffer_info_t *output)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == output)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], output:[%p]", context, output);
+        return result;
+    }
+
+    result = afe_dispatch_release_output(context, output);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err_on_no_isr(result, "Output buffer [%p] is not in use", output->output_buf);
+        return result;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_get_overload_stats(cy_afe_t handle, cy_afe_overload_stats_t *stats)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == stats)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], stats:[%p]", context, stats);
+        return result;
+    }
+
+    *stats = context->overload_stats;
+    stats->queue_depth = afe_get_pending_input_frames(context);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_get_memory_usage(cy_afe_t handle, cy_afe_memory_usage_t *usage)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t mem_id = 0;
+
+    if (NULL == context || NULL == usage)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], usage:[%p]", context, usage);
+        return result;
+    }
+
+    usage->total_bytes = 0;
+    for (mem_id = 0; mem_id < CY_AFE_MEM_ID_MAX; mem_id++)
+    {
+        usage->bytes[mem_id] = context->memory_usage[mem_id];
+        usage->total_bytes += context->memory_usage[mem_id];
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_get_component_memory(cy_afe_t handle, cy_afe_component_memory_t *report)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == report)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], report:[%p]", context, report);
+        return result;
+    }
+
+    afe_speech_enhancement_get_memory(context, report);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_update_filter_settings(cy_afe_t handle, uint32_t *filter_settings, uint8_t *mw_settings,
+        uint32_t mw_settings_length)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == filter_settings || is_in_isr())
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], filter_settings:[%p]",
+                context, filter_settings);
+        return result;
+    }
+
+    /* Waits for the frame being processed, next frames are processed with the new settings */
+    cy_rtos_mutex_get(&context->process_mutex, CY_RTOS_NEVER_TIMEOUT);
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    cy_rtos_mutex_get(&context->audio_tuner_mutex, CY_RTOS_NEVER_TIMEOUT);
+#endif
+    /* Scratch memory is freed and allocated again, it must not be borrowed by the application meanwhile */
+    if (true == context->scratch_mutex_initialized)
+    {
+        cy_rtos_mutex_get(&context->scratch_mutex, CY_RTOS_NEVER_TIMEOUT);
+    }
+
+    result = afe_speech_enhancement_reinit(context, (int32_t *)filter_settings, mw_settings, mw_settings_length);
+
+    if (true == context->scratch_mutex_initialized)
+    {
+        cy_rtos_mutex_set(&context->scratch_mutex);
+    }
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    cy_rtos_mutex_set(&context->audio_tuner_mutex);
+#endif
+    cy_rtos_mutex_set(&context->process_mutex);
+
+    return result;
+}
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+cy_rslt_t cy_afe_get_tuner_stats(cy_afe_t handle, cy_afe_tuner_stats_t *stats)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == stats)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. context:[%p], stats:[%p]", context, stats);
+        return result;
+    }
+
+    afe_speech_enhancement_get_tuner_stats(context, stats);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_tuner_notify_rx(cy_afe_t handle, bool in_isr)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p]", context);
+        return result;
+    }
+
+    if (false == context->tuner_rx_semaphore_initialized)
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err_on_no_isr(result, "Tuner transport is not CY_AFE_TUNER_TRANSPORT_NOTIFY");
+        return result;
+    }
+
+    return cy_rtos_set_semaphore(&context->tuner_rx_semaphore, in_isr);
+}
+#endif
+
+cy_rslt_t cy_afe_get_scratch_memory(cy_afe_t handle, cy_afe_memory_region_t *region)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || NULL == region)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p], region:[%p]", context, region);
+        return result;
+    }
+
+    if (false == context->scratch_mutex_initialized)
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err_on_no_isr(result, "Scratch memory is not shared, set share_scratch_memory");
+        return result;
+    }
+
+    *region = context->scratch_arena;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_acquire_scratch_memory(cy_afe_t handle, uint32_t timeout_ms)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || is_in_isr())
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p]", context);
+        return result;
+    }
+
+    if (false == context->scratch_mutex_initialized)
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err(result, "Scratch memory is not shared, set share_scratch_memory");
+        return result;
+    }
+
+    if (CY_RSLT_SUCCESS != cy_rtos_mutex_get(&context->scratch_mutex, timeout_ms))
+    {
+        return CY_RSLT_AFE_TIMEOUT;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_release_scratch_memory(cy_afe_t handle)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) handle;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == context || is_in_isr())
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result, "Invalid argument passed. context:[%p]", context);
+        return result;
+    }
+
+    if (false == context->scratch_mutex_initialized)
+    {
+        result = CY_RSLT_AFE_FUNCTIONALITY_RESTRICTED;
+        cy_afe_log_err(result, "Scratch memory is not shared, set share_scratch_memory");
+        return result;
+    }
+
+    return cy_rtos_mutex_set(&context->scratch_mutex);
+}
+
+cy_rslt_t cy_afe_delete(cy_afe_t *handle)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    afe_internal_context_t *context = (afe_internal_context_t*) *handle;
+
+    if (NULL == context)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. handle : [%p]",
+                context);
+        return result;
+    }
+
+    /* Partial frames of cy_afe_feed_samples and cy_afe_read_output_samples are dropped */
+    afe_reframe_cleanup(context);
+
+    /*
+     * Cleanup the audio processing task and resources
+     */
+    if (true == context->audio_processing_thread_running)
+    {
+        result = afe_cleanup_audio_processing_task(context);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to cleanup the audio processing task resources");
+            return result;
+        }
+    }
+
+    /*
+     * Cleanup the output dispatch task and resources
+     */
+    result = afe_cleanup_output_dispatch(context);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to cleanup the output dispatch task resources");
+        return result;
+    }
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
     /*
      * Cleanup the audio tuner task and resources
@@ -409,50 +1210,36 @@ cy_rslt_t cy_afe_delete(cy_afe_t *handle)
         }
     }
 
+    /* Release the bulk delay measurement state if application has not done it */
+    if (NULL != context->bdm_context)
+    {
+        cy_afe_bd_calc_deinit(context);
+    }
+
     afe_cleanup_memory_for_dbg_output(context);
 
 #endif
 
-    /* Free if memory allocated internally by AFE output callback */
-    if (NULL != context->internal_output_buffer)
-    {
-        if(afe_free_memory && (context->config_init.afe_get_buffer_callback == NULL))
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER,context->internal_output_buffer);
-        }
-        else if (context->config_init.afe_get_buffer_callback == NULL)
-        {
-            free(context->internal_output_buffer );
-        }
-    }
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->ifx_internal_output);
 
-    if(NULL != context->ifx_internal_output)
-    {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,context->ifx_internal_output);
-        }
-        else
-        {
-            free(context->ifx_internal_output);
-        }
-    }
+    afe_cleanup_resampler(context);
+    afe_cleanup_format_conversion(context);
 
-    afe_speech_enhancement_deinit(context->sp_enh_context);
+    afe_speech_enhancement_deinit(context);
 
-    if(afe_free_memory)
+    if (true == context->scratch_mutex_initialized)
     {
-        afe_free_memory(CY_AFE_MEM_ID_AFE_CONTEXT,context);
+        cy_rtos_mutex_deinit(&context->scratch_mutex);
     }
-    else
+
+    if (true == context->process_mutex_initialized)
     {
-        free(context);
+        cy_rtos_mutex_deinit(&context->process_mutex);
     }
 
-    afe_alloc_memory = NULL;
-    afe_free_memory = NULL;
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_CONTEXT, context);
+
     *handle = NULL;
-    global_handle = NULL;
 
     cy_afe_log_info("afe_delete success");
 
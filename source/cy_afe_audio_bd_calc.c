@@ -46,15 +46,9 @@
 #include "cy_sp_enh.h"
 #include "bulk_delay_measurement.h"
 #include "cy_afe_audio_bd_calc.h"
+#include "cy_afe_audio_memory.h"
 #include <inttypes.h>
 
-bdm_struct_t bdm_struct = {0};
-unsigned int ref_frame_count = 0;
-unsigned int repeat_count = 0;
-unsigned int num_ref_frames = 0;
-cy_semaphore_t bdCalcSyncSemaphore = NULL;
-int bulk_delay_output = BULK_DELAY_ERROR;
-
 #if ENABLE_BDM_PRINT_LOGS
 #define BDM_PRINT_LOGS(format,...)  printf ("[BDM] "format" \r\n", ##__VA_ARGS__);
 #else
@@ -72,6 +66,7 @@ cy_rslt_t cy_afe_bd_calc_init(cy_afe_t afe_handle, bdm_init_out_params_t *bdm_ou
     int32_t bdm_state = 0;
     int16_t* ref_buffer = NULL;
     int32_t ref_length = 0;
+    afe_bdm_context_t *bdm = NULL;
 
     if((NULL == afe_handle) || (NULL == bdm_out))
     {
@@ -82,55 +77,56 @@ cy_rslt_t cy_afe_bd_calc_init(cy_afe_t afe_handle, bdm_init_out_params_t *bdm_ou
     frame_size = frame_size_msec * sampling_rate / 1000;
     handle = (afe_internal_context_t*) afe_handle;
 
-    /* Reset any global context */
-    memset(&bdm_struct, 0, sizeof(bdm_struct_t));
+    if(NULL != handle->bdm_context)
+    {
+        ret_val = CY_RSLT_AFE_ALREADY_INITIALIZED;
+        cy_afe_log_err(ret_val, "BDM calc is already initialized");
+        handle = NULL;
+        goto CLEAN_RETURN;
+    }
+
+    /* BDM state is kept per AFE instance */
+    ret_val = afe_memory_alloc(handle, CY_AFE_MEM_ID_GENERIC_MEMORY, sizeof(afe_bdm_context_t), (void **)&bdm);
+    if (CY_RSLT_SUCCESS != ret_val)
+    {
+        goto CLEAN_RETURN;
+    }
+    bdm->bulk_delay_output = BULK_DELAY_ERROR;
 
     param_struct.frame_size = frame_size;
     param_struct.sampling_rate = sampling_rate;
-    (void) afe_bdm_init(&param_struct, &bdm_struct);
+    (void) afe_bdm_init(&param_struct, &bdm->bdm_struct);
 
     // get generated ref signal and its length, number of ref frames, and max number of bdm repeat
-    ref_buffer = afe_bdm_get_ref_signal(&bdm_struct);
-    ref_length = afe_bdm_get_ref_length(&bdm_struct);
-    num_ref_frames = ref_length / frame_size;
-
-    handle->is_bdm_enabled = true;
+    ref_buffer = afe_bdm_get_ref_signal(&bdm->bdm_struct);
+    ref_length = afe_bdm_get_ref_length(&bdm->bdm_struct);
+    bdm->num_ref_frames = ref_length / frame_size;
 
-    ret_val = cy_rtos_init_semaphore( &bdCalcSyncSemaphore, 1, 0 );
+    ret_val = cy_rtos_init_semaphore( &bdm->sync_semaphore, 1, 0 );
     if (CY_RSLT_SUCCESS != ret_val)
     {
         cy_afe_log_err(ret_val, "Failed to initialize bd calc sync semaphore ");
+        afe_bdm_free(&bdm->bdm_struct);
+        afe_memory_free(handle, CY_AFE_MEM_ID_GENERIC_MEMORY, bdm);
         goto CLEAN_RETURN;
     }
 
-    bdm_state = afe_bdm_get_state(&bdm_struct);
+    handle->bdm_context = bdm;
+    handle->is_bdm_enabled = true;
+
+    bdm_state = afe_bdm_get_state(&bdm->bdm_struct);
     BDM_PRINT_LOGS("BDM initial state:%"PRIi32, bdm_state);
     (void)bdm_state;
 
+    /* Reference signal generated by BDM is played as is, it stays valid till cy_afe_bd_calc_deinit */
     bdm_out->aec_ref_buffer = ref_buffer;
     bdm_out->aec_ref_buffer_len = ref_length*2;
-
-    bdm_out->aec_ref_buffer = malloc(ref_length*2);
-    if(NULL == bdm_out->aec_ref_buffer)
-    {
-        ret_val = CY_RSLT_AFE_OUT_OF_MEMORY;
-        cy_afe_log_err(ret_val, "out of memory sz:%"PRIi32,ref_length*2);
-        goto CLEAN_RETURN;
-    }
-
-    memcpy((void*)bdm_out->aec_ref_buffer, (void*)ref_buffer, ref_length*2);
     handle->bdm_out = *bdm_out;
 
     BDM_PRINT_LOGS("ref_buffer:%p, ref_length = %"PRIi32,ref_buffer, ref_length);
     cy_afe_log_info("BDM calc init success");
 
 CLEAN_RETURN:
-    if((NULL != handle) && (NULL != handle->bdm_out.aec_ref_buffer))
-    {
-        free(handle->bdm_out.aec_ref_buffer);
-        handle->bdm_out.aec_ref_buffer = NULL;
-        handle->bdm_out.aec_ref_buffer_len = 0;
-    }
     return ret_val;
 }
 
@@ -139,6 +135,7 @@ cy_rslt_t cy_afe_bd_calc_deinit(cy_afe_t afe_handle)
 {
     cy_rslt_t ret_val = CY_RSLT_SUCCESS;
     afe_internal_context_t* handle = (afe_internal_context_t*) afe_handle;
+    afe_bdm_context_t *bdm = NULL;
 
     if(NULL == handle)
     {
@@ -146,57 +143,51 @@ cy_rslt_t cy_afe_bd_calc_deinit(cy_afe_t afe_handle)
         goto CLEAN_RETURN;
     }
 
-    // free bdm
-    afe_bdm_free(&bdm_struct);
+    handle->is_bdm_enabled = false;
+    bdm = handle->bdm_context;
+    handle->bdm_context = NULL;
 
-    if(NULL != bdCalcSyncSemaphore)
+    if(NULL != bdm)
     {
-        cy_rtos_deinit_semaphore(&bdCalcSyncSemaphore);
-        bdCalcSyncSemaphore = NULL;
+        // free bdm
+        afe_bdm_free(&bdm->bdm_struct);
+
+        cy_rtos_deinit_semaphore(&bdm->sync_semaphore);
         cy_afe_log_info("Deinit Sem success");
+
+        afe_memory_free(handle, CY_AFE_MEM_ID_GENERIC_MEMORY, bdm);
     }
     else
     {
         cy_afe_log_info("Sem not yet created");
     }
 
-    if(NULL != handle->bdm_out.aec_ref_buffer)
-    {
-        free(handle->bdm_out.aec_ref_buffer);
-        handle->bdm_out.aec_ref_buffer = NULL;
-        handle->bdm_out.aec_ref_buffer_len = 0;
-    }
-
-    memset(&bdm_struct,0,sizeof(bdm_struct));
-
-    handle->is_bdm_enabled = false;
-    bulk_delay_output = 0;
-    repeat_count = 0;
-    ref_frame_count = 0;
-    num_ref_frames = 0;
+    /* Reference signal was released along with the BDM state */
+    handle->bdm_out.aec_ref_buffer = NULL;
+    handle->bdm_out.aec_ref_buffer_len = 0;
 
 CLEAN_RETURN:
     return ret_val;
 }
 
-cy_rslt_t cy_afe_bd_calc_wait_for_complete(unsigned int ui_timout_ms,
-        int *bulk_delay)
+cy_rslt_t cy_afe_bd_calc_wait_for_complete(afe_internal_context_t *context,
+        unsigned int ui_timout_ms, int *bulk_delay)
 {
     cy_rslt_t ret_val = CY_RSLT_SUCCESS;
 
-    if(NULL == bulk_delay)
+    if(NULL == context || NULL == bulk_delay)
     {
         ret_val = CY_RSLT_AFE_BAD_ARG;
         goto CLEAN_RETURN;
     }
     *bulk_delay = BULK_DELAY_ERROR;
 
-    if(NULL != bdCalcSyncSemaphore)
+    if(NULL != context->bdm_context)
     {
-        ret_val = cy_rtos_get_semaphore(&bdCalcSyncSemaphore,ui_timout_ms, false);
+        ret_val = cy_rtos_get_semaphore(&context->bdm_context->sync_semaphore,ui_timout_ms, false);
         if(0 != *bulk_delay)
         {
-            *bulk_delay = bulk_delay_output;
+            *bulk_delay = context->bdm_context->bulk_delay_output;
         }
     }
 
@@ -209,50 +200,52 @@ cy_rslt_t cy_afe_bd_calc_process(afe_internal_context_t *context,
 {
     cy_rslt_t ret_val = CY_RSLT_SUCCESS;
     int32_t bdm_state = 0;
+    afe_bdm_context_t *bdm = NULL;
 
-    if((NULL == context || NULL == sp_enh_input_output))
+    if((NULL == context || NULL == sp_enh_input_output || NULL == context->bdm_context))
     {
         ret_val = CY_RSLT_AFE_BAD_ARG;
         goto CLEAN_RETURN;
     }
+    bdm = context->bdm_context;
 
-    ret_val = afe_bdm_process(&bdm_struct,
+    ret_val = afe_bdm_process(&bdm->bdm_struct,
             sp_enh_input_output->aec_reference_input,
             sp_enh_input_output->input1,
             sp_enh_input_output->output);
 
-    bdm_state = afe_bdm_get_state(&bdm_struct);
+    bdm_state = afe_bdm_get_state(&bdm->bdm_struct);
 
-    ref_frame_count++;
-    if (ref_frame_count == num_ref_frames)
+    bdm->ref_frame_count++;
+    if (bdm->ref_frame_count == bdm->num_ref_frames)
     {
         // finished one round of ref signal playback, get ready to repeat
-        ref_frame_count = 0;
+        bdm->ref_frame_count = 0;
         if (bdm_state != AFE_BDM_SUCCESS)
         {
-            repeat_count++;
+            bdm->repeat_count++;
         }
     }
 
     if (bdm_state == AFE_BDM_SUCCESS)
     {
-        bulk_delay_output = afe_bdm_get_bulk_delay(&bdm_struct);
+        bdm->bulk_delay_output = afe_bdm_get_bulk_delay(&bdm->bdm_struct);
 
         BDM_PRINT_LOGS("%"PRIi32"valid delay estimates were obtained after %d repeats, with average delay of %dmsec",
-            bdm_struct.valid_delay_count, repeat_count,	bulk_delay_output);
+            bdm->bdm_struct.valid_delay_count, bdm->repeat_count,	bdm->bulk_delay_output);
 
         cy_afe_log_info("%"PRIi32"valid delay estimates were obtained after %d repeats, with average delay of %dmsec",
-            bdm_struct.valid_delay_count, repeat_count,	bulk_delay_output);
+            bdm->bdm_struct.valid_delay_count, bdm->repeat_count,	bdm->bulk_delay_output);
 
         goto BDM_COMPLETED;
     }
     else
     {
-        if(repeat_count == BULK_DELAY_IDENTIFY_MAX_REPEAT_COUNT)
+        if(bdm->repeat_count == BULK_DELAY_IDENTIFY_MAX_REPEAT_COUNT)
         {
             cy_afe_log_info("Err !! BDM Timeout");
             BDM_PRINT_LOGS("Err !! BDM Timeout");
-            bulk_delay_output = BULK_DELAY_ERROR;
+            bdm->bulk_delay_output = BULK_DELAY_ERROR;
             goto BDM_COMPLETED;
         }
     }
@@ -268,12 +261,11 @@ cy_rslt_t cy_afe_bd_calc_process(afe_internal_context_t *context,
 
 
  BDM_COMPLETED:
-    repeat_count = 0;
-    ref_frame_count = 0;
+    bdm->repeat_count = 0;
+    bdm->ref_frame_count = 0;
     if(NULL != context)
         context->is_bdm_enabled = false;
-    if(NULL != bdCalcSyncSemaphore)
-        (void) cy_rtos_set_semaphore(&bdCalcSyncSemaphore, false);
+    (void) cy_rtos_set_semaphore(&bdm->sync_semaphore, false);
 
     return CY_RSLT_SUCCESS;
 
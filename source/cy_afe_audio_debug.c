@@ -89,7 +89,23 @@ cy_rslt_t afe_update_stats(void *context, afe_stats_type_t type)
         }
         case AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT:
         {
-            handle->afe_frame_queue_push_fail_cnt++;
+            handle->overload_stats.frames_dropped_newest++;
+            break;
+        }
+        case AFE_FRAME_DROP_OLDEST_COUNT:
+        {
+            handle->overload_stats.frames_dropped_oldest++;
+            break;
+        }
+        case AFE_FRAME_BLOCK_COUNT:
+        {
+            handle->overload_stats.block_count++;
+            break;
+        }
+        case AFE_FRAME_BLOCK_TIMEOUT_COUNT:
+        {
+            handle->overload_stats.block_timeout_count++;
+            break;
         }
         default:
         {
@@ -137,6 +153,7 @@ cy_rslt_t afe_update_timestamp(void *context, afe_timestamp_type_t type)
 #ifdef CY_AFE_ENABLE_HEXDUMP
 cy_rslt_t afe_dump_hex(void *context, afe_hexdump_type_t type, int16_t *ptr)
 {
+    afe_internal_context_t *afe_context = (afe_internal_context_t*) context;
     int audio_frame_size = 0, i = 0;
     char *audio_data = NULL;
 
@@ -145,11 +162,7 @@ cy_rslt_t afe_dump_hex(void *context, afe_hexdump_type_t type, int16_t *ptr)
         case AFE_INPUT_AUDIO:
             printf("AFE Input data : [%p] \n", ptr);
 
-#if CY_AFE_INPUT_NUM_OF_CHANNELS == CY_AFE_AUDIO_MONO_SAMPLE
-            audio_frame_size = CY_AFE_MONO_FRAME_SIZE * sizeof(int16_t);
-#else
-            audio_frame_size = (CY_AFE_STEREO_FRAME_SIZE * sizeof(int16_t));
-#endif
+            audio_frame_size = (int)afe_context->input_frame_size;
             audio_data = (char*) ptr;
 
             for(i=0; i<audio_frame_size; i++)
@@ -165,11 +178,7 @@ cy_rslt_t afe_dump_hex(void *context, afe_hexdump_type_t type, int16_t *ptr)
         case AFE_AEC_REF:
             printf("AEC reference data : [%p] \n", ptr);
 
-#if CY_AFE_INPUT_NUM_OF_CHANNELS == CY_AFE_AUDIO_MONO_SAMPLE
-            audio_frame_size = CY_AFE_MONO_FRAME_SIZE * sizeof(int16_t);
-#else
-            audio_frame_size = (CY_AFE_STEREO_FRAME_SIZE * sizeof(int16_t));
-#endif
+            audio_frame_size = (int)afe_context->mono_frame_size;
             audio_data = (char*) ptr;
 
             for(i=0; i<audio_frame_size; i++)
@@ -184,11 +193,7 @@ cy_rslt_t afe_dump_hex(void *context, afe_hexdump_type_t type, int16_t *ptr)
         case AFE_AEC_OUTPUT:
             printf("AFE AEC Output:[%p]", ptr);
 
-#if CY_AFE_INPUT_NUM_OF_CHANNELS == CY_AFE_AUDIO_MONO_SAMPLE
-            audio_frame_size = CY_AFE_MONO_FRAME_SIZE * sizeof(int16_t);
-#else
-            audio_frame_size = (CY_AFE_STEREO_FRAME_SIZE * sizeof(int16_t));
-#endif
+            audio_frame_size = (int)afe_context->mono_frame_size;
             audio_data = (char*) ptr;
 
             for(i=0; i<audio_frame_size; i++)
@@ -203,7 +208,7 @@ cy_rslt_t afe_dump_hex(void *context, afe_hexdump_type_t type, int16_t *ptr)
         case AFE_OUTPUT:
             printf("AFE Output : [%p]\n", ptr);
 
-            audio_frame_size = CY_AFE_MONO_FRAME_SIZE * sizeof(int16_t);
+            audio_frame_size = (int)afe_context->mono_frame_size;
             audio_data = (char*) ptr;
 
             for(i=0; i<audio_frame_size; i++)
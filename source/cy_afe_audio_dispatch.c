@@ -0,0 +1,501 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_dispatch.c
+ * @brief Output dispatch stage. When enabled, processed frames are queued to the output
+ *        dispatch task which invokes the application output callback, so that a slow
+ *        consumer delays only the delivery and not the speech enhancement of next frames.
+ *        In pull mode the same queue is read by the application with cy_afe_read_output.
+ *
+ */
+
+#include "cy_audio_front_end.h"
+#include "cy_afe_audio_internal.h"
+#include "cyabs_rtos.h"
+#include "cy_afe_audio_dispatch.h"
+#include "cy_afe_audio_memory.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+#define AFE_OUTPUT_DISPATCH_TASK_NAME                    "afe-out-task"
+
+#ifndef AFE_OUTPUT_DISPATCH_TASK_THREAD_STACK_SIZE
+#define AFE_OUTPUT_DISPATCH_TASK_THREAD_STACK_SIZE       (4*1024)
+#endif
+
+#ifndef AFE_OUTPUT_DISPATCH_TASK_PRIORITY
+#define AFE_OUTPUT_DISPATCH_TASK_PRIORITY                (CY_RTOS_PRIORITY_BELOWNORMAL)
+#endif
+
+#ifndef AFE_OUTPUT_MSG_QUEUE_SIZE
+#define AFE_OUTPUT_MSG_QUEUE_SIZE                        (8)
+#endif
+
+#ifndef AFE_OUTPUT_POOL_SIZE
+#define AFE_OUTPUT_POOL_SIZE                             (4)
+#endif
+
+/* Longest time AFE processing task waits for an output consumer before the output is dropped */
+#ifndef AFE_OUTPUT_WAIT_TIMEOUT_MS
+#define AFE_OUTPUT_WAIT_TIMEOUT_MS                       (1000)
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static void afe_output_dispatch_task(cy_thread_arg_t arg);
+static cy_rslt_t afe_invoke_output_callback(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info);
+static void afe_dispatch_account_stall(afe_internal_context_t *context, cy_time_t start_time);
+static bool afe_dispatch_get_sizes(afe_internal_context_t *context, uint32_t *queue_size, uint32_t *pool_size);
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+/**
+ * Get the output queue and output pool sizes of the instance. Returns true if outputs are queued.
+ */
+static bool afe_dispatch_get_sizes(afe_internal_context_t *context, uint32_t *queue_size, uint32_t *pool_size)
+{
+    bool use_queue = false;
+
+    *queue_size = context->config_init.output_queue_size;
+    *pool_size = context->config_init.output_pool_size;
+
+    if (CY_AFE_OUTPUT_MODE_PULL == context->config_init.output_mode)
+    {
+        use_queue = true;
+        if (0 == *queue_size)
+        {
+            *queue_size = AFE_OUTPUT_MSG_QUEUE_SIZE;
+        }
+    }
+    else if (0 != *queue_size && NULL != context->config_init.afe_output_callback)
+    {
+#ifndef CY_AFE_ENABLE_TUNING_FEATURE
+        /* With tuning feature, debug outputs are single buffers shared by all frames, output is delivered inline */
+        use_queue = true;
+#endif
+    }
+
+    /*
+     * With output queue, one buffer per queued frame, one for the frame being consumed and one for
+     * the frame being processed (which may wait for a free slot) are required by default.
+     */
+    if (0 == *pool_size)
+    {
+        *pool_size = (true == use_queue) ? (*queue_size + 2) : AFE_OUTPUT_POOL_SIZE;
+    }
+
+    return use_queue;
+}
+
+/**
+ * Add the output buffer pool and output queue to the memory required by the instance
+ */
+void afe_require_output_dispatch_memory(afe_internal_context_t *context)
+{
+    uint32_t queue_size = 0;
+    uint32_t pool_size = 0;
+    bool use_queue = afe_dispatch_get_sizes(context, &queue_size, &pool_size);
+
+    if (NULL == context->config_init.afe_get_buffer_callback)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER,
+                afe_pool_buffer_size(context->app_output_frame_size, pool_size));
+    }
+
+    if (true == use_queue)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_OUTPUT_QUEUE,
+                afe_ring_buffer_size(sizeof(cy_afe_buffer_info_t), queue_size));
+    }
+}
+
+/**
+ * Creates AFE output buffer pool, output queue & output dispatch thread
+ */
+cy_rslt_t afe_setup_output_dispatch(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t queue_size = 0;
+    uint32_t pool_size = 0;
+    bool pull_mode = (CY_AFE_OUTPUT_MODE_PULL == context->config_init.output_mode);
+    bool use_queue = afe_dispatch_get_sizes(context, &queue_size, &pool_size);
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+    if (false == pull_mode && 0 != context->config_init.output_queue_size && NULL != context->config_init.afe_output_callback)
+    {
+        cy_afe_log_info("Output dispatch task is not used with tuning feature");
+    }
+#endif
+
+    if (NULL == context->config_init.afe_get_buffer_callback)
+    {
+        cy_afe_log_dbg("Initializing output buffer pool of %"PRIu32" frames", pool_size);
+
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER,
+                afe_pool_buffer_size(context->app_output_frame_size, pool_size),
+                &context->output_pool_buffer);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to allocate output buffer pool");
+            return result;
+        }
+
+        result = afe_pool_init(&context->output_pool, context->output_pool_buffer,
+                context->app_output_frame_size, pool_size);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "afe_pool_init failed");
+            goto CLEAN_RETURN;
+        }
+    }
+
+    if (false == use_queue)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    cy_afe_log_dbg("Initializing output queue of size %"PRIu32, queue_size);
+
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_OUTPUT_QUEUE,
+            afe_ring_buffer_size(sizeof(cy_afe_buffer_info_t), queue_size),
+            &context->output_dispatch_queue_buffer);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to allocate output queue");
+        goto CLEAN_RETURN;
+    }
+
+    result = afe_ring_init(&context->output_dispatch_queue, context->output_dispatch_queue_buffer,
+            sizeof(cy_afe_buffer_info_t), queue_size);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "afe_ring_init failed for output queue");
+        goto CLEAN_RETURN;
+    }
+
+    /* In pull mode, application reads the output queue with cy_afe_read_output */
+    if (true == pull_mode)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    context->output_dispatch_thread_running = true;
+
+    result = cy_rtos_create_thread(&context->output_dispatch_thread, afe_output_dispatch_task, AFE_OUTPUT_DISPATCH_TASK_NAME, NULL,
+                                    AFE_OUTPUT_DISPATCH_TASK_THREAD_STACK_SIZE, AFE_OUTPUT_DISPATCH_TASK_PRIORITY, context);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "cy_rtos_create_thread failed");
+        goto CLEAN_RETURN;
+    }
+
+    cy_afe_log_dbg("Output dispatch task created");
+
+    return CY_RSLT_SUCCESS;
+
+CLEAN_RETURN:
+    context->output_dispatch_thread_running = false;
+    afe_pool_deinit(&context->output_pool);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, context->output_pool_buffer);
+    context->output_pool_buffer = NULL;
+    afe_ring_deinit(&context->output_dispatch_queue);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_OUTPUT_QUEUE, context->output_dispatch_queue_buffer);
+    context->output_dispatch_queue_buffer = NULL;
+
+    return result;
+}
+
+/**
+ * Terminate output dispatch thread & de-initialize queue and output buffer pool
+ */
+cy_rslt_t afe_cleanup_output_dispatch(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (true == context->output_dispatch_thread_running)
+    {
+        result = cy_rtos_terminate_thread(&context->output_dispatch_thread);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "cy_rtos_terminate_thread failed");
+            return result;
+        }
+
+        result = cy_rtos_join_thread(&context->output_dispatch_thread);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "cy_rtos_join_thread failed");
+            return result;
+        }
+
+        cy_afe_log_dbg("Output dispatch thread terminated");
+        context->output_dispatch_thread_running = false;
+    }
+
+    afe_pool_deinit(&context->output_pool);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, context->output_pool_buffer);
+    context->output_pool_buffer = NULL;
+    afe_ring_deinit(&context->output_dispatch_queue);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_OUTPUT_QUEUE, context->output_dispatch_queue_buffer);
+    context->output_dispatch_queue_buffer = NULL;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Main task for delivering output to application
+ */
+static void afe_output_dispatch_task(cy_thread_arg_t arg)
+{
+    afe_internal_context_t *context = (afe_internal_context_t*) arg;
+    cy_afe_buffer_info_t output_info;
+
+    cy_afe_log_dbg("Running output dispatch task routine");
+
+    while (true == context->output_dispatch_thread_running)
+    {
+        if (CY_RSLT_SUCCESS == afe_ring_pop(&context->output_dispatch_queue, &output_info, CY_RTOS_NEVER_TIMEOUT))
+        {
+            afe_invoke_output_callback(context, &output_info);
+            afe_dispatch_release_output(context, &output_info);
+        }
+    }
+
+    cy_afe_log_dbg("Exiting from output dispatch task routine");
+}
+
+/**
+ * Invoke application registered output callback
+ */
+static cy_rslt_t afe_invoke_output_callback(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    result = context->config_init.afe_output_callback((void*) context, output_info,
+            context->config_init.user_arg_callbacks);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        /* Avoid error from application & continue processing next set of audio frames */
+        cy_afe_log_err(result, "AFE output callback returned error");
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Wait for a stalled output consumer and account the stall
+ */
+static void afe_dispatch_account_stall(afe_internal_context_t *context, cy_time_t start_time)
+{
+    cy_time_t end_time = 0;
+
+    cy_rtos_get_time(&end_time);
+
+    context->overload_stats.output_stall_count++;
+    if ((uint32_t)(end_time - start_time) > context->overload_stats.max_output_stall_ms)
+    {
+        context->overload_stats.max_output_stall_ms = (uint32_t)(end_time - start_time);
+    }
+}
+
+/**
+ * Time the current context may wait for an output consumer. Only AFE processing task waits: in the
+ * caller context of cy_afe_process, cy_afe_feed or an inline output callback, the consumer can be the
+ * caller itself.
+ */
+static uint32_t afe_dispatch_wait_timeout(afe_internal_context_t *context)
+{
+    cy_thread_t current_thread;
+
+    if (true == context->audio_processing_thread_running &&
+        CY_RSLT_SUCCESS == cy_rtos_get_thread_handle(&current_thread) &&
+        current_thread == context->audio_processing_thread)
+    {
+        return AFE_OUTPUT_WAIT_TIMEOUT_MS;
+    }
+
+    return 0;
+}
+
+uint32_t *afe_dispatch_get_pool_buffer(afe_internal_context_t *context)
+{
+    void *frame = NULL;
+    cy_time_t start_time = 0;
+    uint32_t timeout_ms = 0;
+
+    if (NULL == context->output_pool_buffer)
+    {
+        return NULL;
+    }
+
+    /*
+     * All frames are held by the consumers. A frame in use is never reused: AFE processing task waits
+     * for a release for a while, other contexts fail the frame at once.
+     */
+    if (CY_RSLT_SUCCESS != afe_pool_acquire(&context->output_pool, 0, &frame))
+    {
+        context->overload_stats.output_pool_exhausted_count++;
+        timeout_ms = afe_dispatch_wait_timeout(context);
+        if (0 != timeout_ms)
+        {
+            cy_rtos_get_time(&start_time);
+            if (CY_RSLT_SUCCESS != afe_pool_acquire(&context->output_pool, timeout_ms, &frame))
+            {
+                frame = NULL;
+            }
+            afe_dispatch_account_stall(context, start_time);
+        }
+    }
+
+    return (uint32_t *)frame;
+}
+
+/**
+ * Deliver output to application, through output queue if it is used
+ */
+cy_rslt_t afe_dispatch_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info)
+{
+    afe_ring_t *queue = &context->output_dispatch_queue;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_time_t start_time = 0;
+    uint32_t queue_depth = 0;
+    uint32_t timeout_ms = 0;
+
+    if (NULL == context->output_dispatch_queue_buffer)
+    {
+        if (NULL != context->config_init.afe_output_callback)
+        {
+            afe_invoke_output_callback(context, output_info);
+        }
+
+        /* Frame stays in use only if application has held it */
+        return afe_dispatch_release_output(context, output_info);
+    }
+
+    /*
+     * Consumer is slower than processing. AFE processing task waits for the consumer for a while
+     * and the stall is accounted, input queue overload policy applies meanwhile. Output which still
+     * does not fit, or which can not wait, is dropped.
+     */
+    if (0 == afe_ring_free_count(queue))
+    {
+        timeout_ms = afe_dispatch_wait_timeout(context);
+        if (0 != timeout_ms)
+        {
+            cy_rtos_get_time(&start_time);
+            result = afe_ring_wait_for_space(queue, 1, timeout_ms);
+            afe_dispatch_account_stall(context, start_time);
+        }
+        else
+        {
+            result = CY_RSLT_AFE_QUEUE_FULL;
+        }
+
+        if (CY_RSLT_SUCCESS != result)
+        {
+            context->overload_stats.output_drop_count++;
+            afe_dispatch_release_output(context, output_info);
+            return CY_RSLT_AFE_QUEUE_FULL;
+        }
+    }
+
+    afe_ring_push(queue, output_info);
+
+    queue_depth = afe_ring_count(queue);
+    if (queue_depth > context->overload_stats.max_output_queue_depth)
+    {
+        context->overload_stats.max_output_queue_depth = queue_depth;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Read next output from the output queue
+ */
+cy_rslt_t afe_dispatch_read_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info, uint32_t timeout_ms)
+{
+    if (CY_RSLT_SUCCESS != afe_ring_pop(&context->output_dispatch_queue, output_info, timeout_ms))
+    {
+        return CY_RSLT_AFE_TIMEOUT;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Add a reference to the internal output buffer of an output
+ */
+cy_rslt_t afe_dispatch_hold_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info)
+{
+    return afe_pool_hold(&context->output_pool, output_info->output_buf);
+}
+
+/**
+ * Return the internal output buffer of a consumed output to the pool
+ */
+cy_rslt_t afe_dispatch_release_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info)
+{
+    if (false == afe_pool_owns(&context->output_pool, output_info->output_buf))
+    {
+        /* Output buffer is owned by application or frame was dropped */
+        return CY_RSLT_SUCCESS;
+    }
+
+    return afe_pool_release(&context->output_pool, output_info->output_buf);
+}
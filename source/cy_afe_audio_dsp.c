@@ -0,0 +1,769 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_dsp.c
+ * @brief Sample buffer helpers and FIR kernels used on the audio path
+ *
+ */
+
+#include "cy_afe_audio_dsp.h"
+#include <string.h>
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define AFE_DSP_USE_MVE
+#if (__ARM_FEATURE_MVE & 2)
+#define AFE_DSP_USE_MVE_FP
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define AFE_DSP_USE_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AFE_DSP_USE_SSE2
+#endif
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/* Scale of 16 bit samples to float full scale and of dither to 16 bit LSB */
+#define AFE_DSP_S16_FULL_SCALE      (32768.0f)
+#define AFE_DSP_DITHER_SCALE        (1.0f / 65536.0f)
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+/* Dot product of two Q15 vectors, accumulated in Q30 */
+static inline int64_t afe_dsp_dot_q15(const int16_t *a, const int16_t *b, uint32_t length)
+{
+    int64_t acc = 0;
+#ifdef AFE_DSP_USE_MVE
+    int32_t remaining = (int32_t)length;
+    mve_pred16_t predicate;
+
+    /* 8 products per beat, inactive lanes of the last beat are loaded as zero */
+    while (remaining > 0)
+    {
+        predicate = vctp16q((uint32_t)remaining);
+        acc = vmlaldavaq_s16(acc, vld1q_z_s16(a, predicate), vld1q_z_s16(b, predicate));
+        a += 8;
+        b += 8;
+        remaining -= 8;
+    }
+#else
+    uint32_t index = 0;
+
+    for (index = 0; index < length; index++)
+    {
+        acc += (int32_t)a[index] * b[index];
+    }
+#endif
+    return acc;
+}
+
+/* Round Q30 accumulator to Q15 with saturation */
+static inline int16_t afe_dsp_round_q15(int64_t acc)
+{
+    acc = (acc + (1 << 14)) >> 15;
+
+    if (acc > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (acc < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)acc;
+}
+
+/* Saturate to the 16 bit range */
+static inline int16_t afe_dsp_saturate_s16(int32_t value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+/* Round a float sample scaled to 16 bit, with saturation. NaN saturates to the maximum. */
+static inline int16_t afe_dsp_round_f32(float value)
+{
+    if (!(value < (float)INT16_MAX))
+    {
+        return INT16_MAX;
+    }
+    if (value < (float)INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return afe_dsp_saturate_s16((int32_t)(value + ((value >= 0.0f) ? 0.5f : -0.5f)));
+}
+
+/* Next output of the xorshift32 dither generator */
+static inline uint32_t afe_dsp_xorshift32(uint32_t state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/* Triangular dither from one generator output, the sum of its two 16 bit halves:
+ * -65535 .. 65535 in units of 1/65536 of the 16 bit output LSB */
+static inline int32_t afe_dsp_tpdf(uint32_t random)
+{
+    return (int32_t)(random & 0xFFFFu) + (int32_t)(random >> 16) - 0xFFFF;
+}
+
+/* Seed one generator per vector lane from the scalar generator */
+static inline void afe_dsp_seed_lanes(uint32_t *dither_state, uint32_t lanes[4])
+{
+    uint32_t lane = 0;
+
+    for (lane = 0; lane < 4; lane++)
+    {
+        *dither_state = afe_dsp_xorshift32(*dither_state);
+        lanes[lane] = *dither_state;
+    }
+}
+
+#if defined(AFE_DSP_USE_MVE) || defined(AFE_DSP_USE_NEON)
+static inline uint32x4_t afe_dsp_xorshift32_vec(uint32x4_t state)
+{
+    state = veorq_u32(state, vshlq_n_u32(state, 13));
+    state = veorq_u32(state, vshrq_n_u32(state, 17));
+    return veorq_u32(state, vshlq_n_u32(state, 5));
+}
+
+static inline int32x4_t afe_dsp_tpdf_vec(uint32x4_t random)
+{
+    return vsubq_s32(vreinterpretq_s32_u32(vaddq_u32(vandq_u32(random, vdupq_n_u32(0xFFFFu)), vshrq_n_u32(random, 16))),
+            vdupq_n_s32(0xFFFF));
+}
+#elif defined(AFE_DSP_USE_SSE2)
+static inline __m128i afe_dsp_xorshift32_vec(__m128i state)
+{
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+    state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+    return _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+}
+
+static inline __m128i afe_dsp_tpdf_vec(__m128i random)
+{
+    return _mm_sub_epi32(_mm_add_epi32(_mm_and_si128(random, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(random, 16)),
+            _mm_set1_epi32(0xFFFF));
+}
+#endif
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+void afe_dsp_copy(void *dst, const void *src, uint32_t size)
+{
+#ifdef AFE_DSP_USE_MVE
+    uint8_t *dst_ptr = (uint8_t *)dst;
+    const uint8_t *src_ptr = (const uint8_t *)src;
+    int32_t remaining = (int32_t)size;
+    mve_pred16_t predicate;
+
+    /* 16 bytes per beat, last beat is tail predicated */
+    while (remaining > 0)
+    {
+        predicate = vctp8q((uint32_t)remaining);
+        vst1q_p_u8(dst_ptr, vld1q_z_u8(src_ptr, predicate), predicate);
+        dst_ptr += 16;
+        src_ptr += 16;
+        remaining -= 16;
+    }
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+void afe_dsp_deinterleave_s16(const int16_t *input, int16_t *output1, int16_t *output2, uint32_t samples)
+{
+    uint32_t index = 0;
+
+#if defined(AFE_DSP_USE_MVE) || defined(AFE_DSP_USE_NEON)
+    int16x8x2_t pair;
+
+    /* 8 samples of each channel per iteration, split by the structure load */
+    for (; (index + 8) <= samples; index += 8)
+    {
+        pair = vld2q_s16(input + (2 * index));
+        vst1q_s16(output1 + index, pair.val[0]);
+        vst1q_s16(output2 + index, pair.val[1]);
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128i low;
+    __m128i high;
+
+    /* 8 samples of each channel per iteration. Channel-1 is the sign extended low half of each
+     * 32 bit pair and channel-2 the high half, so packing them back to 16 bits never saturates.
+     */
+    for (; (index + 8) <= samples; index += 8)
+    {
+        low = _mm_loadu_si128((const __m128i *)(input + (2 * index)));
+        high = _mm_loadu_si128((const __m128i *)(input + (2 * index) + 8));
+        _mm_storeu_si128((__m128i *)(output1 + index),
+                _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16), _mm_srai_epi32(_mm_slli_epi32(high, 16), 16)));
+        _mm_storeu_si128((__m128i *)(output2 + index),
+                _mm_packs_epi32(_mm_srai_epi32(low, 16), _mm_srai_epi32(high, 16)));
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        output1[index] = input[2 * index];
+        output2[index] = input[(2 * index) + 1];
+    }
+}
+
+void afe_dsp_downmix_s16(const int16_t *input, uint32_t channels, uint32_t channel_stride, uint32_t sample_stride,
+        const int16_t *weights, int16_t *output, uint32_t samples)
+{
+    uint32_t index = 0;
+    uint32_t channel = 0;
+    int32_t acc = 0;
+
+#ifdef AFE_DSP_USE_MVE
+    int32x4_t vector;
+    int16x8_t pairs;
+    int32_t remaining = (int32_t)samples;
+    mve_pred16_t predicate;
+
+    if (2 == channels && 1 == channel_stride && 2 == sample_stride)
+    {
+        /* Channel-1 is in the bottom and channel-2 in the top half of each sample pair */
+        while (remaining > 0)
+        {
+            predicate = vctp32q((uint32_t)remaining);
+            pairs = vld1q_z_s16(input + (2 * index), vctp16q(2 * (uint32_t)remaining));
+            vector = vaddq_s32(vmullbq_int_s16(pairs, vdupq_n_s16(weights[0])), vmulltq_int_s16(pairs, vdupq_n_s16(weights[1])));
+            vector = vminq_s32(vmaxq_s32(vrshrq_n_s32(vector, 15), vdupq_n_s32(INT16_MIN)), vdupq_n_s32(INT16_MAX));
+            vstrhq_p_s32(output + index, vector, predicate);
+            index += 4;
+            remaining -= 4;
+        }
+        index = samples;
+    }
+    else if (1 == sample_stride)
+    {
+        /* 4 samples per beat, widened by the load of every channel */
+        while (remaining > 0)
+        {
+            predicate = vctp32q((uint32_t)remaining);
+            vector = vdupq_n_s32(0);
+            for (channel = 0; channel < channels; channel++)
+            {
+                vector = vmlaq_n_s32(vector, vldrhq_z_s32(input + (channel * channel_stride) + index, predicate), weights[channel]);
+            }
+            vector = vminq_s32(vmaxq_s32(vrshrq_n_s32(vector, 15), vdupq_n_s32(INT16_MIN)), vdupq_n_s32(INT16_MAX));
+            vstrhq_p_s32(output + index, vector, predicate);
+            index += 4;
+            remaining -= 4;
+        }
+        index = samples;
+    }
+#elif defined(AFE_DSP_USE_NEON)
+    int32x4_t vector;
+    int16x4x2_t pair;
+
+    if (2 == channels && 1 == channel_stride && 2 == sample_stride)
+    {
+        for (; (index + 4) <= samples; index += 4)
+        {
+            pair = vld2_s16(input + (2 * index));
+            vector = vmlal_n_s16(vmull_n_s16(pair.val[0], weights[0]), pair.val[1], weights[1]);
+            vst1_s16(output + index, vqrshrn_n_s32(vector, 15));
+        }
+    }
+    else if (1 == sample_stride)
+    {
+        for (; (index + 4) <= samples; index += 4)
+        {
+            vector = vdupq_n_s32(0);
+            for (channel = 0; channel < channels; channel++)
+            {
+                vector = vmlal_n_s16(vector, vld1_s16(input + (channel * channel_stride) + index), weights[channel]);
+            }
+            vst1_s16(output + index, vqrshrn_n_s32(vector, 15));
+        }
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128i low;
+    __m128i high;
+    __m128i first;
+    __m128i second;
+    __m128i weight_pair;
+    __m128i rounding = _mm_set1_epi32(1 << 14);
+
+    if (2 == channels && 1 == channel_stride && 2 == sample_stride)
+    {
+        /* Each sample pair is multiplied by the weight pair and summed by a single multiply-add */
+        weight_pair = _mm_set1_epi32((int32_t)(((uint32_t)(uint16_t)weights[1] << 16) | (uint16_t)weights[0]));
+        for (; (index + 8) <= samples; index += 8)
+        {
+            low = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(input + (2 * index))), weight_pair);
+            high = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(input + (2 * index) + 8)), weight_pair);
+            _mm_storeu_si128((__m128i *)(output + index),
+                    _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(low, rounding), 15),
+                            _mm_srai_epi32(_mm_add_epi32(high, rounding), 15)));
+        }
+    }
+    else if (1 == sample_stride)
+    {
+        /* Channels are paired by interleaving their samples, an odd last channel is paired with silence */
+        for (; (index + 8) <= samples; index += 8)
+        {
+            low = rounding;
+            high = rounding;
+            for (channel = 0; channel < channels; channel += 2)
+            {
+                first = _mm_loadu_si128((const __m128i *)(input + (channel * channel_stride) + index));
+                second = _mm_setzero_si128();
+                weight_pair = _mm_set1_epi32((uint16_t)weights[channel]);
+                if ((channel + 1) < channels)
+                {
+                    second = _mm_loadu_si128((const __m128i *)(input + ((channel + 1) * channel_stride) + index));
+                    weight_pair = _mm_set1_epi32((int32_t)(((uint32_t)(uint16_t)weights[channel + 1] << 16) |
+                            (uint16_t)weights[channel]));
+                }
+                low = _mm_add_epi32(low, _mm_madd_epi16(_mm_unpacklo_epi16(first, second), weight_pair));
+                high = _mm_add_epi32(high, _mm_madd_epi16(_mm_unpackhi_epi16(first, second), weight_pair));
+            }
+            _mm_storeu_si128((__m128i *)(output + index),
+                    _mm_packs_epi32(_mm_srai_epi32(low, 15), _mm_srai_epi32(high, 15)));
+        }
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        acc = 0;
+        for (channel = 0; channel < channels; channel++)
+        {
+            acc += (int32_t)input[(channel * channel_stride) + (index * sample_stride)] * weights[channel];
+        }
+        output[index] = afe_dsp_saturate_s16((acc + (1 << 14)) >> 15);
+    }
+}
+
+void afe_dsp_s32_to_s16(const int32_t *input, uint32_t stride, uint32_t shift, int16_t *output, uint32_t samples,
+        uint32_t *dither_state)
+{
+    uint32_t index = 0;
+    int32_t value = 0;
+#if defined(AFE_DSP_USE_MVE) || defined(AFE_DSP_USE_NEON) || defined(AFE_DSP_USE_SSE2)
+    uint32_t lanes[4] = {0};
+#endif
+
+    /* Samples are rounded from Q30, leaving headroom for the dither */
+#ifdef AFE_DSP_USE_MVE
+    int32x4_t vector;
+    uint32x4_t random = vdupq_n_u32(0);
+    int32_t remaining = (int32_t)samples;
+    mve_pred16_t predicate;
+
+    if (1 == stride)
+    {
+        if (NULL != dither_state)
+        {
+            afe_dsp_seed_lanes(dither_state, lanes);
+            random = vld1q_u32(lanes);
+        }
+
+        /* 4 samples per beat, last beat is tail predicated */
+        while (remaining > 0)
+        {
+            predicate = vctp32q((uint32_t)remaining);
+            vector = vshrq_n_s32(vshlq_s32(vld1q_z_s32(input + index, predicate), vdupq_n_s32((int32_t)shift)), 1);
+            if (NULL != dither_state)
+            {
+                random = afe_dsp_xorshift32_vec(random);
+                vector = vaddq_s32(vector, vshrq_n_s32(afe_dsp_tpdf_vec(random), 1));
+            }
+            vector = vshrq_n_s32(vaddq_n_s32(vector, 1 << 14), 15);
+            vector = vminq_s32(vmaxq_s32(vector, vdupq_n_s32(INT16_MIN)), vdupq_n_s32(INT16_MAX));
+            vstrhq_p_s32(output + index, vector, predicate);
+            index += 4;
+            remaining -= 4;
+        }
+        index = samples;
+
+        if (NULL != dither_state)
+        {
+            vst1q_u32(lanes, random);
+            *dither_state = lanes[3];
+        }
+    }
+#elif defined(AFE_DSP_USE_NEON)
+    int32x4_t vector;
+    uint32x4_t random = vdupq_n_u32(0);
+
+    if (1 == stride)
+    {
+        if (NULL != dither_state)
+        {
+            afe_dsp_seed_lanes(dither_state, lanes);
+            random = vld1q_u32(lanes);
+        }
+
+        /* 4 samples per iteration, narrowed with saturation */
+        for (; (index + 4) <= samples; index += 4)
+        {
+            vector = vshrq_n_s32(vshlq_s32(vld1q_s32(input + index), vdupq_n_s32((int32_t)shift)), 1);
+            if (NULL != dither_state)
+            {
+                random = afe_dsp_xorshift32_vec(random);
+                vector = vaddq_s32(vector, vshrq_n_s32(afe_dsp_tpdf_vec(random), 1));
+            }
+            vst1_s16(output + index, vqmovn_s32(vshrq_n_s32(vaddq_s32(vector, vdupq_n_s32(1 << 14)), 15)));
+        }
+
+        if (NULL != dither_state)
+        {
+            vst1q_u32(lanes, random);
+            *dither_state = lanes[3];
+        }
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128i low;
+    __m128i high;
+    __m128i random = _mm_setzero_si128();
+    __m128i rounding = _mm_set1_epi32(1 << 14);
+    __m128i shift_count = _mm_cvtsi32_si128((int)shift);
+
+    if (1 == stride)
+    {
+        if (NULL != dither_state)
+        {
+            afe_dsp_seed_lanes(dither_state, lanes);
+            random = _mm_loadu_si128((const __m128i *)lanes);
+        }
+
+        /* 8 samples per iteration, packed with saturation */
+        for (; (index + 8) <= samples; index += 8)
+        {
+            low = _mm_srai_epi32(_mm_sll_epi32(_mm_loadu_si128((const __m128i *)(input + index)), shift_count), 1);
+            high = _mm_srai_epi32(_mm_sll_epi32(_mm_loadu_si128((const __m128i *)(input + index + 4)), shift_count), 1);
+            if (NULL != dither_state)
+            {
+                random = afe_dsp_xorshift32_vec(random);
+                low = _mm_add_epi32(low, _mm_srai_epi32(afe_dsp_tpdf_vec(random), 1));
+                random = afe_dsp_xorshift32_vec(random);
+                high = _mm_add_epi32(high, _mm_srai_epi32(afe_dsp_tpdf_vec(random), 1));
+            }
+            _mm_storeu_si128((__m128i *)(output + index),
+                    _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(low, rounding), 15),
+                            _mm_srai_epi32(_mm_add_epi32(high, rounding), 15)));
+        }
+
+        if (NULL != dither_state)
+        {
+            _mm_storeu_si128((__m128i *)lanes, random);
+            *dither_state = lanes[3];
+        }
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        value = (int32_t)((uint32_t)input[index * stride] << shift) >> 1;
+        if (NULL != dither_state)
+        {
+            *dither_state = afe_dsp_xorshift32(*dither_state);
+            value += afe_dsp_tpdf(*dither_state) >> 1;
+        }
+        output[index] = afe_dsp_saturate_s16((value + (1 << 14)) >> 15);
+    }
+}
+
+void afe_dsp_f32_to_s16(const float *input, uint32_t stride, int16_t *output, uint32_t samples,
+        uint32_t *dither_state)
+{
+    uint32_t index = 0;
+    float value = 0.0f;
+#if defined(AFE_DSP_USE_MVE_FP) || defined(AFE_DSP_USE_SSE2)
+    uint32_t lanes[4] = {0};
+#endif
+
+#ifdef AFE_DSP_USE_MVE_FP
+    float32x4_t vector;
+    int32x4_t rounded;
+    uint32x4_t random = vdupq_n_u32(0);
+    int32_t remaining = (int32_t)samples;
+    mve_pred16_t predicate;
+
+    if (1 == stride)
+    {
+        if (NULL != dither_state)
+        {
+            afe_dsp_seed_lanes(dither_state, lanes);
+            random = vld1q_u32(lanes);
+        }
+
+        /* 4 samples per beat, clamped to 16 bit before the conversion */
+        while (remaining > 0)
+        {
+            predicate = vctp32q((uint32_t)remaining);
+            vector = vmulq_n_f32(vld1q_z_f32(input + index, predicate), AFE_DSP_S16_FULL_SCALE);
+            if (NULL != dither_state)
+            {
+                random = afe_dsp_xorshift32_vec(random);
+                vector = vaddq_f32(vector, vmulq_n_f32(vcvtq_f32_s32(afe_dsp_tpdf_vec(random)), AFE_DSP_DITHER_SCALE));
+            }
+            /* As afe_dsp_round_f32: NaN clamps to the maximum (minNum returns the number), ties round away from zero */
+            vector = vmaxnmq_f32(vminnmq_f32(vector, vdupq_n_f32((float)INT16_MAX)), vdupq_n_f32((float)INT16_MIN));
+            rounded = vcvtaq_s32_f32(vector);
+            vstrhq_p_s32(output + index, rounded, predicate);
+            index += 4;
+            remaining -= 4;
+        }
+        index = samples;
+
+        if (NULL != dither_state)
+        {
+            vst1q_u32(lanes, random);
+            *dither_state = lanes[3];
+        }
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128 low;
+    __m128 high;
+    __m128i random = _mm_setzero_si128();
+    __m128 scale = _mm_set1_ps(AFE_DSP_S16_FULL_SCALE);
+    __m128 dither_scale = _mm_set1_ps(AFE_DSP_DITHER_SCALE);
+    __m128 lower = _mm_set1_ps((float)INT16_MIN);
+    __m128 upper = _mm_set1_ps((float)INT16_MAX);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 sign = _mm_set1_ps(-0.0f);
+
+    if (1 == stride)
+    {
+        if (NULL != dither_state)
+        {
+            afe_dsp_seed_lanes(dither_state, lanes);
+            random = _mm_loadu_si128((const __m128i *)lanes);
+        }
+
+        /*
+         * 8 samples per iteration, rounded as afe_dsp_round_f32: clamped before the conversion which does not saturate,
+         * with the sample as first operand of min so that NaN gives the maximum, then +-0.5 and truncated so that ties
+         * round away from zero
+         */
+        for (; (index + 8) <= samples; index += 8)
+        {
+            low = _mm_mul_ps(_mm_loadu_ps(input + index), scale);
+            high = _mm_mul_ps(_mm_loadu_ps(input + index + 4), scale);
+            if (NULL != dither_state)
+            {
+                random = afe_dsp_xorshift32_vec(random);
+                low = _mm_add_ps(low, _mm_mul_ps(_mm_cvtepi32_ps(afe_dsp_tpdf_vec(random)), dither_scale));
+                random = afe_dsp_xorshift32_vec(random);
+                high = _mm_add_ps(high, _mm_mul_ps(_mm_cvtepi32_ps(afe_dsp_tpdf_vec(random)), dither_scale));
+            }
+            low = _mm_max_ps(_mm_min_ps(low, upper), lower);
+            high = _mm_max_ps(_mm_min_ps(high, upper), lower);
+            low = _mm_add_ps(low, _mm_or_ps(_mm_and_ps(low, sign), half));
+            high = _mm_add_ps(high, _mm_or_ps(_mm_and_ps(high, sign), half));
+            _mm_storeu_si128((__m128i *)(output + index), _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high)));
+        }
+
+        if (NULL != dither_state)
+        {
+            _mm_storeu_si128((__m128i *)lanes, random);
+            *dither_state = lanes[3];
+        }
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        value = input[index * stride] * AFE_DSP_S16_FULL_SCALE;
+        if (NULL != dither_state)
+        {
+            *dither_state = afe_dsp_xorshift32(*dither_state);
+            value += (float)afe_dsp_tpdf(*dither_state) * AFE_DSP_DITHER_SCALE;
+        }
+        output[index] = afe_dsp_round_f32(value);
+    }
+}
+
+void afe_dsp_s16_to_s32(const int16_t *input, uint32_t shift, int32_t *output, uint32_t samples)
+{
+    uint32_t index = 0;
+
+#ifdef AFE_DSP_USE_MVE
+    int32_t remaining = (int32_t)samples;
+    mve_pred16_t predicate;
+
+    /* 4 samples per beat, widened by the load */
+    while (remaining > 0)
+    {
+        predicate = vctp32q((uint32_t)remaining);
+        vst1q_p_s32(output + index, vshlq_s32(vldrhq_z_s32(input + index, predicate), vdupq_n_s32((int32_t)shift)),
+                predicate);
+        index += 4;
+        remaining -= 4;
+    }
+    index = samples;
+#elif defined(AFE_DSP_USE_NEON)
+    int16x8_t vector;
+
+    for (; (index + 8) <= samples; index += 8)
+    {
+        vector = vld1q_s16(input + index);
+        vst1q_s32(output + index, vshlq_s32(vmovl_s16(vget_low_s16(vector)), vdupq_n_s32((int32_t)shift)));
+        vst1q_s32(output + index + 4, vshlq_s32(vmovl_s16(vget_high_s16(vector)), vdupq_n_s32((int32_t)shift)));
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128i vector;
+    __m128i zero = _mm_setzero_si128();
+    __m128i shift_count = _mm_cvtsi32_si128((int)(16 - shift));
+
+    /* Unpacking into the high halves gives the sample shifted by 16, shifted back arithmetically */
+    for (; (index + 8) <= samples; index += 8)
+    {
+        vector = _mm_loadu_si128((const __m128i *)(input + index));
+        _mm_storeu_si128((__m128i *)(output + index), _mm_sra_epi32(_mm_unpacklo_epi16(zero, vector), shift_count));
+        _mm_storeu_si128((__m128i *)(output + index + 4), _mm_sra_epi32(_mm_unpackhi_epi16(zero, vector), shift_count));
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        output[index] = (int32_t)((uint32_t)(int32_t)input[index] << shift);
+    }
+}
+
+void afe_dsp_s16_to_f32(const int16_t *input, float *output, uint32_t samples)
+{
+    uint32_t index = 0;
+
+#ifdef AFE_DSP_USE_MVE_FP
+    int32_t remaining = (int32_t)samples;
+    mve_pred16_t predicate;
+
+    while (remaining > 0)
+    {
+        predicate = vctp32q((uint32_t)remaining);
+        vst1q_p_f32(output + index, vmulq_n_f32(vcvtq_f32_s32(vldrhq_z_s32(input + index, predicate)),
+                1.0f / AFE_DSP_S16_FULL_SCALE), predicate);
+        index += 4;
+        remaining -= 4;
+    }
+    index = samples;
+#elif defined(AFE_DSP_USE_NEON)
+    int16x8_t vector;
+
+    for (; (index + 8) <= samples; index += 8)
+    {
+        vector = vld1q_s16(input + index);
+        vst1q_f32(output + index, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(vector))), 1.0f / AFE_DSP_S16_FULL_SCALE));
+        vst1q_f32(output + index + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(vector))), 1.0f / AFE_DSP_S16_FULL_SCALE));
+    }
+#elif defined(AFE_DSP_USE_SSE2)
+    __m128i vector;
+    __m128i zero = _mm_setzero_si128();
+    __m128 scale = _mm_set1_ps(1.0f / AFE_DSP_S16_FULL_SCALE);
+
+    for (; (index + 8) <= samples; index += 8)
+    {
+        vector = _mm_loadu_si128((const __m128i *)(input + index));
+        _mm_storeu_ps(output + index, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(zero, vector), 16)), scale));
+        _mm_storeu_ps(output + index + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(zero, vector), 16)), scale));
+    }
+#endif
+
+    for (; index < samples; index++)
+    {
+        output[index] = (float)input[index] * (1.0f / AFE_DSP_S16_FULL_SCALE);
+    }
+}
+
+void afe_dsp_fir_decimate_q15(const int16_t *input, const int16_t *coefficients, uint32_t taps,
+        uint32_t factor, int16_t *output, uint32_t output_samples)
+{
+    uint32_t index = 0;
+
+    /* Only every factor-th output of the filter is computed */
+    for (index = 0; index < output_samples; index++)
+    {
+        output[index] = afe_dsp_round_q15(afe_dsp_dot_q15(input + (index * factor), coefficients, taps));
+    }
+}
+
+void afe_dsp_fir_interpolate_q15(const int16_t *input, const int16_t *coefficients, uint32_t taps_per_phase,
+        uint32_t factor, int16_t *output, uint32_t input_samples)
+{
+    uint32_t index = 0;
+    uint32_t phase = 0;
+
+    /* Each output phase is filtered by its own branch, zero stuffed samples are never multiplied */
+    for (index = 0; index < input_samples; index++)
+    {
+        for (phase = 0; phase < factor; phase++)
+        {
+            *output++ = afe_dsp_round_q15(afe_dsp_dot_q15(input + index,
+                    coefficients + (phase * taps_per_phase), taps_per_phase));
+        }
+    }
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+
+/**
+ * @file cy_afe_audio_format.c
+ * @brief Application buffers are converted to and from the 16 bit frames processed within the
+ *        copy which already takes place, so that no separate conversion pass is made over the audio.
+ *
+ */
+
+#include "cy_audio_front_end.h"
+#include "cy_afe_audio_internal.h"
+#include "cy_afe_audio_format.h"
+#include "cy_afe_audio_memory.h"
+#include "cy_afe_audio_dsp.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/* Any non zero seed is valid for the xorshift dither generator */
+#define AFE_FORMAT_DITHER_SEED      (0x2545F491u)
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+
+/**
+ * Convert samples in the input sample format, other than 16 bit, to 16 bit
+ */
+static void afe_format_to_s16(afe_internal_context_t *context, const uint8_t *input, uint32_t stride,
+        CY_AFE_DATA_T *output, uint32_t count)
+{
+    uint32_t *dither_state = (true == context->config_init.input_format.dither) ? &context->dither_state : NULL;
+
+    switch (context->config_init.input_format.sample_format)
+    {
+        case CY_AFE_SAMPLE_FORMAT_S32:
+            afe_dsp_s32_to_s16((const int32_t *)input, stride, 0, output, count, dither_state);
+            break;
+        case CY_AFE_SAMPLE_FORMAT_S24_IN_32:
+            afe_dsp_s32_to_s16((const int32_t *)input, stride, 8, output, count, dither_state);
+            break;
+        case CY_AFE_SAMPLE_FORMAT_F32:
+            afe_dsp_f32_to_s16((const float *)input, stride, output, count, dither_state);
+            break;
+        default:
+            break;
+    }
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+uint32_t afe_format_sample_size(cy_afe_sample_format_t sample_format)
+{
+    switch (sample_format)
+    {
+        case CY_AFE_SAMPLE_FORMAT_S16:
+            return sizeof(CY_AFE_DATA_T);
+        case CY_AFE_SAMPLE_FORMAT_S32:
+        case CY_AFE_SAMPLE_FORMAT_S24_IN_32:
+            return sizeof(int32_t);
+        case CY_AFE_SAMPLE_FORMAT_F32:
+            return sizeof(float);
+        default:
+            return 0;
+    }
+}
+
+static uint32_t afe_format_get_aec_ref_scratch_size(afe_internal_context_t *context)
+{
+    if (context->aec_ref_channels > 1 && CY_AFE_SAMPLE_FORMAT_S16 != context->config_init.input_format.sample_format)
+    {
+        return context->aec_ref_channels * context->mono_frame_size;
+    }
+    return 0;
+}
+
+uint32_t afe_format_get_scratch_size(afe_internal_context_t *context)
+{
+    /* Frames may be converted by the feeding context while the library uses the arena in the processing task */
+    if (CY_AFE_PROCESSING_MODE_SYNC != context->config_init.processing_mode ||
+        true == context->config_init.share_scratch_memory)
+    {
+        return 0;
+    }
+    return afe_format_get_aec_ref_scratch_size(context);
+}
+
+void afe_require_format_conversion_memory(afe_internal_context_t *context)
+{
+    if (true == context->input_convert || true == context->aec_ref_convert)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_frame_size + context->mono_frame_size);
+    }
+
+    if (0 == afe_format_get_scratch_size(context) && 0 != afe_format_get_aec_ref_scratch_size(context))
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, afe_format_get_aec_ref_scratch_size(context));
+    }
+
+    if (CY_AFE_SAMPLE_FORMAT_S16 != context->config_init.output_format.sample_format)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, context->mono_frame_size);
+    }
+}
+
+cy_rslt_t afe_setup_format_conversion(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    context->dither_state = AFE_FORMAT_DITHER_SEED;
+
+    if (true == context->input_convert || true == context->aec_ref_convert)
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                context->input_frame_size + context->mono_frame_size, (void **)&context->input_convert_frame);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    if (0 == afe_format_get_scratch_size(context) && 0 != afe_format_get_aec_ref_scratch_size(context))
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                afe_format_get_aec_ref_scratch_size(context), (void **)&context->aec_ref_scratch);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    if (CY_AFE_SAMPLE_FORMAT_S16 != context->config_init.output_format.sample_format)
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, context->mono_frame_size,
+                (void **)&context->output_convert_frame);
+    }
+
+    return result;
+}
+
+void afe_cleanup_format_conversion(afe_internal_context_t *context)
+{
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_convert_frame);
+    context->input_convert_frame = NULL;
+
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->aec_ref_scratch);
+    context->aec_ref_scratch = NULL;
+
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_OUTPUT_BUFFER, context->output_convert_frame);
+    context->output_convert_frame = NULL;
+}
+
+void afe_format_input(afe_internal_context_t *context, const void *input, uint32_t buffer_samples, uint32_t offset,
+        CY_AFE_DATA_T *frame, uint32_t frame_offset, uint32_t count)
+{
+    const uint8_t *input_bytes = (const uint8_t *)input;
+    uint32_t channel = 0;
+
+    if (CY_AFE_SAMPLE_FORMAT_S16 == context->config_init.input_format.sample_format)
+    {
+        /* Interleaved stereo is split by a single pass over both channels */
+        if (true == context->input_interleaved)
+        {
+            afe_dsp_deinterleave_s16((const CY_AFE_DATA_T *)input + (2 * offset), frame + frame_offset,
+                    frame + context->frame_samples + frame_offset, count);
+            return;
+        }
+
+        for (channel = 0; channel < context->num_channels; channel++)
+        {
+            afe_dsp_copy(frame + (channel * context->frame_samples) + frame_offset,
+                    (const CY_AFE_DATA_T *)input + (channel * buffer_samples) + offset, count * sizeof(CY_AFE_DATA_T));
+        }
+        return;
+    }
+
+    for (channel = 0; channel < context->num_channels; channel++)
+    {
+        if (true == context->input_interleaved)
+        {
+            afe_format_to_s16(context, input_bytes + (((offset * context->num_channels) + channel) * context->input_sample_size),
+                    context->num_channels, frame + (channel * context->frame_samples) + frame_offset, count);
+        }
+        else
+        {
+            afe_format_to_s16(context, input_bytes + (((channel * buffer_samples) + offset) * context->input_sample_size),
+                    1, frame + (channel * context->frame_samples) + frame_offset, count);
+        }
+    }
+}
+
+void afe_format_aec_ref(afe_internal_context_t *context, const void *aec_ref, uint32_t buffer_samples, uint32_t offset,
+        CY_AFE_DATA_T *output, uint32_t count)
+{
+    const uint8_t *first = NULL;
+    uint32_t channel_stride = (true == context->aec_ref_interleaved) ? 1 : buffer_samples;
+    uint32_t sample_stride = (true == context->aec_ref_interleaved) ? context->aec_ref_channels : 1;
+    uint32_t channel = 0;
+    CY_AFE_DATA_T *scratch = NULL;
+
+    if (1 == context->aec_ref_channels)
+    {
+        if (CY_AFE_SAMPLE_FORMAT_S16 == context->config_init.input_format.sample_format)
+        {
+            afe_dsp_copy(output, (const CY_AFE_DATA_T *)aec_ref + offset, count * sizeof(CY_AFE_DATA_T));
+            return;
+        }
+
+        afe_format_to_s16(context, (const uint8_t *)aec_ref + (offset * context->input_sample_size), 1, output, count);
+        return;
+    }
+
+    first = (const uint8_t *)aec_ref + (offset * sample_stride * context->input_sample_size);
+
+    /* 16 bit channels are weighted and summed in the pass which copies them */
+    if (CY_AFE_SAMPLE_FORMAT_S16 == context->config_init.input_format.sample_format)
+    {
+        afe_dsp_downmix_s16((const CY_AFE_DATA_T *)first, context->aec_ref_channels, channel_stride, sample_stride,
+                context->aec_ref_weights, output, count);
+        return;
+    }
+
+    /* Wider channels are reduced to 16 bit first, the downmix then reads them from scratch */
+    scratch = (NULL != context->aec_ref_scratch) ? context->aec_ref_scratch : (CY_AFE_DATA_T *)context->scratch_arena.buffer;
+    for (channel = 0; channel < context->aec_ref_channels; channel++)
+    {
+        afe_format_to_s16(context, first + (channel * channel_stride * context->input_sample_size), sample_stride,
+                scratch + (channel * context->frame_samples), count);
+    }
+    afe_dsp_downmix_s16(scratch, context->aec_ref_channels, context->frame_samples, 1,
+            context->aec_ref_weights, output, count);
+}
+
+void afe_format_output(afe_internal_context_t *context, const CY_AFE_DATA_T *input, void *output, uint32_t count)
+{
+    switch (context->config_init.output_format.sample_format)
+    {
+        case CY_AFE_SAMPLE_FORMAT_S32:
+            afe_dsp_s16_to_s32(input, 16, (int32_t *)output, count);
+            break;
+        case CY_AFE_SAMPLE_FORMAT_S24_IN_32:
+            afe_dsp_s16_to_s32(input, 8, (int32_t *)output, count);
+            break;
+        case CY_AFE_SAMPLE_FORMAT_F32:
+            afe_dsp_s16_to_f32(input, (float *)output, count);
+            break;
+        default:
+            afe_dsp_copy(output, input, count * sizeof(CY_AFE_DATA_T));
+            break;
+    }
+}
@@ -0,0 +1,397 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_audio_memory.c
+ * @brief Per-instance memory allocation helpers. All AFE internal allocations are routed
+ *        through the allocator callbacks of the instance which owns the memory, or carved
+ *        from the application provided memory of instances created with cy_afe_create_static.
+ *
+ */
+
+#include "cy_afe_audio_internal.h"
+#include "cy_afe_audio_memory.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static afe_memory_arena_t *afe_memory_static_get_arena(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id)
+{
+    if(mem_id < CY_AFE_MEM_ID_MAX && NULL != static_memory->regions[mem_id].base)
+    {
+        return &static_memory->regions[mem_id];
+    }
+
+    return &static_memory->arena;
+}
+
+/* Memory IDs requested by the speech enhancement library only, so their regions are emptied by library deinit */
+static bool afe_memory_is_library_id(cy_afe_mem_id_t mem_id)
+{
+    switch(mem_id)
+    {
+        case CY_AFE_MEM_ID_ALGORITHM_PERSISTENT_MEMORY:
+        case CY_AFE_MEM_ID_ALGORITHM_SCRATCH_MEMORY:
+        case CY_AFE_MEM_ID_ALGORITHM_BF_MEMORY:
+        case CY_AFE_MEM_ID_ALGORITHM_NS_MEMORY:
+        case CY_AFE_MEM_ID_ALGORITHM_ES_MEMORY:
+        case CY_AFE_MEM_ID_GDE_PERSISTENT_MEM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Library memory goes to a region of its own, or to the library reservation once it is made.
+ * Library memory of IDs shared with AFE (context, generic memory) is never placed with AFE memory.
+ */
+static afe_memory_arena_t *afe_memory_static_get_library_arena(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id)
+{
+    if(afe_memory_is_library_id(mem_id) && NULL != static_memory->regions[mem_id].base)
+    {
+        return &static_memory->regions[mem_id];
+    }
+
+    if(NULL != static_memory->library.base)
+    {
+        return &static_memory->library;
+    }
+
+    return &static_memory->arena;
+}
+
+static void *afe_memory_arena_alloc(afe_memory_arena_t *arena, uint32_t size)
+{
+    uint32_t aligned_size = AFE_MEMORY_ALIGN(size);
+    uint8_t *buffer = NULL;
+
+    if(aligned_size < size || aligned_size > (arena->size - arena->used))
+    {
+        return NULL;
+    }
+
+    buffer = arena->base + arena->used;
+    arena->last = arena->used;
+    arena->used += aligned_size;
+    arena->blocks++;
+    memset(buffer, 0, aligned_size);
+
+    return buffer;
+}
+
+static void afe_memory_arena_free(afe_memory_arena_t *arena, void *buffer)
+{
+    if(NULL == arena->base || 0 == arena->blocks)
+    {
+        return;
+    }
+
+    /* The latest allocation is returned to the arena right away, other memory once
+     * every allocation of the arena is freed or when the instance is deleted */
+    arena->blocks--;
+    if(0 == arena->blocks)
+    {
+        arena->used = 0;
+        arena->last = 0;
+    }
+    else if((uint8_t *)buffer == arena->base + arena->last && arena->last < arena->used)
+    {
+        arena->used = arena->last;
+    }
+}
+
+/* Record an allocation (size > 0) or forget it when it is freed (size 0), returning its size */
+static uint32_t afe_memory_track(afe_internal_context_t *context, void *buffer, uint32_t size)
+{
+    uint32_t index = 0;
+    uint32_t tracked_size = 0;
+    void *match = (0 == size) ? buffer : NULL;
+
+    for(index = 0; index < AFE_MEMORY_MAX_BLOCKS; index++)
+    {
+        if(match == context->memory_blocks[index].buffer)
+        {
+            tracked_size = context->memory_blocks[index].size;
+            context->memory_blocks[index].buffer = (0 == size) ? NULL : buffer;
+            context->memory_blocks[index].size = size;
+            return (0 == size) ? tracked_size : size;
+        }
+    }
+
+    if(0 != size)
+    {
+        cy_afe_log_info("Memory not tracked, increase AFE_MEMORY_MAX_BLOCKS. size:[%"PRIu32"]", size);
+    }
+
+    return 0;
+}
+
+static cy_rslt_t afe_memory_alloc_from(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size,
+        void **buffer, bool library)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if(NULL == context || NULL == buffer)
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. context:[%p], buffer:[%p]", context, buffer);
+        return result;
+    }
+
+    *buffer = NULL;
+
+    if(true == context->static_memory.enabled)
+    {
+        *buffer = afe_memory_arena_alloc(library ? afe_memory_static_get_library_arena(&context->static_memory, mem_id) :
+                afe_memory_static_get_arena(&context->static_memory, mem_id), size);
+    }
+    else if(NULL != context->config_init.alloc_memory)
+    {
+        context->config_init.alloc_memory(mem_id, size, buffer);
+        if(NULL != *buffer)
+        {
+            memset(*buffer, 0, size);
+        }
+    }
+    else
+    {
+        *buffer = calloc(1, size);
+    }
+
+    if(NULL == *buffer)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        cy_afe_log_err(result, "Out of memory. mem_id:[%d], size:[%"PRIu32"]", mem_id, size);
+        return result;
+    }
+
+    if(mem_id < CY_AFE_MEM_ID_MAX)
+    {
+        context->memory_usage[mem_id] += afe_memory_track(context, *buffer, size);
+    }
+    afe_memory_require(context, mem_id, size);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static void afe_memory_free_from(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer, bool library)
+{
+    uint32_t size = 0;
+
+    if(NULL == context || NULL == buffer)
+    {
+        return;
+    }
+
+    /* Done before the memory is freed, as the context itself is freed last */
+    if(mem_id < CY_AFE_MEM_ID_MAX)
+    {
+        size = afe_memory_track(context, buffer, 0);
+        context->memory_usage[mem_id] -= (size < context->memory_usage[mem_id]) ? size : context->memory_usage[mem_id];
+    }
+
+    if(true == context->static_memory.enabled)
+    {
+        afe_memory_arena_free(library ? afe_memory_static_get_library_arena(&context->static_memory, mem_id) :
+                afe_memory_static_get_arena(&context->static_memory, mem_id), buffer);
+    }
+    else if(NULL != context->config_init.free_memory)
+    {
+        context->config_init.free_memory(mem_id, buffer);
+    }
+    else
+    {
+        free(buffer);
+    }
+}
+
+static cy_rslt_t afe_memory_arena_init(afe_memory_arena_t *arena, const cy_afe_memory_region_t *region)
+{
+    memset(arena, 0, sizeof(afe_memory_arena_t));
+
+    if(NULL == region->buffer)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if(0 != ((uintptr_t)region->buffer % CY_AFE_MEMORY_ALIGNMENT))
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Memory region not aligned. buffer:[%p]", region->buffer);
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    arena->base = (uint8_t *)region->buffer;
+    arena->size = region->size;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+cy_rslt_t afe_memory_static_init(afe_memory_static_t *static_memory, const cy_afe_static_memory_t *memory)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t mem_id = 0;
+
+    result = afe_memory_arena_init(&static_memory->arena, &memory->arena);
+    for(mem_id = 0; mem_id < CY_AFE_MEM_ID_MAX && CY_RSLT_SUCCESS == result; mem_id++)
+    {
+        result = afe_memory_arena_init(&static_memory->regions[mem_id], &memory->regions[mem_id]);
+    }
+
+    static_memory->enabled = (CY_RSLT_SUCCESS == result);
+
+    return result;
+}
+
+void *afe_memory_static_alloc(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id, uint32_t size)
+{
+    return afe_memory_arena_alloc(afe_memory_static_get_arena(static_memory, mem_id), size);
+}
+
+void afe_memory_static_free(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id, void *buffer)
+{
+    afe_memory_arena_free(afe_memory_static_get_arena(static_memory, mem_id), buffer);
+}
+
+cy_rslt_t afe_memory_alloc(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size, void **buffer)
+{
+    return afe_memory_alloc_from(context, mem_id, size, buffer, false);
+}
+
+cy_rslt_t afe_memory_alloc_library(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size, void **buffer)
+{
+    return afe_memory_alloc_from(context, mem_id, size, buffer, true);
+}
+
+void afe_memory_library_begin(afe_internal_context_t *context)
+{
+    if(false == context->static_memory.enabled)
+    {
+        return;
+    }
+
+    context->static_memory.library_mark = context->static_memory.arena.used;
+    context->static_memory.library_mark_blocks = context->static_memory.arena.blocks;
+}
+
+void afe_memory_library_end(afe_internal_context_t *context)
+{
+    afe_memory_static_t *static_memory = &context->static_memory;
+    afe_memory_arena_t *arena = &static_memory->arena;
+    afe_memory_arena_t *library = &static_memory->library;
+
+    if(false == static_memory->enabled || NULL == arena->base)
+    {
+        return;
+    }
+
+    /* Library memory carved since afe_memory_library_begin becomes a region of its own */
+    library->base = arena->base + static_memory->library_mark;
+    library->size = arena->used - static_memory->library_mark;
+    library->used = library->size;
+    library->last = (arena->last >= static_memory->library_mark) ? arena->last - static_memory->library_mark : 0;
+    library->blocks = arena->blocks - static_memory->library_mark_blocks;
+
+    /* Later arena allocations follow the reservation and never reclaim it */
+    arena->blocks = static_memory->library_mark_blocks;
+    arena->last = arena->used;
+}
+
+void afe_memory_library_reset(afe_internal_context_t *context)
+{
+    afe_memory_static_t *static_memory = &context->static_memory;
+    uint32_t mem_id = 0;
+
+    if(false == static_memory->enabled)
+    {
+        return;
+    }
+
+    static_memory->library.used = 0;
+    static_memory->library.last = 0;
+    static_memory->library.blocks = 0;
+
+    for(mem_id = 0; mem_id < CY_AFE_MEM_ID_MAX; mem_id++)
+    {
+        if(afe_memory_is_library_id((cy_afe_mem_id_t)mem_id))
+        {
+            static_memory->regions[mem_id].used = 0;
+            static_memory->regions[mem_id].last = 0;
+            static_memory->regions[mem_id].blocks = 0;
+        }
+    }
+}
+
+void afe_memory_require(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size)
+{
+    if(mem_id < CY_AFE_MEM_ID_MAX)
+    {
+        context->memory_required[mem_id] += AFE_MEMORY_ALIGN(size);
+    }
+}
+
+void afe_memory_free(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer)
+{
+    afe_memory_free_from(context, mem_id, buffer, false);
+}
+
+void afe_memory_free_library(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer)
+{
+    afe_memory_free_from(context, mem_id, buffer, true);
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_pool.c
+ * @brief Reference counted output frame pool. Only the processing context takes a free
+ *        frame, so acquire needs no compare and swap; releases only decrement non-zero
+ *        counts. The RTOS semaphore is touched only when the acquirer is waiting.
+ *
+ */
+
+#include "cy_afe_audio_pool.h"
+#include "cy_audio_front_end_error.h"
+#include "cyabs_rtos_internal.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static bool afe_pool_try_acquire(afe_pool_t *pool, void **frame)
+{
+    uint32_t i = 0;
+    uint32_t index = 0;
+
+    for (i = 0; i < pool->count; i++)
+    {
+        index = (pool->next_index + i) % pool->count;
+        if (0 == atomic_load_explicit(&pool->ref_count[index], memory_order_acquire))
+        {
+            atomic_store_explicit(&pool->ref_count[index], 1, memory_order_relaxed);
+            pool->next_index = (index + 1) % pool->count;
+            *frame = pool->frames + (index * pool->frame_size);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static inline uint32_t afe_pool_ref_area_size(uint32_t count)
+{
+    /* Keep the frames 16 byte aligned for vector loads and stores */
+    return ((count * sizeof(atomic_uint_fast32_t)) + 15) & ~15u;
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+uint32_t afe_pool_buffer_size(uint32_t frame_size, uint32_t count)
+{
+    return afe_pool_ref_area_size(count) + (frame_size * count);
+}
+
+cy_rslt_t afe_pool_init(afe_pool_t *pool, void *buffer, uint32_t frame_size, uint32_t count)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t i = 0;
+
+    if (NULL == pool || NULL == buffer || 0 == frame_size || 0 == count)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    memset(pool, 0, sizeof(afe_pool_t));
+
+    result = cy_rtos_init_semaphore(&pool->free_semaphore, 1, 0);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    pool->ref_count = (atomic_uint_fast32_t *)buffer;
+    pool->frames = (uint8_t *)buffer + afe_pool_ref_area_size(count);
+    pool->frame_size = frame_size;
+    pool->count = count;
+    for (i = 0; i < count; i++)
+    {
+        atomic_init(&pool->ref_count[i], 0);
+    }
+    atomic_init(&pool->acquirer_waiting, false);
+    pool->initialized = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void afe_pool_deinit(afe_pool_t *pool)
+{
+    if (NULL == pool || false == pool->initialized)
+    {
+        return;
+    }
+
+    cy_rtos_deinit_semaphore(&pool->free_semaphore);
+    pool->initialized = false;
+    pool->frames = NULL;
+    pool->ref_count = NULL;
+}
+
+cy_rslt_t afe_pool_acquire(afe_pool_t *pool, cy_time_t timeout_ms, void **frame)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    while (false == afe_pool_try_acquire(pool, frame))
+    {
+        if (0 == timeout_ms)
+        {
+            return CY_RTOS_TIMEOUT;
+        }
+
+        atomic_store_explicit(&pool->acquirer_waiting, true, memory_order_relaxed);
+        /* Pairs with the fence in afe_pool_release */
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (afe_pool_try_acquire(pool, frame))
+        {
+            atomic_store_explicit(&pool->acquirer_waiting, false, memory_order_relaxed);
+            break;
+        }
+
+        result = cy_rtos_get_semaphore(&pool->free_semaphore, timeout_ms, false);
+        atomic_store_explicit(&pool->acquirer_waiting, false, memory_order_relaxed);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return afe_pool_try_acquire(pool, frame) ? CY_RSLT_SUCCESS : CY_RTOS_TIMEOUT;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t afe_pool_release(afe_pool_t *pool, void *frame)
+{
+    uint32_t index = 0;
+    uint_fast32_t ref_count = 0;
+
+    if (false == afe_pool_owns(pool, frame))
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    index = (uint32_t)((uint8_t *)frame - pool->frames) / pool->frame_size;
+
+    ref_count = atomic_load_explicit(&pool->ref_count[index], memory_order_relaxed);
+    do
+    {
+        if (0 == ref_count)
+        {
+            return CY_RSLT_AFE_BAD_ARG;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&pool->ref_count[index], &ref_count, ref_count - 1,
+            memory_order_acq_rel, memory_order_relaxed));
+
+    if (1 == ref_count)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load_explicit(&pool->acquirer_waiting, memory_order_relaxed))
+        {
+            cy_rtos_set_semaphore(&pool->free_semaphore, is_in_isr());
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t afe_pool_hold(afe_pool_t *pool, void *frame)
+{
+    uint32_t index = 0;
+    uint_fast32_t ref_count = 0;
+
+    if (false == afe_pool_owns(pool, frame))
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    index = (uint32_t)((uint8_t *)frame - pool->frames) / pool->frame_size;
+
+    /* A free frame can be taken only by acquire */
+    ref_count = atomic_load_explicit(&pool->ref_count[index], memory_order_relaxed);
+    do
+    {
+        if (0 == ref_count)
+        {
+            return CY_RSLT_AFE_BAD_ARG;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&pool->ref_count[index], &ref_count, ref_count + 1,
+            memory_order_relaxed, memory_order_relaxed));
+
+    return CY_RSLT_SUCCESS;
+}
+
+uint32_t afe_pool_free_count(afe_pool_t *pool)
+{
+    uint32_t i = 0;
+    uint32_t count = 0;
+
+    for (i = 0; i < pool->count; i++)
+    {
+        if (0 == atomic_load_explicit(&pool->ref_count[i], memory_order_relaxed))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool afe_pool_owns(afe_pool_t *pool, const void *frame)
+{
+    const uint8_t *ptr = (const uint8_t *)frame;
+
+    if (NULL == pool || false == pool->initialized || NULL == ptr)
+    {
+        return false;
+    }
+
+    if (ptr < pool->frames || ptr >= pool->frames + (pool->count * pool->frame_size))
+    {
+        return false;
+    }
+
+    return (0 == ((uint32_t)(ptr - pool->frames) % pool->frame_size));
+}
@@ -41,6 +41,10 @@
 #include "cy_audio_front_end.h"
 #include "cy_afe_audio_internal.h"
 #include "cy_afe_audio_speech_enh.h"
+#include "cy_afe_audio_dispatch.h"
+#include "cy_afe_audio_task.h"
+#include "cy_afe_audio_memory.h"
+#include "cy_afe_audio_format.h"
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 #include "cy_afe_audio_bd_calc.h"
 #endif
@@ -56,6 +60,9 @@
 /******************************************************
  *                     Macros
  ******************************************************/
+#ifndef AFE_RESAMPLE_FILTER_TAPS
+#define AFE_RESAMPLE_FILTER_TAPS                         (48)
+#endif
 
 /******************************************************
  *                    Constants
@@ -80,11 +87,14 @@
 /******************************************************
  *               Static Functions
  ******************************************************/
-static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_enh_input_output_t* sp_enh_output, bool before_afe_proc);
+static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_enh_input_output_t* sp_enh_output,
+        afe_sp_enh_input_output_t* app_output, bool before_afe_proc, cy_afe_buffer_info_t *output_info);
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-static cy_rslt_t afe_fill_debug_output_buf(int channel_no, afe_sp_enh_input_output_t *input_output_buf_ptr,
+static cy_rslt_t afe_fill_debug_output_buf(afe_internal_context_t *context, int channel_no, afe_sp_enh_input_output_t *input_output_buf_ptr,
                                             int16_t *dbg_output, bool before_afe_proc);
 #endif
+static void afe_decimate_input(afe_internal_context_t *context, afe_sp_enh_input_output_t *in_out);
+static uint32_t afe_get_resampler_buffer_size(afe_internal_context_t *context);
 void afe_free_debug_output_buf(cy_afe_buffer_info_t* buffer);
 /******************************************************
  *               Functions
@@ -105,10 +115,9 @@ void fill_10ms_data(uint16_t* buffer)
 }
 #endif
 
-extern uint32_t ifx_out_locator[];
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-static cy_rslt_t afe_fill_debug_output_buf(int channel_no, afe_sp_enh_input_output_t *input_output_buf_ptr,
+static cy_rslt_t afe_fill_debug_output_buf(afe_internal_context_t *context, int channel_no, afe_sp_enh_input_output_t *input_output_buf_ptr,
                                             int16_t *dbg_output, bool before_afe_proc)
 {
     /* Copy required input buffer before AFE process */
@@ -123,40 +132,40 @@ static cy_rslt_t afe_fill_debug_output_buf(int channel_no, afe_sp_enh_input_outp
                 */
                 if(NULL == input_output_buf_ptr->aec_reference_input)
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
                 else
                 {
-                    memcpy((char*)dbg_output, (char*)input_output_buf_ptr->aec_reference_input, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memcpy((char*)dbg_output, (char*)input_output_buf_ptr->aec_reference_input, context->core_frame_size);
                 }
             }
             break;
             case AFE_USB_SELECT_INPUT_0:
             {
                 /*
-                * Copy first 320 bytes from input buffer
+                * Copy first channel from input buffer
                 */
                 if(NULL == input_output_buf_ptr->input1)
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
                 else
                 {
-                    memcpy((char*)dbg_output, (char*)input_output_buf_ptr->input1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memcpy((char*)dbg_output, (char*)input_output_buf_ptr->input1, context->core_frame_size);
                 }
             }
             break;
             case AFE_USB_SELECT_INPUT_1:
             {
                 /*
-                * Copy next 320 bytes from input buffer for stereo data
+                * Copy second channel from input buffer for stereo data
                 */
                 if(NULL ==  input_output_buf_ptr->input2)
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 } else
                 {
-                    memcpy((char*)dbg_output,(char*) input_output_buf_ptr->input2, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memcpy((char*)dbg_output,(char*) input_output_buf_ptr->input2, context->core_frame_size);
                 }
             }
             break;
@@ -175,62 +184,62 @@ static cy_rslt_t afe_fill_debug_output_buf(int channel_no, afe_sp_enh_input_outp
                 /*
                 * AFE output is always mono.
                 */
-                memcpy((char*)dbg_output, (char*)input_output_buf_ptr->output, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                memcpy((char*)dbg_output, (char*)input_output_buf_ptr->output, context->core_frame_size);
             }
             break;
             case AFE_USB_SELECT_SIG_A_0:
             {
                 //AEC Output channel 0
-                if(-1 != ifx_out_locator[AFE_USB_SELECT_SIG_A_0])
+                if(-1 != context->ifx_out_locator[AFE_USB_SELECT_SIG_A_0])
                 {
-                    char *ifx_temp_copy = (char*)((char*)input_output_buf_ptr->ifx_internal_output + (ifx_out_locator[AFE_USB_SELECT_SIG_A_0] * CY_AFE_MONO_FRAME_SIZE_IN_BYTES));
-                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    char *ifx_temp_copy = (char*)((char*)input_output_buf_ptr->ifx_internal_output + (context->ifx_out_locator[AFE_USB_SELECT_SIG_A_0] * context->core_frame_size));
+                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, context->core_frame_size);
                 }
                 else
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
             }
             break;
             case AFE_USB_SELECT_SIG_A_1:
             {
                 //AEC output channel 1
-                if(-1 != ifx_out_locator[AFE_USB_SELECT_SIG_A_1])
+                if(-1 != context->ifx_out_locator[AFE_USB_SELECT_SIG_A_1])
                 {
-                    char *ifx_temp_copy = (char*)((char*)input_output_buf_ptr->ifx_internal_output + (ifx_out_locator[AFE_USB_SELECT_SIG_A_1] * CY_AFE_MONO_FRAME_SIZE_IN_BYTES));
-                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    char *ifx_temp_copy = (char*)((char*)input_output_buf_ptr->ifx_internal_output + (context->ifx_out_locator[AFE_USB_SELECT_SIG_A_1] * context->core_frame_size));
+                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, context->core_frame_size);
                 }
                 else
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
             }
             break;
             case AFE_USB_SELECT_SIG_B:
             {
                 //Beam forming output
-                if(-1 != ifx_out_locator[AFE_USB_SELECT_SIG_B])
+                if(-1 != context->ifx_out_locator[AFE_USB_SELECT_SIG_B])
                 {
-                    char *ifx_temp_copy = (char*)((char *)input_output_buf_ptr->ifx_internal_output + (ifx_out_locator[AFE_USB_SELECT_SIG_B] * CY_AFE_MONO_FRAME_SIZE_IN_BYTES));
-                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    char *ifx_temp_copy = (char*)((char *)input_output_buf_ptr->ifx_internal_output + (context->ifx_out_locator[AFE_USB_SELECT_SIG_B] * context->core_frame_size));
+                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, context->core_frame_size);
                 }
                 else
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
             }
             break;
             case AFE_USB_SELECT_SIG_C:
             {
                 //De-reverberation output
-                if(-1 != ifx_out_locator[AFE_USB_SELECT_SIG_C])
+                if(-1 != context->ifx_out_locator[AFE_USB_SELECT_SIG_C])
                 {
-                    char *ifx_temp_copy = (char *)((char *)input_output_buf_ptr->ifx_internal_output + (ifx_out_locator[AFE_USB_SELECT_SIG_C] * CY_AFE_MONO_FRAME_SIZE_IN_BYTES));
-                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    char *ifx_temp_copy = (char *)((char *)input_output_buf_ptr->ifx_internal_output + (context->ifx_out_locator[AFE_USB_SELECT_SIG_C] * context->core_frame_size));
+                    memcpy((char*)dbg_output, (char*)ifx_temp_copy, context->core_frame_size);
                 }
                 else
                 {
-                    memset((char*)dbg_output,0,CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+                    memset((char*)dbg_output,0,context->core_frame_size);
                 }
             }
             break;
@@ -244,22 +253,64 @@ static cy_rslt_t afe_fill_debug_output_buf(int channel_no, afe_sp_enh_input_outp
 #endif
 
 /**
- * Send the AFE output data to application based on configuration
+ * Decimate microphones and AEC reference of a frame into the core rate frames, and point the
+ * speech enhancement buffers to them. Every stream is decimated at the same frame boundary with
+ * the same filter, keeping them phase aligned.
  */
-static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_enh_input_output_t* sp_enh_output, bool before_afe_proc)
+static void afe_decimate_input(afe_internal_context_t *context, afe_sp_enh_input_output_t *in_out)
+{
+    CY_AFE_DATA_T *core_frames = context->resample_frames;
+
+    /* Core frames: channel-1, channel-2, AEC reference, output */
+    afe_resample_decimate(&context->resampler, 0, in_out->input1, core_frames);
+    in_out->input1 = core_frames;
+
+    if (NULL != in_out->input2)
+    {
+        afe_resample_decimate(&context->resampler, 1, in_out->input2, core_frames + context->core_frame_samples);
+        in_out->input2 = core_frames + context->core_frame_samples;
+    }
+
+    if (NULL != in_out->aec_reference_input)
+    {
+        afe_resample_decimate(&context->resampler, context->num_channels, in_out->aec_reference_input,
+                core_frames + (2 * context->core_frame_samples));
+        in_out->aec_reference_input = core_frames + (2 * context->core_frame_samples);
+    }
+    else
+    {
+        afe_resample_reset_stream(&context->resampler, context->num_channels);
+    }
+
+    in_out->output = core_frames + (3 * context->core_frame_samples);
+}
+
+/**
+ * Send the AFE output data to application based on configuration. Debug outputs are taken from the
+ * speech enhancement buffers, input and output from the application rate buffers.
+ */
+static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_enh_input_output_t* sp_enh_output,
+        afe_sp_enh_input_output_t* app_output, bool before_afe_proc, cy_afe_buffer_info_t *output_info)
 {
     cy_afe_buffer_info_t afe_output_info;
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
     memset(&afe_output_info, 0, sizeof(cy_afe_buffer_info_t));
 
-    afe_output_info.input_buf = sp_enh_output->input1;
-    afe_output_info.input_aec_ref_buf = sp_enh_output->aec_reference_input;
-    afe_output_info.output_buf = sp_enh_output->output;
+    /* Copied input frames are returned to input pool by AFE, application buffers are already reused.
+     * Frames of the input ring are not owned by application either.
+     */
+    if (CY_AFE_INPUT_MODE_COPY != context->config_init.input_mode &&
+        NULL == context->config_init.input_ring.input_buffer)
+    {
+        afe_output_info.input_buf = app_output->input1;
+        afe_output_info.input_aec_ref_buf = app_output->aec_reference_input;
+    }
+    afe_output_info.output_buf = app_output->output;
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
     /* Fill debug output based on configuration for channel1 */
-    result = afe_fill_debug_output_buf(MY_AFE_USB_SETTINGS.channel_0, sp_enh_output, context->dbg_output1, before_afe_proc);
+    result = afe_fill_debug_output_buf(context, context->usb_settings.channel_0, sp_enh_output, context->dbg_output1, before_afe_proc);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to fill debug output for channel1");
@@ -269,7 +320,7 @@ static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_en
     afe_output_info.dbg_output1 = context->dbg_output1;
 
     /* Fill debug output based on configuration for channel2 */
-    result = afe_fill_debug_output_buf(MY_AFE_USB_SETTINGS.channel_1, sp_enh_output, context->dbg_output2, before_afe_proc);
+    result = afe_fill_debug_output_buf(context, context->usb_settings.channel_1, sp_enh_output, context->dbg_output2, before_afe_proc);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to fill debug output for channel2");
@@ -279,7 +330,7 @@ static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_en
     afe_output_info.dbg_output2 = context->dbg_output2;
 
     /* Fill debug output based on configuration for channel3 */
-    result = afe_fill_debug_output_buf(MY_AFE_USB_SETTINGS.channel_2, sp_enh_output, context->dbg_output3, before_afe_proc);
+    result = afe_fill_debug_output_buf(context, context->usb_settings.channel_2, sp_enh_output, context->dbg_output3, before_afe_proc);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to fill debug output for channel3");
@@ -289,7 +340,7 @@ static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_en
     afe_output_info.dbg_output3 = context->dbg_output3;
 
     /* Fill debug output based on configuration for channel4 */
-    result = afe_fill_debug_output_buf(MY_AFE_USB_SETTINGS.channel_3, sp_enh_output, context->dbg_output4, before_afe_proc);
+    result = afe_fill_debug_output_buf(context, context->usb_settings.channel_3, sp_enh_output, context->dbg_output4, before_afe_proc);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to fill debug output for channel4");
@@ -308,41 +359,48 @@ static cy_rslt_t afe_send_output_data(afe_internal_context_t *context, afe_sp_en
     if( false == before_afe_proc )
     {
         /*
-        * Invoke application registered AFE output callback
+        * Invoke application registered AFE output callback, inline or through output dispatch task
         */
-        result = context->config_init.afe_output_callback((void*) context, &afe_output_info,
-                context->config_init.user_arg_callbacks);
+        result = afe_dispatch_output(context, &afe_output_info);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Output queue is full, output dropped");
+            return result;
+        }
+
+        /* Return output to the caller of cy_afe_process */
+        if(NULL != output_info)
+        {
+            *output_info = afe_output_info;
+        }
 
     #ifdef ENABLE_AFE_MW_CHECK_POINT
         AFE_MW_CHECK_POINT()
     #endif
-
-        if(CY_RSLT_SUCCESS != result)
-        {
-            /* Avoid error from application & continue processing next set of audio frames */
-            cy_afe_log_err(result, "AFE output callback returned error");
-        }
     }
 
     return CY_RSLT_SUCCESS;
 }
 
 /**
- * Process audio data and apply speech enhancement
+ * Process audio data and apply speech enhancement, with process_mutex held
  */
-cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data_item_t *queue_item)
+static cy_rslt_t afe_process_frame(afe_internal_context_t *context, afe_queue_data_item_t *queue_item,
+        cy_afe_buffer_info_t *output_info)
 {
-    cy_afe_buffer_info_t output_info;
     CY_AFE_DATA_T *input_buffer = NULL;
+    CY_AFE_DATA_T *input_frame = NULL;
     CY_AFE_DATA_T *output_buffer = NULL;
+    CY_AFE_DATA_T *output_frame = NULL;
 #ifdef ENABLE_IFX_AEC
     CY_AFE_DATA_T *aec_ref_buffer = NULL;
 #endif
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_rslt_t send_result = CY_RSLT_SUCCESS;
     afe_sp_enh_input_output_t sp_enh_in_out;
-    size_t no_of_items_in_queue = 0;
+    afe_sp_enh_input_output_t app_in_out;
+    uint32_t frames_dropped = 0;
 
-    memset(&output_info, 0, sizeof(output_info));
     memset(&sp_enh_in_out, 0, sizeof(sp_enh_in_out));
 
     /* Audio input data pointer */
@@ -352,12 +410,15 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
     aec_ref_buffer = queue_item->aec_ref_ptr;
 #endif
 
-    if(context->afe_frame_queue_push_fail_cnt > 0)
+    /* Report only when new frames were dropped since the last report */
+    frames_dropped = context->overload_stats.frames_dropped_newest + context->overload_stats.frames_dropped_oldest;
+    if(frames_dropped != context->overload_drops_reported)
     {
-        no_of_items_in_queue = cy_rtos_queue_count(&context->audio_processing_queue, &no_of_items_in_queue);
         cy_afe_log_info(
-                "Failed to push audio data pointer to queue from cy_afe_feed API. no_of_items_queue :[%d], failed_to_push_cnt : [%d]",
-                no_of_items_in_queue, context->afe_frame_queue_push_fail_cnt);
+                "Input queue overloaded. no_of_items_queue :[%"PRIu32"], dropped_newest : [%"PRIu32"], dropped_oldest : [%"PRIu32"]",
+                afe_get_pending_input_frames(context), context->overload_stats.frames_dropped_newest,
+                context->overload_stats.frames_dropped_oldest);
+        context->overload_drops_reported = frames_dropped;
     }
 
 #ifdef CY_AFE_ENABLE_HEXDUMP
@@ -396,34 +457,89 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
     if(CY_RSLT_SUCCESS != result || output_buffer == NULL)
     {
         cy_afe_log_err(result, "Failed to get the AFE output buffer from application");
-        return CY_RSLT_AFE_GENERIC_ERROR;
+        /* All internal output buffers are held, the frame is dropped */
+        return (CY_RSLT_AFE_QUEUE_FULL == result) ? CY_RSLT_AFE_QUEUE_FULL : CY_RSLT_AFE_GENERIC_ERROR;
     }
     else
     {
+        /* Frames used in place are converted from the application layout and sample format first */
+        input_frame = input_buffer;
+        if (true == queue_item->app_format)
+        {
+            if (true == context->input_convert)
+            {
+                afe_format_input(context, input_buffer, context->frame_samples, 0, context->input_convert_frame, 0,
+                        context->frame_samples);
+                input_frame = context->input_convert_frame;
+            }
+
+#ifdef ENABLE_IFX_AEC
+            if (NULL != aec_ref_buffer && true == context->aec_ref_convert)
+            {
+                afe_format_aec_ref(context, aec_ref_buffer, context->frame_samples, 0,
+                        context->input_convert_frame + (context->num_channels * context->frame_samples), context->frame_samples);
+                sp_enh_in_out.aec_reference_input = context->input_convert_frame + (context->num_channels * context->frame_samples);
+            }
+#endif
+        }
+
         /* replace sample with channel */
-        if (CY_AFE_INPUT_NUM_OF_CHANNELS == CY_AFE_AUDIO_MONO_CHANNEL)
+        if (CY_AFE_AUDIO_MONO_CHANNEL == context->num_channels)
         {
-            sp_enh_in_out.input1 = (CY_AFE_DATA_T*) input_buffer;
+            sp_enh_in_out.input1 = input_frame;
             sp_enh_in_out.input2 = NULL;
         }
-        else if (CY_AFE_INPUT_NUM_OF_CHANNELS == CY_AFE_AUDIO_STEREO_CHANNEL)
+        else if (CY_AFE_AUDIO_STEREO_CHANNEL == context->num_channels)
         {
-            sp_enh_in_out.input1 = input_buffer;
-            sp_enh_in_out.input2 = (CY_AFE_DATA_T*) ((char*)input_buffer + 320);
+            sp_enh_in_out.input1 = input_frame;
+            sp_enh_in_out.input2 = input_frame + context->frame_samples;
+
+            /* Frames read in place from the input ring have channel-2 in the channel-2 ring */
+            if (NULL != context->config_init.input_ring.input_buffer &&
+                input_buffer >= context->config_init.input_ring.input_buffer &&
+                input_buffer < context->config_init.input_ring.input_buffer + context->config_init.input_ring.size_in_samples)
+            {
+                sp_enh_in_out.input2 = input_buffer + context->config_init.input_ring.size_in_samples;
+            }
         }
 
         sp_enh_in_out.ifx_internal_output = (CY_AFE_DATA_T *)context->ifx_internal_output;
-        sp_enh_in_out.output = output_buffer;
+        /* Output other than 16 bit is converted to the application buffer after processing */
+        output_frame = (NULL != context->output_convert_frame) ? context->output_convert_frame : output_buffer;
+        sp_enh_in_out.output = output_frame;
+        sp_enh_in_out.audio_meter = context->audio_meter;
+        sp_enh_in_out.frame_size = context->core_frame_size;
+
+        /* Buffers of the application, returned along with the output */
+        app_in_out = sp_enh_in_out;
+        app_in_out.input1 = input_buffer;
+        app_in_out.output = output_buffer;
+#ifdef ENABLE_IFX_AEC
+        app_in_out.aec_reference_input = aec_ref_buffer;
+#endif
+
+        /* Speech enhancement runs on core rate copies of the frame, output is converted back after processing */
+        if (NULL != context->resample_buffer)
+        {
+            afe_decimate_input(context, &sp_enh_in_out);
+        }
 
 #ifdef CY_AFE_ENABLE_TIMESTAMP
         afe_update_timestamp(context, AFE_FRAME_FEED_SE_TIMESTAMP);
 #endif
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-        cy_rtos_mutex_get(&context->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-        afe_send_output_data(context, &sp_enh_in_out, true);
+        /* Tuner updates take effect at the frame boundary, the tuner never blocks processing */
+        afe_speech_enhancement_apply_params(context);
+        afe_send_output_data(context, &sp_enh_in_out, &app_in_out, true, NULL);
 #endif
 
+        /* Scratch memory lent to the application is taken back while the frame is processed */
+        if (true == context->scratch_mutex_initialized)
+        {
+            cy_rtos_mutex_get(&context->scratch_mutex, CY_RTOS_NEVER_TIMEOUT);
+        }
+
 #ifdef COMPONENT_PROFILER
         cy_afe_profile(AFE_PROFILE_CMD_START,NULL);
 #endif /* COMPONENT_PROFILER */
@@ -440,9 +556,9 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
         {
             result = cy_afe_bd_calc_process(context, &sp_enh_in_out);
 #ifdef DUMP_SAVE_BY_INDEX
-            cy_dump_save_by_index(0, sp_enh_in_out.input1, 320, 0);
-            cy_dump_save_by_index(1, sp_enh_in_out.aec_reference_input, 320, 0);
-            cy_dump_save_by_index(2, sp_enh_in_out.output, 320, 0);
+            cy_dump_save_by_index(0, sp_enh_in_out.input1, context->core_frame_size, 0);
+            cy_dump_save_by_index(1, sp_enh_in_out.aec_reference_input, context->core_frame_size, 0);
+            cy_dump_save_by_index(2, sp_enh_in_out.output, context->core_frame_size, 0);
 #endif /* DUMP_SAVE_BY_INDEX */
         }
 #endif
@@ -451,10 +567,25 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
         cy_afe_profile(AFE_PROFILE_CMD_STOP,NULL);
 #endif /* COMPONENT_PROFILER */
 
+        if (true == context->scratch_mutex_initialized)
+        {
+            cy_rtos_mutex_set(&context->scratch_mutex);
+        }
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-        cy_rtos_mutex_set(&context->audio_tuner_mutex);
+        afe_speech_enhancement_publish_meter(context);
 #endif
 
+        if (NULL != context->resample_buffer)
+        {
+            afe_resample_interpolate(&context->resampler, sp_enh_in_out.output, output_frame);
+        }
+
+        if (NULL != context->output_convert_frame)
+        {
+            afe_format_output(context, output_frame, output_buffer, context->frame_samples);
+        }
+
 #ifdef CY_AFE_ENABLE_TIMESTAMP
         afe_update_timestamp(context, AFE_FRAME_PROCESSED_TIMESTAMP);
 #endif
@@ -468,7 +599,7 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
 #endif
 
         /* Send afe output along with other information to application registered callback */
-        afe_send_output_data(context, &sp_enh_in_out, false);
+        send_result = afe_send_output_data(context, &sp_enh_in_out, &app_in_out, false, output_info);
 
         if (CY_RSLT_SUCCESS != result)
         {
@@ -476,6 +607,112 @@ cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data
             return CY_RSLT_AFE_SPEECH_ENHANCEMENT_ERROR;
         }
 
+        /* Output dropped on a full output queue is already counted, caller is told about it */
+        return send_result;
+    }
+}
+
+/**
+ * Process audio data and apply speech enhancement. Frames are processed one at a time, whichever
+ * context they come from, and never while the speech enhancement library is re-initialized.
+ */
+cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data_item_t *queue_item,
+        cy_afe_buffer_info_t *output_info)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    cy_rtos_mutex_get(&context->process_mutex, CY_RTOS_NEVER_TIMEOUT);
+    result = afe_process_frame(context, queue_item, output_info);
+    cy_rtos_mutex_set(&context->process_mutex);
+
+    return result;
+}
+
+/**
+ * Process audio data and apply speech enhancement, process_mutex is held by the caller
+ */
+cy_rslt_t afe_process_audio_data_locked(afe_internal_context_t *context, afe_queue_data_item_t *queue_item,
+        cy_afe_buffer_info_t *output_info)
+{
+    return afe_process_frame(context, queue_item, output_info);
+}
+
+/**
+ * Get the size of the resampler state, 0 if the rate is not supported
+ */
+static uint32_t afe_get_resampler_buffer_size(afe_internal_context_t *context)
+{
+    uint32_t buffer_size = 0;
+
+    /* Microphones and AEC reference are decimated */
+    buffer_size = afe_resample_get_buffer_size(context->sample_rate, AFE_RESAMPLE_FILTER_TAPS,
+            context->frame_samples, context->num_channels + 1);
+    if (0 == buffer_size)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Resampling from %"PRIu32" with %d taps is not supported",
+                context->sample_rate, AFE_RESAMPLE_FILTER_TAPS);
+    }
+
+    return buffer_size;
+}
+
+cy_rslt_t afe_require_resampler_memory(afe_internal_context_t *context)
+{
+    uint32_t buffer_size = 0;
+
+    if (context->sample_rate == context->core_sample_rate)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    buffer_size = afe_get_resampler_buffer_size(context);
+    if (0 == buffer_size)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_RESAMPLE_BUFFER, buffer_size + (4 * context->core_frame_size));
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t afe_setup_resampler(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t buffer_size = 0;
+
+    if (context->sample_rate == context->core_sample_rate)
+    {
         return CY_RSLT_SUCCESS;
     }
+
+    buffer_size = afe_get_resampler_buffer_size(context);
+    if (0 == buffer_size)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    cy_afe_log_dbg("Initializing resampler %"PRIu32" to %"PRIu32", %d taps",
+            context->sample_rate, context->core_sample_rate, AFE_RESAMPLE_FILTER_TAPS);
+
+    /* Followed by core rate frames of both channels, AEC reference and output */
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_RESAMPLE_BUFFER,
+            buffer_size + (4 * context->core_frame_size), &context->resample_buffer);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to allocate resampler buffer");
+        return result;
+    }
+
+    context->resample_frames = (CY_AFE_DATA_T *)((uint8_t *)context->resample_buffer + buffer_size);
+
+    return afe_resample_init(&context->resampler, context->sample_rate, AFE_RESAMPLE_FILTER_TAPS,
+            context->frame_samples, context->num_channels + 1, context->resample_buffer);
+}
+
+void afe_cleanup_resampler(afe_internal_context_t *context)
+{
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_RESAMPLE_BUFFER, context->resample_buffer);
+    context->resample_buffer = NULL;
+    context->resample_frames = NULL;
 }
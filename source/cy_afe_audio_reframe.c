@@ -0,0 +1,356 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_reframe.c
+ * @brief Input samples of any count are gathered straight into the internal frames which are
+ *        processed, and output frames are split into any number of samples for the application.
+ *
+ */
+
+#include "cy_audio_front_end.h"
+#include "cy_afe_audio_internal.h"
+#include "cy_afe_audio_reframe.h"
+#include "cy_afe_audio_task.h"
+#include "cy_afe_audio_dispatch.h"
+#include "cy_afe_audio_memory.h"
+#include "cy_afe_audio_dsp.h"
+#include "cy_afe_audio_format.h"
+#include "cyabs_rtos_internal.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static uint32_t afe_reframe_get_sync_frame_size(afe_internal_context_t *context);
+static cy_rslt_t afe_reframe_start_frame(afe_internal_context_t *context);
+static cy_rslt_t afe_reframe_submit_frame(afe_internal_context_t *context);
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+
+/**
+ * Size of the frame gathered by cy_afe_feed_samples in sync mode, input followed by AEC reference
+ */
+static uint32_t afe_reframe_get_sync_frame_size(afe_internal_context_t *context)
+{
+    if (CY_AFE_PROCESSING_MODE_SYNC != context->config_init.processing_mode)
+    {
+        return 0;
+    }
+
+    return context->input_frame_size + context->mono_frame_size;
+}
+
+/**
+ * Get the frame to gather the next input samples into. In sync mode the frame is processed before
+ * feed returns and the same frame is reused, else a frame of the input pool is handed over to the queue.
+ */
+static cy_rslt_t afe_reframe_start_frame(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (CY_AFE_PROCESSING_MODE_SYNC == context->config_init.processing_mode)
+    {
+        context->reframe_input_frame = context->reframe_sync_frame;
+        return CY_RSLT_SUCCESS;
+    }
+
+    /* Input pool frames are taken by one feed at a time */
+    result = afe_enter_producer(context, 0);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        context->reframe_input_frame = NULL;
+        return result;
+    }
+
+    result = afe_pool_acquire(&context->input_pool, 0, (void **)&context->reframe_input_frame);
+    afe_exit_producer(context);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        context->reframe_input_frame = NULL;
+        return CY_RSLT_AFE_QUEUE_FULL;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Feed the completed frame. Ownership of an input pool frame passes to the queue.
+ */
+static cy_rslt_t afe_reframe_submit_frame(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t *frame = context->reframe_input_frame;
+
+    context->reframe_input_frame = NULL;
+    context->reframe_input_samples = 0;
+
+    /* No frame was available to gather the samples, the frame is dropped */
+    if (NULL == frame)
+    {
+        afe_update_stats(context, AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT);
+        return CY_RSLT_AFE_QUEUE_FULL;
+    }
+
+    result = afe_feed_audio_data(context, (CY_AFE_DATA_T *)frame,
+            context->reframe_input_has_ref ? (CY_AFE_DATA_T *)(frame + context->input_frame_size) : NULL);
+
+    return result;
+}
+
+/**
+ * Gather input samples into frames and feed the completed frames
+ */
+cy_rslt_t afe_reframe_feed(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_samples)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_rslt_t frame_result = CY_RSLT_SUCCESS;
+    CY_AFE_DATA_T *frame = NULL;
+    uint32_t offset = 0;
+    uint32_t count = 0;
+
+    /* Gathered frames are queued without copy, so they must belong to the input pool */
+    if (CY_AFE_PROCESSING_MODE_SYNC != context->config_init.processing_mode && NULL == context->input_pool_buffer)
+    {
+        return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+    }
+
+    if (CY_AFE_PROCESSING_MODE_SYNC == context->config_init.processing_mode && is_in_isr())
+    {
+        return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+    }
+
+    /* Samples are gathered by one caller at a time, a concurrent call is rejected */
+    if (atomic_flag_test_and_set_explicit(&context->reframe_busy, memory_order_acquire))
+    {
+        cy_afe_log_err_on_no_isr(CY_RSLT_AFE_BUSY, "Samples are being fed by another caller");
+        return CY_RSLT_AFE_BUSY;
+    }
+
+    while (offset < num_samples)
+    {
+        if (0 == context->reframe_input_samples)
+        {
+            frame_result = afe_reframe_start_frame(context);
+            if (CY_RSLT_SUCCESS != frame_result && CY_RSLT_SUCCESS == result)
+            {
+                result = frame_result;
+            }
+            context->reframe_input_has_ref = (NULL != aec_ref_ptr);
+        }
+
+        count = context->frame_samples - context->reframe_input_samples;
+        if (count > (num_samples - offset))
+        {
+            count = num_samples - offset;
+        }
+
+        frame = (CY_AFE_DATA_T *)context->reframe_input_frame;
+        if (NULL != frame)
+        {
+            afe_format_input(context, input_audio_data_ptr, num_samples, offset, frame, context->reframe_input_samples, count);
+
+            if (context->reframe_input_has_ref)
+            {
+                frame = (CY_AFE_DATA_T *)(context->reframe_input_frame + context->input_frame_size);
+                if (NULL != aec_ref_ptr)
+                {
+                    afe_format_aec_ref(context, aec_ref_ptr, num_samples, offset, frame + context->reframe_input_samples, count);
+                }
+                else
+                {
+                    memset(frame + context->reframe_input_samples, 0, count * sizeof(CY_AFE_DATA_T));
+                }
+            }
+        }
+
+        context->reframe_input_samples += count;
+        offset += count;
+
+        if (context->frame_samples == context->reframe_input_samples)
+        {
+            /* Remaining samples are still gathered, so that next frames stay aligned */
+            frame_result = afe_reframe_submit_frame(context);
+            if (CY_RSLT_SUCCESS != frame_result && CY_RSLT_SUCCESS == result)
+            {
+                result = frame_result;
+            }
+        }
+    }
+
+    atomic_flag_clear_explicit(&context->reframe_busy, memory_order_release);
+
+    return result;
+}
+
+/**
+ * Read output samples, splitting frames across calls
+ */
+cy_rslt_t afe_reframe_read_output(afe_internal_context_t *context, CY_AFE_DATA_T *output, uint32_t num_samples,
+        uint32_t *samples_read, uint32_t timeout_ms)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_time_t start_time = 0;
+    cy_time_t now = 0;
+    uint32_t wait_ms = timeout_ms;
+    uint32_t read = 0;
+    uint32_t count = 0;
+
+    cy_rtos_get_time(&start_time);
+
+    while (read < num_samples)
+    {
+        if (NULL == context->reframe_output.output_buf)
+        {
+            if (CY_RTOS_NEVER_TIMEOUT != timeout_ms)
+            {
+                cy_rtos_get_time(&now);
+                wait_ms = ((uint32_t)(now - start_time) >= timeout_ms) ? 0 : timeout_ms - (uint32_t)(now - start_time);
+            }
+
+            result = afe_dispatch_read_output(context, &context->reframe_output, wait_ms);
+            if (CY_RSLT_SUCCESS != result)
+            {
+                memset(&context->reframe_output, 0, sizeof(context->reframe_output));
+                break;
+            }
+
+            /* Frames dropped by the overload policy carry no output */
+            context->reframe_output_samples = 0;
+            continue;
+        }
+
+        count = context->frame_samples - context->reframe_output_samples;
+        if (count > (num_samples - read))
+        {
+            count = num_samples - read;
+        }
+
+        afe_dsp_copy((uint8_t *)output + (read * context->output_sample_size),
+                (uint8_t *)context->reframe_output.output_buf + (context->reframe_output_samples * context->output_sample_size),
+                count * context->output_sample_size);
+        read += count;
+        context->reframe_output_samples += count;
+
+        if (context->frame_samples == context->reframe_output_samples)
+        {
+            afe_dispatch_release_output(context, &context->reframe_output);
+            memset(&context->reframe_output, 0, sizeof(context->reframe_output));
+        }
+    }
+
+    if (NULL != samples_read)
+    {
+        *samples_read = read;
+    }
+
+    return result;
+}
+
+void afe_require_reframe_memory(afe_internal_context_t *context)
+{
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, afe_reframe_get_sync_frame_size(context));
+}
+
+/**
+ * Allocate the frame gathered by cy_afe_feed_samples in sync mode. Other modes gather into
+ * frames of the input pool.
+ */
+cy_rslt_t afe_setup_reframe(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (CY_AFE_PROCESSING_MODE_SYNC != context->config_init.processing_mode)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, afe_reframe_get_sync_frame_size(context),
+            (void **)&context->reframe_sync_frame);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to allocate reframing buffer");
+        return result;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Return the partial frames and free the reframing buffers
+ */
+void afe_reframe_cleanup(afe_internal_context_t *context)
+{
+    if (NULL != context->reframe_output.output_buf)
+    {
+        afe_dispatch_release_output(context, &context->reframe_output);
+        memset(&context->reframe_output, 0, sizeof(context->reframe_output));
+    }
+
+    if (afe_pool_owns(&context->input_pool, context->reframe_input_frame))
+    {
+        afe_pool_release(&context->input_pool, context->reframe_input_frame);
+    }
+    context->reframe_input_frame = NULL;
+    context->reframe_input_samples = 0;
+
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->reframe_sync_frame);
+    context->reframe_sync_frame = NULL;
+}
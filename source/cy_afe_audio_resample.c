@@ -0,0 +1,261 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_resample.c
+ * @brief Polyphase FIR resampling between the input sample rate and the sample rate
+ *        of speech enhancement
+ *
+ */
+
+#include "cy_afe_audio_resample.h"
+#include "cy_afe_audio_dsp.h"
+#include "cy_audio_front_end_error.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+/* Kaiser windowed low pass, cutoff 7 kHz at 48 kHz, unity DC gain */
+static const int16_t afe_resample_48k_24_taps[24] =
+{
+       -30,    -18,    111,    297,    270,   -233,  -1044,  -1355,   -166,   2809,   6558,   9185,
+      9185,   6558,   2809,   -166,  -1355,  -1044,   -233,    270,    297,    111,    -18,    -30
+};
+
+static const int16_t afe_resample_48k_48_taps[48] =
+{
+         1,      6,      9,     -1,    -27,    -47,    -24,     55,    137,    123,    -44,   -278,
+      -359,   -104,    413,    791,    557,   -393,  -1497,  -1715,   -191,   3017,   6733,   9223,
+      9223,   6733,   3017,   -191,  -1715,  -1497,   -393,    557,    791,    413,   -104,   -359,
+      -278,    -44,    123,    137,     55,    -24,    -47,    -27,     -1,      9,      6,      1
+};
+
+static const int16_t afe_resample_48k_72_taps[72] =
+{
+         1,      0,     -2,     -4,     -4,      3,     13,     16,      2,    -25,    -43,    -26,
+        29,     84,     82,     -6,   -129,   -181,    -77,    146,    317,    252,    -80,   -461,
+      -547,   -146,    545,    986,    660,   -445,  -1638,  -1820,   -198,   3072,   6777,   9230,
+      9230,   6777,   3072,   -198,  -1820,  -1638,   -445,    660,    986,    545,   -146,   -547,
+      -461,    -80,    252,    317,    146,    -77,   -181,   -129,     -6,     82,     84,     29,
+       -26,    -43,    -25,      2,     16,     13,      3,     -4,     -4,     -2,      0,      1
+};
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct
+{
+    uint32_t sample_rate;         // input sample rate
+    uint32_t core_sample_rate;    // sample rate of speech enhancement
+    uint32_t taps;                // filter length, a multiple of the resampling factor
+    const int16_t *coefficients;  // symmetric filter, Q15
+} afe_resample_filter_t;
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+static const afe_resample_filter_t afe_resample_filters[] =
+{
+    { 48000, 16000, 24, afe_resample_48k_24_taps },
+    { 48000, 16000, 48, afe_resample_48k_48_taps },
+    { 48000, 16000, 72, afe_resample_48k_72_taps },
+};
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static const afe_resample_filter_t *afe_resample_find_filter(uint32_t sample_rate, uint32_t taps)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < (sizeof(afe_resample_filters) / sizeof(afe_resample_filters[0])); index++)
+    {
+        if (sample_rate == afe_resample_filters[index].sample_rate &&
+            (0 == taps || taps == afe_resample_filters[index].taps))
+        {
+            return &afe_resample_filters[index];
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+uint32_t afe_resample_get_core_rate(uint32_t sample_rate)
+{
+    const afe_resample_filter_t *filter = afe_resample_find_filter(sample_rate, 0);
+
+    return (NULL != filter) ? filter->core_sample_rate : sample_rate;
+}
+
+cy_rslt_t afe_resample_get_filter_taps(uint32_t sample_rate, uint32_t index, uint32_t *taps)
+{
+    uint32_t filter = 0;
+
+    for (filter = 0; filter < (sizeof(afe_resample_filters) / sizeof(afe_resample_filters[0])); filter++)
+    {
+        if (sample_rate == afe_resample_filters[filter].sample_rate)
+        {
+            if (0 == index)
+            {
+                *taps = afe_resample_filters[filter].taps;
+                return CY_RSLT_SUCCESS;
+            }
+            index--;
+        }
+    }
+
+    return CY_RSLT_AFE_BAD_ARG;
+}
+
+uint32_t afe_resample_get_buffer_size(uint32_t sample_rate, uint32_t taps, uint32_t input_samples, uint32_t num_streams)
+{
+    const afe_resample_filter_t *filter = afe_resample_find_filter(sample_rate, taps);
+    uint32_t factor = 0;
+    uint32_t samples = 0;
+
+    if (NULL == filter || 0 == num_streams || num_streams > AFE_RESAMPLE_MAX_STREAMS)
+    {
+        return 0;
+    }
+
+    factor = filter->sample_rate / filter->core_sample_rate;
+    if (0 != (input_samples % factor))
+    {
+        return 0;
+    }
+
+    /* Interpolation branches, decimation history and frame of each stream, interpolation history and frame */
+    samples = taps;
+    samples += num_streams * (taps - 1 + input_samples);
+    samples += (taps / factor) - 1 + (input_samples / factor);
+
+    return samples * sizeof(int16_t);
+}
+
+cy_rslt_t afe_resample_init(afe_resampler_t *resampler, uint32_t sample_rate, uint32_t taps,
+        uint32_t input_samples, uint32_t num_streams, void *buffer)
+{
+    const afe_resample_filter_t *filter = afe_resample_find_filter(sample_rate, taps);
+    int16_t *samples = (int16_t *)buffer;
+    uint32_t stream = 0;
+    uint32_t phase = 0;
+    uint32_t tap = 0;
+    int32_t coefficient = 0;
+
+    if (NULL == resampler || NULL == buffer ||
+        0 == afe_resample_get_buffer_size(sample_rate, taps, input_samples, num_streams))
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    memset(resampler, 0, sizeof(afe_resampler_t));
+    resampler->factor = filter->sample_rate / filter->core_sample_rate;
+    resampler->taps = taps;
+    resampler->taps_per_phase = taps / resampler->factor;
+    resampler->input_samples = input_samples;
+    resampler->num_streams = num_streams;
+    resampler->decimation_coefficients = filter->coefficients;
+
+    /* Branch p holds h[p + j * factor] in reversed order, scaled by factor to keep unity gain */
+    resampler->interpolation_coefficients = samples;
+    for (phase = 0; phase < resampler->factor; phase++)
+    {
+        for (tap = 0; tap < resampler->taps_per_phase; tap++)
+        {
+            coefficient = (int32_t)filter->coefficients[phase + ((resampler->taps_per_phase - 1 - tap) * resampler->factor)] *
+                    (int32_t)resampler->factor;
+            resampler->interpolation_coefficients[(phase * resampler->taps_per_phase) + tap] =
+                    (int16_t)((coefficient > INT16_MAX) ? INT16_MAX : ((coefficient < INT16_MIN) ? INT16_MIN : coefficient));
+        }
+    }
+    samples += taps;
+
+    for (stream = 0; stream < num_streams; stream++)
+    {
+        resampler->decimation_buffer[stream] = samples;
+        samples += taps - 1 + input_samples;
+    }
+
+    resampler->interpolation_buffer = samples;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void afe_resample_decimate(afe_resampler_t *resampler, uint32_t stream, const int16_t *input, int16_t *output)
+{
+    int16_t *buffer = resampler->decimation_buffer[stream];
+    uint32_t history = resampler->taps - 1;
+
+    afe_dsp_copy(buffer + history, input, resampler->input_samples * sizeof(int16_t));
+
+    afe_dsp_fir_decimate_q15(buffer, resampler->decimation_coefficients, resampler->taps,
+            resampler->factor, output, resampler->input_samples / resampler->factor);
+
+    /* Keep the last samples as history of the next frame */
+    memmove(buffer, buffer + resampler->input_samples, history * sizeof(int16_t));
+}
+
+void afe_resample_reset_stream(afe_resampler_t *resampler, uint32_t stream)
+{
+    memset(resampler->decimation_buffer[stream], 0, (resampler->taps - 1) * sizeof(int16_t));
+}
+
+void afe_resample_interpolate(afe_resampler_t *resampler, const int16_t *input, int16_t *output)
+{
+    int16_t *buffer = resampler->interpolation_buffer;
+    uint32_t history = resampler->taps_per_phase - 1;
+    uint32_t core_samples = resampler->input_samples / resampler->factor;
+
+    afe_dsp_copy(buffer + history, input, core_samples * sizeof(int16_t));
+
+    afe_dsp_fir_interpolate_q15(buffer, resampler->interpolation_coefficients, resampler->taps_per_phase,
+            resampler->factor, output, core_samples);
+
+    memmove(buffer, buffer + core_samples, history * sizeof(int16_t));
+}
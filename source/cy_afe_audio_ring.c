@@ -0,0 +1,321 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_ring.c
+ * @brief Wait-free single producer/single consumer ring. The producer only copies the
+ *        item and publishes the write count; the RTOS semaphores are touched only when
+ *        the other side has announced that it is going to block.
+ *
+ *        Items are addressed with free running counters masked by the power of 2 slot
+ *        count, so the counters never repeat while an item is in the ring. This allows
+ *        the producer to take the oldest item away (drop oldest) with a compare and
+ *        swap on read_count, racing safely with the consumer.
+ *
+ */
+
+#include "cy_afe_audio_ring.h"
+#include "cy_audio_front_end_error.h"
+#include "cyabs_rtos_internal.h"
+#include <string.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static uint32_t afe_ring_num_slots(uint32_t capacity)
+{
+    uint32_t num_slots = 1;
+
+    while(num_slots < capacity)
+    {
+        num_slots <<= 1;
+    }
+
+    return num_slots;
+}
+
+static inline uint8_t *afe_ring_slot(afe_ring_t *ring, uint32_t count)
+{
+    return ring->buffer + ((count & ring->index_mask) * ring->item_size);
+}
+
+static void afe_ring_notify_space(afe_ring_t *ring)
+{
+    /* Pairs with the fence in afe_ring_wait_for_space */
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(&ring->producer_waiting, memory_order_relaxed))
+    {
+        cy_rtos_set_semaphore(&ring->space_semaphore, false);
+    }
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+uint32_t afe_ring_buffer_size(uint32_t item_size, uint32_t capacity)
+{
+    return item_size * afe_ring_num_slots(capacity);
+}
+
+cy_rslt_t afe_ring_init(afe_ring_t *ring, void *buffer, uint32_t item_size, uint32_t capacity)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if(NULL == ring || NULL == buffer || 0 == item_size || 0 == capacity)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    memset(ring, 0, sizeof(afe_ring_t));
+
+    result = cy_rtos_init_semaphore(&ring->data_semaphore, 1, 0);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    result = cy_rtos_init_semaphore(&ring->space_semaphore, 1, 0);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        cy_rtos_deinit_semaphore(&ring->data_semaphore);
+        return result;
+    }
+
+    ring->buffer = (uint8_t *)buffer;
+    ring->item_size = item_size;
+    ring->capacity = capacity;
+    ring->index_mask = afe_ring_num_slots(capacity) - 1;
+    atomic_init(&ring->write_count, 0);
+    atomic_init(&ring->read_count, 0);
+    atomic_init(&ring->consumer_waiting, false);
+    atomic_init(&ring->producer_waiting, false);
+    ring->initialized = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+void afe_ring_deinit(afe_ring_t *ring)
+{
+    if(NULL == ring || false == ring->initialized)
+    {
+        return;
+    }
+
+    cy_rtos_deinit_semaphore(&ring->data_semaphore);
+    cy_rtos_deinit_semaphore(&ring->space_semaphore);
+    ring->initialized = false;
+    ring->buffer = NULL;
+}
+
+cy_rslt_t afe_ring_push(afe_ring_t *ring, const void *item)
+{
+    if(0 == afe_ring_free_count(ring))
+    {
+        return CY_RSLT_AFE_QUEUE_FULL;
+    }
+
+    memcpy(afe_ring_write_slot(ring, 0), item, ring->item_size);
+    afe_ring_commit(ring, 1);
+
+    return CY_RSLT_SUCCESS;
+}
+
+void *afe_ring_write_slot(afe_ring_t *ring, uint32_t offset)
+{
+    uint32_t write_count = (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_relaxed);
+
+    return afe_ring_slot(ring, write_count + offset);
+}
+
+void afe_ring_commit(afe_ring_t *ring, uint32_t count)
+{
+    uint32_t write_count = (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_relaxed);
+
+    atomic_store_explicit(&ring->write_count, write_count + count, memory_order_release);
+
+    /* Pairs with the fence in afe_ring_pop: either the consumer sees the new write
+     * count before blocking, or the producer sees consumer_waiting and signals.
+     */
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(&ring->consumer_waiting, memory_order_relaxed))
+    {
+        cy_rtos_set_semaphore(&ring->data_semaphore, is_in_isr());
+    }
+}
+
+cy_rslt_t afe_ring_wait_for_space(afe_ring_t *ring, uint32_t count, cy_time_t timeout_ms)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_time_t start_time = 0;
+    cy_time_t now = 0;
+    cy_time_t wait_ms = timeout_ms;
+
+    if(count > ring->capacity)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    cy_rtos_get_time(&start_time);
+
+    while(afe_ring_free_count(ring) < count)
+    {
+        if(CY_RTOS_NEVER_TIMEOUT != timeout_ms)
+        {
+            cy_rtos_get_time(&now);
+            if((now - start_time) >= timeout_ms)
+            {
+                return CY_RTOS_TIMEOUT;
+            }
+            wait_ms = timeout_ms - (now - start_time);
+        }
+
+        atomic_store_explicit(&ring->producer_waiting, true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if(afe_ring_free_count(ring) >= count)
+        {
+            atomic_store_explicit(&ring->producer_waiting, false, memory_order_relaxed);
+            break;
+        }
+
+        result = cy_rtos_get_semaphore(&ring->space_semaphore, wait_ms, false);
+        atomic_store_explicit(&ring->producer_waiting, false, memory_order_relaxed);
+        if(CY_RSLT_SUCCESS != result && afe_ring_free_count(ring) < count)
+        {
+            return CY_RTOS_TIMEOUT;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+bool afe_ring_drop_oldest(afe_ring_t *ring, void *item)
+{
+    uint_fast32_t read_count = atomic_load_explicit(&ring->read_count, memory_order_acquire);
+
+    if((uint32_t)read_count == (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_relaxed))
+    {
+        return false;
+    }
+
+    /* Consumer never writes to the slots, so the item can be copied before claiming it */
+    memcpy(item, afe_ring_slot(ring, (uint32_t)read_count), ring->item_size);
+
+    return atomic_compare_exchange_strong_explicit(&ring->read_count, &read_count, (uint32_t)(read_count + 1),
+            memory_order_acq_rel, memory_order_acquire);
+}
+
+cy_rslt_t afe_ring_pop(afe_ring_t *ring, void *item, cy_time_t timeout_ms)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint_fast32_t read_count = 0;
+
+    while(true)
+    {
+        read_count = atomic_load_explicit(&ring->read_count, memory_order_acquire);
+
+        if((uint32_t)read_count == (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_acquire))
+        {
+            if(0 == timeout_ms)
+            {
+                return CY_RTOS_TIMEOUT;
+            }
+
+            atomic_store_explicit(&ring->consumer_waiting, true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+
+            if((uint32_t)read_count == (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_acquire))
+            {
+                result = cy_rtos_get_semaphore(&ring->data_semaphore, timeout_ms, false);
+            }
+            atomic_store_explicit(&ring->consumer_waiting, false, memory_order_relaxed);
+            if(CY_RSLT_SUCCESS != result)
+            {
+                return result;
+            }
+            continue;
+        }
+
+        /* The slot may be dropped and refilled by the producer while it is being copied.
+         * In that case read_count has moved on, the claim fails and the copy is discarded.
+         */
+        memcpy(item, afe_ring_slot(ring, (uint32_t)read_count), ring->item_size);
+
+        if(atomic_compare_exchange_strong_explicit(&ring->read_count, &read_count, (uint32_t)(read_count + 1),
+                memory_order_acq_rel, memory_order_acquire))
+        {
+            break;
+        }
+    }
+
+    afe_ring_notify_space(ring);
+
+    return CY_RSLT_SUCCESS;
+}
+
+uint32_t afe_ring_count(afe_ring_t *ring)
+{
+    uint32_t write_count = (uint32_t)atomic_load_explicit(&ring->write_count, memory_order_acquire);
+    uint32_t read_count = (uint32_t)atomic_load_explicit(&ring->read_count, memory_order_acquire);
+
+    return write_count - read_count;
+}
+
+uint32_t afe_ring_free_count(afe_ring_t *ring)
+{
+    return ring->capacity - afe_ring_count(ring);
+}
@@ -41,7 +41,9 @@
 #include "cy_afe_audio_speech_enh.h"
 #include "cy_audio_front_end.h"
 #include "cy_afe_audio_internal.h"
+#include "cy_afe_audio_memory.h"
 #include "cy_sp_enh.h"
+#include <stdatomic.h>
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 #include "cy_afe_configurator_settings.h"
@@ -52,6 +54,13 @@
  ******************************************************/
 // #define CY_RSLT_ERROR           (-1)
 
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+/* Maximum time a tuner command waits for its update to be applied by the processing context */
+#ifndef AFE_TUNER_PARAMS_APPLY_TIMEOUT_MS
+#define AFE_TUNER_PARAMS_APPLY_TIMEOUT_MS (100)
+#endif
+#endif
+
 /******************************************************
  *                    Constants
  ******************************************************/
@@ -71,99 +80,40 @@
 /******************************************************
  *                 Global Variables
  ******************************************************/
+/* The speech enhancement library has one set of memory callbacks shared by all
+ * instances. The AFE instance whose library handle is being created or deleted is
+ * stored here, so the library memory is requested through the allocator of that
+ * instance. afe_sp_mem_owner_lock is held as long as an owner is set, so library
+ * init and deinit of concurrent cy_afe_create and cy_afe_delete calls run one at a time.
+ * A flag is used as it needs no creation before the first instance.
+ */
+static afe_internal_context_t *afe_sp_mem_owner = NULL;
+static atomic_flag afe_sp_mem_owner_lock = ATOMIC_FLAG_INIT;
+
+/* Formats accepted by the speech enhancement library */
+static const uint32_t afe_sp_supported_sample_rates[] = { 16000 };
+static const uint32_t afe_sp_supported_frame_sizes_ms[] = { 10 };
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-int32_t ifx_out_locator[AFE_USB_SELECT_SIG_C+1];
+/* Components whose parameters are staged by the tuner, the index of a component in
+ * the staged updates and in the snapshot is its position in this table
+ */
+static const ifx_sp_enh_ip_component_config_t afe_sp_params_components[AFE_TUNER_PARAMS_COMPONENTS] =
+{
+    IFX_SP_ENH_IP_COMPONENT_HPF, IFX_SP_ENH_IP_COMPONENT_AEC, IFX_SP_ENH_IP_COMPONENT_ANALYSIS,
+    IFX_SP_ENH_IP_COMPONENT_BF, IFX_SP_ENH_IP_COMPONENT_DRVB, IFX_SP_ENH_IP_COMPONENT_ES,
+    IFX_SP_ENH_IP_COMPONENT_DSES, IFX_SP_ENH_IP_COMPONENT_NS, IFX_SP_ENH_IP_COMPONENT_DSNS,
+    IFX_SP_ENH_IP_COMPONENT_SYNTHESIS
+};
 #endif
-int16_t AUDIO_METER[CY_AFE_AUDIO_METER_MAX];
 
 /******************************************************
  *               Static Functions
  ******************************************************/
-
-/******************************************************
- *               Functions
- ******************************************************/
-
-cy_rslt_t afe_sp_alloc_memory_callback_t(ifx_sp_mem_id mem_id,
-        uint32_t size, void **buffer)
-{
-    cy_rslt_t result = CY_RSLT_SUCCESS;
-
-    if(NULL == buffer)
-    {
-        result = CY_RSLT_AFE_BAD_ARG;
-        return result;
-    }
-
-    *buffer = NULL;
-
-    if(NULL != afe_alloc_memory)
-    {
-        switch(mem_id)
-        {
-            case IFX_SP_MEM_ID_HANDLE:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_AFE_CONTEXT,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_SCRATCH_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_ALGORITHM_SCRATCH_MEMORY,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_PERSISTENT_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_ALGORITHM_PERSISTENT_MEMORY,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_BF_PERSISTENT_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_ALGORITHM_BF_MEMORY,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_DSNS_SOCMEM_PERSISTENT_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_ALGORITHM_NS_MEMORY,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_DSES_SOCMEM_PERSISTENT_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_ALGORITHM_ES_MEMORY,size,buffer);
-                break;
-            }
-            case IFX_SP_MEM_ID_GDE_PERSISTENT_MEM:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_GDE_PERSISTENT_MEM,size,buffer);
-                break;
-            }
-
-            default:
-            {
-                result = afe_alloc_memory(CY_AFE_MEM_ID_GENERIC_MEMORY,size,buffer);
-                break;
-            }
-        }
-    }
-    else
-    {
-        *buffer = (void *)calloc (size,1);
-    }
-
-    return result;
-}
-
-cy_rslt_t afe_sp_free_memory_callback_t(ifx_sp_mem_id mem_id,
-        void *buffer)
+static cy_afe_mem_id_t afe_sp_get_afe_mem_id(ifx_sp_mem_id mem_id)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_afe_mem_id_t afe_mem_id = CY_AFE_MEM_ID_INVALID;
 
-    if(NULL == buffer)
-    {
-        result = CY_RSLT_AFE_BAD_ARG;
-        return result;
-    }
-
     switch(mem_id)
     {
         case IFX_SP_MEM_ID_HANDLE:
@@ -208,19 +158,183 @@ cy_rslt_t afe_sp_free_memory_callback_t(ifx_sp_mem_id mem_id,
         }
     }
 
-    if(NULL != afe_free_memory)
+    return afe_mem_id;
+}
+
+static void afe_sp_set_memory_owner(afe_internal_context_t *context)
+{
+    if(NULL != context)
+    {
+        while(atomic_flag_test_and_set_explicit(&afe_sp_mem_owner_lock, memory_order_acquire))
+        {
+            cy_rtos_delay_milliseconds(1);
+        }
+    }
+
+    afe_sp_mem_owner = context;
+
+    /* Library memory is always requested through the instance, so that it is accounted
+     * in the memory usage of the instance, whether or not the application registered
+     * allocator callbacks.
+     */
+    if(NULL != context)
     {
-        result = afe_free_memory(afe_mem_id, buffer);
+        cy_sp_alloc_memory = afe_sp_alloc_memory_callback_t;
+        cy_sp_free_memory = afe_sp_free_memory_callback_t;
     }
     else
     {
-        free(buffer);
-        buffer = NULL;  // This has no effect - buffer is a parameter copy
+        cy_sp_alloc_memory = NULL;
+        cy_sp_free_memory = NULL;
+        atomic_flag_clear_explicit(&afe_sp_mem_owner_lock, memory_order_release);
+    }
+}
+
+/* Record memory allocated by the library (size > 0) or forget it when it is freed (size 0) */
+static void afe_sp_track_memory(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer, uint32_t size)
+{
+    uint32_t index = 0;
+    void *match = (0 == size) ? buffer : NULL;
+
+    for(index = 0; index < AFE_SP_MAX_MEMORY_BLOCKS; index++)
+    {
+        if(match == context->sp_memory_blocks[index].buffer)
+        {
+            context->sp_memory_blocks[index].buffer = (0 == size) ? NULL : buffer;
+            context->sp_memory_blocks[index].size = size;
+            context->sp_memory_blocks[index].mem_id = mem_id;
+            return;
+        }
+    }
+
+    if(0 != size)
+    {
+        cy_afe_log_info("Library memory not tracked, increase AFE_SP_MAX_MEMORY_BLOCKS. mem_id:[%d], size:[%"PRIu32"]",
+                mem_id, size);
+    }
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+
+cy_rslt_t afe_sp_alloc_memory_callback_t(ifx_sp_mem_id mem_id,
+        uint32_t size, void **buffer)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if(NULL == buffer)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    *buffer = NULL;
+
+    if(NULL == afe_sp_mem_owner)
+    {
+        *buffer = (void *)calloc (size,1);
+        return CY_RSLT_SUCCESS;
+    }
+
+    /* The beamformer needs two microphones. Its persistent memory is not allocated for
+     * a single microphone instance, whose filter settings must have the beamformer disabled.
+     */
+    if(IFX_SP_MEM_ID_BF_PERSISTENT_MEM == mem_id && afe_sp_mem_owner->num_channels < CY_AFE_AUDIO_STEREO_CHANNEL)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Beamformer memory requested for a single microphone, disable the beamformer in the filter settings");
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    /* Library scratch memory is the scratch arena of the instance, sized for the AFE users too */
+    if(IFX_SP_MEM_ID_SCRATCH_MEM == mem_id && size < afe_sp_mem_owner->scratch_arena_min_size)
+    {
+        size = afe_sp_mem_owner->scratch_arena_min_size;
+    }
+
+    result = afe_memory_alloc_library(afe_sp_mem_owner, afe_sp_get_afe_mem_id(mem_id), size, buffer);
+    if(CY_RSLT_SUCCESS == result)
+    {
+        afe_sp_track_memory(afe_sp_mem_owner, afe_sp_get_afe_mem_id(mem_id), *buffer, size);
+        if(IFX_SP_MEM_ID_SCRATCH_MEM == mem_id && size > afe_sp_mem_owner->scratch_arena.size)
+        {
+            afe_sp_mem_owner->scratch_arena.buffer = *buffer;
+            afe_sp_mem_owner->scratch_arena.size = size;
+        }
     }
 
     return result;
 }
 
+cy_rslt_t afe_sp_free_memory_callback_t(ifx_sp_mem_id mem_id,
+        void *buffer)
+{
+    if(NULL == buffer)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    if(NULL == afe_sp_mem_owner)
+    {
+        free(buffer);
+        return CY_RSLT_SUCCESS;
+    }
+
+    afe_sp_track_memory(afe_sp_mem_owner, afe_sp_get_afe_mem_id(mem_id), buffer, 0);
+    if(buffer == afe_sp_mem_owner->scratch_arena.buffer)
+    {
+        afe_sp_mem_owner->scratch_arena.buffer = NULL;
+        afe_sp_mem_owner->scratch_arena.size = 0;
+    }
+    afe_memory_free_library(afe_sp_mem_owner, afe_sp_get_afe_mem_id(mem_id), buffer);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: afe_speech_enhancement_validate_format
+ ********************************************************************************
+ * Summary:
+ *   Check that the sample rate, frame size and channel count requested in the AFE
+ *   configuration are supported by the speech enhancement library.
+ *
+ * Parameters:
+ *   sample_rate (in)   : input sample rate in Hz
+ *   frame_size_ms (in) : frame duration in ms
+ *   num_channels (in)  : number of input channels
+ *******************************************************************************/
+cy_rslt_t afe_speech_enhancement_validate_format(uint32_t sample_rate, uint32_t frame_size_ms, uint32_t num_channels)
+{
+    uint32_t index = 0;
+    bool rate_supported = false;
+    bool frame_size_supported = false;
+
+    for(index = 0; index < (sizeof(afe_sp_supported_sample_rates) / sizeof(afe_sp_supported_sample_rates[0])); index++)
+    {
+        if(afe_sp_supported_sample_rates[index] == sample_rate)
+        {
+            rate_supported = true;
+        }
+    }
+
+    for(index = 0; index < (sizeof(afe_sp_supported_frame_sizes_ms) / sizeof(afe_sp_supported_frame_sizes_ms[0])); index++)
+    {
+        if(afe_sp_supported_frame_sizes_ms[index] == frame_size_ms)
+        {
+            frame_size_supported = true;
+        }
+    }
+
+    if(!rate_supported || !frame_size_supported ||
+       num_channels < CY_AFE_AUDIO_MONO_CHANNEL || num_channels > CY_AFE_AUDIO_STEREO_CHANNEL)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Unsupported format rate:%"PRIu32" frame:%"PRIu32"ms channels:%"PRIu32,
+                sample_rate, frame_size_ms, num_channels);
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
 /*******************************************************************************
  * Function Name: afe_speech_enhancement_init
  ********************************************************************************
@@ -230,12 +344,13 @@ cy_rslt_t afe_sp_free_memory_callback_t(ifx_sp_mem_id mem_id,
  *   memory & scratch memory.
  *
  * Parameters:
+ *   context (in)         : audio front end instance, speech enhancement handle is
+ *                          stored in its sp_enh_context
  *   filter_settings (in) : header file filter setting format generated by audio front end
  *                          configurator tool
- *   context (in)         : audio front end instance
  *******************************************************************************/
-cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_settings,
-                                    uint32_t mw_settings_length, void **context)
+cy_rslt_t afe_speech_enhancement_init(afe_internal_context_t *context, int32_t *filter_settings,
+                                    uint8_t *mw_settings, uint32_t mw_settings_length)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_sp_enh_config_params sp_enh_config;
@@ -246,9 +361,9 @@ cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_setti
 #endif
 
     memset(&sp_enh_config, 0, sizeof(cy_sp_enh_config_params));
-    sp_enh_config.sampling_rate = AFE_FRAME_RATE_SPS;
-    sp_enh_config.input_frame_size = (AFE_FRAME_RATE_SPS * AFE_FRAME_SIZE_MS)/1000;
-    sp_enh_config.num_mics = 2;
+    sp_enh_config.sampling_rate = context->core_sample_rate;
+    sp_enh_config.input_frame_size = context->core_frame_samples;
+    sp_enh_config.num_mics = context->num_channels;
 
 #ifdef ENABLE_IFX_HPF
     sp_enh_config.hpf_enable = 1;
@@ -259,7 +374,8 @@ cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_setti
 #endif
 
 #ifdef ENABLE_IFX_BF
-    sp_enh_config.bf_enable = 1;
+    /* Beamforming needs two microphones */
+    sp_enh_config.bf_enable = (sp_enh_config.num_mics > 1) ? 1 : 0;
 #endif
 
 #ifdef ENABLE_IFX_DRVB
@@ -289,17 +405,6 @@ cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_setti
 #endif
 #endif
 
-    if(NULL != afe_alloc_memory && NULL != afe_free_memory)
-    {
-        cy_sp_alloc_memory = afe_sp_alloc_memory_callback_t;
-        cy_sp_free_memory = afe_sp_free_memory_callback_t;
-    }
-    else
-    {
-        cy_sp_alloc_memory = NULL;
-        cy_sp_free_memory = NULL;
-    }
-
     cy_afe_log_info("sample_rate = %"PRIi32, sp_enh_config.sampling_rate);
     cy_afe_log_info("audio_frame_size = %"PRIi32, sp_enh_config.input_frame_size);
     cy_afe_log_info("num_channels = %"PRIi32, sp_enh_config.num_mics);
@@ -311,6 +416,7 @@ cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_setti
     cy_afe_log_info("es_enable = %"PRIi32, sp_enh_config.es_enable|sp_enh_config.dses_enable);
     cy_afe_log_info("anasyn_enable = %"PRIi32, sp_enh_config.anasyn_enable);
 
+    afe_sp_set_memory_owner(context);
     result = cy_sp_enh_init(filter_settings, mw_settings,
                             mw_settings_length, &sp_enh_handle);
     if(CY_RSLT_SUCCESS != result)
@@ -320,10 +426,20 @@ cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_setti
         goto CLEAN_RETURN;
     }
 
-    *context = sp_enh_handle;
+    if(sp_enh_handle->sp_enh_info.common.num_mics != (int32_t)context->num_channels)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Filter settings use %"PRIi32" mics, AFE configured for %"PRIu32" channels",
+                (int32_t)sp_enh_handle->sp_enh_info.common.num_mics, context->num_channels);
+        result = CY_RSLT_AFE_BAD_ARG;
+        goto CLEAN_RETURN;
+    }
+
+    context->sp_enh_context = sp_enh_handle;
+    afe_sp_set_memory_owner(NULL);
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-    afe_speech_enhancement_update_dbg_out_config(sp_enh_handle,&MY_AFE_USB_SETTINGS);
+    afe_speech_enhancement_update_dbg_out_config(context, &context->usb_settings);
+    afe_speech_enhancement_refresh_params(context);
 #else
     cy_sp_enh_configure_dbg_out(sp_enh_handle, IFX_SP_ENH_IP_COMPONENT_INVALID, false);
 #endif
@@ -335,6 +451,7 @@ CLEAN_RETURN:
     AFE_MW_CHECK_POINT()
 #endif
     cy_sp_enh_deinit(sp_enh_handle);
+    afe_sp_set_memory_owner(NULL);
     return result;
 }
 
@@ -358,13 +475,19 @@ cy_rslt_t afe_speech_enhancement_process(void *context, afe_sp_enh_input_output_
 #endif
 
 #ifdef ENABLE_AFE_STUB
-    memcpy(sp_enh_input_output->output, sp_enh_input_output->input1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
+    memcpy(sp_enh_input_output->output, sp_enh_input_output->input1, sp_enh_input_output->frame_size);
 #else
+    /* Library is not initialized after a failed cy_afe_update_filter_settings */
+    if(NULL == context)
+    {
+        return CY_RSLT_AFE_SYSTEM_MODULE_ERROR;
+    }
+
     result = cy_sp_enh_process(context, sp_enh_input_output->input1,
             sp_enh_input_output->input2,
             sp_enh_input_output->aec_reference_input,
             sp_enh_input_output->output,
-            sp_enh_input_output->ifx_internal_output, AUDIO_METER);
+            sp_enh_input_output->ifx_internal_output, sp_enh_input_output->audio_meter);
 
     if(CY_RSLT_SUCCESS != result)
     {
@@ -389,22 +512,126 @@ cy_rslt_t afe_speech_enhancement_process(void *context, afe_sp_enh_input_output_
  *   speech enhancement handle.
  *
  * Parameters:
- *   context (in)             : speech enhancement context
+ *   context (in)             : audio front end instance
  *******************************************************************************/
-cy_rslt_t afe_speech_enhancement_deinit(void *context)
+cy_rslt_t afe_speech_enhancement_deinit(afe_internal_context_t *context)
 {
     cy_sp_enh_handle *handle = NULL;
 
-    handle = (cy_sp_enh_handle*) context;
+    handle = (cy_sp_enh_handle*) context->sp_enh_context;
 
+    afe_sp_set_memory_owner(context);
     cy_sp_enh_deinit(handle);
+    afe_sp_set_memory_owner(NULL);
+
+    context->sp_enh_context = NULL;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: afe_speech_enhancement_reinit
+ ********************************************************************************
+ * Summary:
+ *   Re-create the speech enhancement library instance with other filter settings.
+ *   Memory of the components which are not part of the new settings is returned
+ *   through free_memory, components which are new are allocated. If the new
+ *   settings can not be applied, the previous settings are restored. A static
+ *   instance reuses its library reservation, settings needing more memory than it
+ *   holds are rejected.
+ *
+ * Parameters:
+ *   context (in)            : audio front end instance
+ *   filter_settings (in)    : filter settings generated by the audio front end configurator
+ *   mw_settings (in)        : middleware settings generated by the configurator, can be NULL
+ *   mw_settings_length (in) : length of mw_settings
+ *******************************************************************************/
+cy_rslt_t afe_speech_enhancement_reinit(afe_internal_context_t *context, int32_t *filter_settings,
+                                    uint8_t *mw_settings, uint32_t mw_settings_length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    afe_speech_enhancement_deinit(context);
+
+    /* Library memory of a static instance is carved again from the start of its reservation,
+     * which holds the memory of the settings in use, so restoring them always fits.
+     */
+    afe_memory_library_reset(context);
+
+    result = afe_speech_enhancement_init(context, filter_settings, mw_settings, mw_settings_length);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to apply filter settings, restoring previous settings");
+        afe_memory_library_reset(context);
+        if(CY_RSLT_SUCCESS != afe_speech_enhancement_init(context, (int32_t *)context->config_init.filter_settings,
+                context->config_init.mw_settings, context->config_init.mw_settings_length))
+        {
+            cy_afe_log_err(CY_RSLT_AFE_SYSTEM_MODULE_ERROR, "Failed to restore filter settings");
+        }
+        return result;
+    }
 
-    cy_sp_alloc_memory = NULL;
-    cy_sp_free_memory = NULL;
+    context->config_init.filter_settings = (uint32_t *)filter_settings;
+    context->config_init.mw_settings = mw_settings;
+    context->config_init.mw_settings_length = mw_settings_length;
 
     return CY_RSLT_SUCCESS;
 }
 
+/*******************************************************************************
+ * Function Name: afe_speech_enhancement_get_memory
+ ********************************************************************************
+ * Summary:
+ *   Get the memory currently held by the speech enhancement library, grouped by
+ *   the component owning it.
+ *
+ * Parameters:
+ *   context (in)            : audio front end instance
+ *   report (out)            : bytes held per component
+ *******************************************************************************/
+void afe_speech_enhancement_get_memory(afe_internal_context_t *context, cy_afe_component_memory_t *report)
+{
+    uint32_t index = 0;
+    uint32_t size = 0;
+
+    memset(report, 0, sizeof(cy_afe_component_memory_t));
+
+    for(index = 0; index < AFE_SP_MAX_MEMORY_BLOCKS; index++)
+    {
+        if(NULL == context->sp_memory_blocks[index].buffer)
+        {
+            continue;
+        }
+
+        size = context->sp_memory_blocks[index].size;
+        switch(context->sp_memory_blocks[index].mem_id)
+        {
+            case CY_AFE_MEM_ID_ALGORITHM_BF_MEMORY:
+                report->bf_bytes += size;
+                break;
+            case CY_AFE_MEM_ID_ALGORITHM_NS_MEMORY:
+                report->dsns_bytes += size;
+                break;
+            case CY_AFE_MEM_ID_ALGORITHM_ES_MEMORY:
+                report->dses_bytes += size;
+                break;
+            case CY_AFE_MEM_ID_GDE_PERSISTENT_MEM:
+                report->gde_bytes += size;
+                break;
+            case CY_AFE_MEM_ID_ALGORITHM_PERSISTENT_MEMORY:
+                report->shared_persistent_bytes += size;
+                break;
+            case CY_AFE_MEM_ID_ALGORITHM_SCRATCH_MEMORY:
+                report->scratch_bytes += size;
+                break;
+            default:
+                report->other_bytes += size;
+                break;
+        }
+        report->total_bytes += size;
+    }
+}
+
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 static cy_rslt_t is_afe_speech_enhancement_component_enabled(ifx_sp_enh_ip_component_config_t component_name)
 {
@@ -480,43 +707,295 @@ static cy_rslt_t is_afe_speech_enhancement_component_enabled(ifx_sp_enh_ip_compo
         return CY_RSLT_SUCCESS;
 }
 
-cy_rslt_t afe_speech_enhancement_enable_disable_component(void *context,
-        ifx_sp_enh_ip_component_config_t component_name, bool enable)
+static int32_t afe_sp_params_index(ifx_sp_enh_ip_component_config_t component_name)
 {
-    cy_rslt_t result;
-    afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    int32_t index = 0;
 
-    result = is_afe_speech_enhancement_component_enabled(component_name);
-    if(result != CY_RSLT_SUCCESS)
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
     {
-        cy_afe_log_err(result, "Cmd received for statically disabled component ID:%d", component_name);
-        return result;
+        if(component_name == afe_sp_params_components[index])
+        {
+            return index;
+        }
     }
 
-    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    result = cy_sp_enh_enable_disable_component(handle->sp_enh_context, component_name, enable);
-    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
-    if(result != CY_RSLT_SUCCESS)
+    return -1;
+}
+
+static cy_rslt_t afe_sp_tuner_result(cy_rslt_t result)
+{
+    if(result == CY_RSLT_SUCCESS)
     {
-        cy_afe_log_err(result, "Failed to enable/disable component");
-        if(result == CY_RSLT_INVALID_PARAMS)
+        return result;
+    }
+
+    return (result == CY_RSLT_INVALID_PARAMS) ? CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS : CY_RSLT_AFE_TUNER_GENERIC_ERROR;
+}
+
+/* Read the state and parameters of a component from the library, processing context only */
+static void afe_sp_read_component(afe_internal_context_t *context, ifx_sp_enh_ip_component_config_t component_name,
+        afe_tuner_component_params_t *params)
+{
+    hpf_settings_struct_t hpf_pt;
+    aec_settings_struct_t aec_pt;
+    bf_settings_struct_t bf_pt;
+    es_settings_struct_t es_pt;
+    ns_settings_struct_t ns_pt;
+    dsns_settings_struct_t dsns_pt;
+    void * value_struct_pt = NULL;
+
+    memset(params, 0, sizeof(afe_tuner_component_params_t));
+    memset(&hpf_pt, 0, sizeof(hpf_pt));
+    memset(&aec_pt, 0, sizeof(aec_pt));
+    memset(&bf_pt, 0, sizeof(bf_pt));
+    memset(&es_pt, 0, sizeof(es_pt));
+    memset(&ns_pt, 0, sizeof(ns_pt));
+    memset(&dsns_pt, 0, sizeof(dsns_pt));
+
+    params->id = component_name;
+    params->status_result = cy_sp_enh_get_component_status(context->sp_enh_context, component_name, &params->enabled);
+
+    switch (component_name)
+    {
+        case IFX_SP_ENH_IP_COMPONENT_HPF:
+            value_struct_pt = &hpf_pt;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_AEC:
+            value_struct_pt = &aec_pt;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_BF:
+            value_struct_pt = &bf_pt;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_ES:
+        case IFX_SP_ENH_IP_COMPONENT_DSES:
+            value_struct_pt = &es_pt;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_DSNS:
+            value_struct_pt = &dsns_pt;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_NS:
+            value_struct_pt = &ns_pt;
+            break;
+        default: /* Component has no parameters */
+            params->params_result = CY_RSLT_BAD_ARG;
+            return;
+    }
+
+    params->params_result = cy_sp_enh_get_config_value(context->sp_enh_context, component_name, value_struct_pt);
+
+    switch (component_name)
+    {
+        case IFX_SP_ENH_IP_COMPONENT_HPF:
+            params->values[0] = hpf_pt.cutoff_freq_hz;
+            params->value_count = 1;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_AEC:
+            params->values[0] = aec_pt.bulk_delay_msec;
+            params->values[1] = aec_pt.tail_len_msec;
+            params->value_count = 2;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_BF:
+            params->values[0] = bf_pt.aggressiveness;
+            params->values[1] = bf_pt.mic_distance_mm;  /* mic distance in mm unit */
+            params->values[2] = bf_pt.num_beams;        /* number of beams */
+            params->values[3] = bf_pt.angle_range_start;/* start angle range in degree */
+            params->values[4] = bf_pt.angle_range_stop; /* end angle range in degree */
+            params->value_count = 5;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_ES:
+        case IFX_SP_ENH_IP_COMPONENT_DSES:
+            params->values[0] = es_pt.aggressiveness;
+            params->value_count = 1;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_NS:
+            params->values[0] = ns_pt.ns_gain_dB;
+            params->value_count = 1;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_DSNS:
+            params->values[0] = dsns_pt.ns_gain_dB;
+            params->value_count = 1;
+            break;
+        default:
+            break;
+    }
+}
+
+/* The snapshot has a single writer, the processing context. Readers retry while it is written. */
+static void afe_sp_snapshot_write_begin(afe_internal_context_t *context)
+{
+    atomic_fetch_add_explicit(&context->params_snapshot_seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void afe_sp_snapshot_write_end(afe_internal_context_t *context)
+{
+    atomic_fetch_add_explicit(&context->params_snapshot_seq, 1, memory_order_release);
+}
+
+static void afe_sp_snapshot_read(afe_internal_context_t *context, afe_tuner_params_snapshot_t *snapshot)
+{
+    uint_fast32_t sequence = 0;
+
+    while(true)
+    {
+        sequence = atomic_load_explicit(&context->params_snapshot_seq, memory_order_acquire);
+        if(0 == (sequence & 1u))
         {
-            result = CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+            memcpy(snapshot, &context->params_snapshot, sizeof(afe_tuner_params_snapshot_t));
+            atomic_thread_fence(memory_order_acquire);
+            if(sequence == atomic_load_explicit(&context->params_snapshot_seq, memory_order_relaxed))
+            {
+                return;
+            }
         }
-        else
+
+        /* Writer may be preempted by this thread, let it complete */
+        cy_rtos_delay_milliseconds(1);
+    }
+}
+
+/*
+ * Get the update the next tuner command is merged into. Caller holds audio_tuner_mutex.
+ * An update not yet taken by the processing context is withdrawn and extended, else
+ * the other update is used as the processing context may still be applying the last one.
+ */
+static afe_tuner_params_update_t *afe_sp_params_stage(afe_internal_context_t *context)
+{
+    uint_fast32_t pending = atomic_exchange_explicit(&context->params_pending, 0, memory_order_acquire);
+    afe_tuner_params_update_t *update = NULL;
+
+    if(0 != pending)
+    {
+        return &context->params_update[pending - 1];
+    }
+
+    update = &context->params_update[context->params_write_index];
+    context->params_write_index ^= 1u;
+    memset(update, 0, sizeof(afe_tuner_params_update_t));
+    cy_rtos_get_time(&update->staged_time);
+
+    return update;
+}
+
+/* Publish the update and wait for the processing context to apply it at the next frame boundary */
+static cy_rslt_t afe_sp_params_commit(afe_internal_context_t *context, afe_tuner_params_update_t *update)
+{
+    uint32_t sequence = ++context->params_sequence;
+
+    update->sequence = sequence;
+    atomic_store_explicit(&context->params_pending, (uint_fast32_t)(update - context->params_update) + 1u,
+            memory_order_release);
+
+    while((int32_t)((uint32_t)atomic_load_explicit(&context->params_applied_sequence, memory_order_acquire) - sequence) < 0)
+    {
+        if(CY_RSLT_SUCCESS != cy_rtos_get_semaphore(&context->params_applied_semaphore,
+                AFE_TUNER_PARAMS_APPLY_TIMEOUT_MS, false))
         {
-            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
+            /* No frame is being processed, the update stays staged for the next one */
+            cy_afe_log_info("Tuner update %"PRIu32" staged, applied with the next frame", sequence);
+            return CY_RSLT_SUCCESS;
         }
     }
 
+    return context->params_apply_result;
+}
+
+/* Get the update a tuner command is merged into, the open transaction if any. Caller holds audio_tuner_mutex. */
+static afe_tuner_params_update_t *afe_sp_params_begin(afe_internal_context_t *context)
+{
+    if(true == context->params_transaction_open)
+    {
+        return &context->params_transaction;
+    }
+
+    return afe_sp_params_stage(context);
+}
+
+/* Commit the update of a tuner command, unless it belongs to the open transaction */
+static cy_rslt_t afe_sp_params_end(afe_internal_context_t *context, afe_tuner_params_update_t *update)
+{
+    if(true == context->params_transaction_open)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    return afe_sp_params_commit(context, update);
+}
+
+/* Restore the components of a rejected atomic update to the state last read back, processing context only */
+static void afe_sp_params_restore(afe_internal_context_t *context, afe_tuner_params_update_t *update)
+{
+    afe_tuner_component_params_t *previous = NULL;
+    int32_t comp_value[2] = {0};
+    uint32_t index = 0;
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        previous = &context->params_snapshot.component[index];
+
+        if((0 != (update->enable_mask & (1u << index))) && (CY_RSLT_SUCCESS == previous->status_result))
+        {
+            cy_sp_enh_enable_disable_component(context->sp_enh_context, afe_sp_params_components[index], previous->enabled);
+        }
+
+        if((0 != (update->value_mask & (1u << index))) && (CY_RSLT_SUCCESS == previous->params_result) &&
+                (0 < previous->value_count))
+        {
+            comp_value[0] = previous->values[0];
+            comp_value[1] = previous->values[0];
+            cy_sp_enh_update_config_value(context->sp_enh_context, afe_sp_params_components[index], comp_value);
+        }
+    }
+}
+
+cy_rslt_t afe_speech_enhancement_enable_disable_component(void *context,
+        ifx_sp_enh_ip_component_config_t component_name, bool enable)
+{
+    cy_rslt_t result;
+    afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_params_update_t *update = NULL;
+    int32_t index = 0;
+
+    result = is_afe_speech_enhancement_component_enabled(component_name);
+    if(result != CY_RSLT_SUCCESS)
+    {
+        cy_afe_log_err(result, "Cmd received for statically disabled component ID:%d", component_name);
+        return result;
+    }
+
+    index = afe_sp_params_index(component_name);
+    if(index < 0)
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+
+    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
+    update = afe_sp_params_begin(handle);
+    update->enable_mask |= (1u << index);
+    if(enable)
+    {
+        update->enable_value |= (1u << index);
+    }
+    else
+    {
+        update->enable_value &= ~(1u << index);
+    }
+    result = afe_sp_params_end(handle, update);
+    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
+    if(result != CY_RSLT_SUCCESS)
+    {
+        cy_afe_log_err(result, "Failed to enable/disable component");
+    }
+
     return result;
 }
 
 cy_rslt_t afe_speech_enhancement_update_config_value(void *context, ifx_sp_enh_ip_component_config_t component_name, int32_t value)
 {
     cy_rslt_t result;
-    int32_t comp_value[2] = {0};
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_params_update_t *update = NULL;
+    int32_t index = 0;
 
     result = is_afe_speech_enhancement_component_enabled(component_name);
     if(result != CY_RSLT_SUCCESS)
@@ -525,23 +1004,21 @@ cy_rslt_t afe_speech_enhancement_update_config_value(void *context, ifx_sp_enh_i
         return result;
     }
 
-    comp_value[0] = value;
-    comp_value[1] = value;
+    index = afe_sp_params_index(component_name);
+    if(index < 0)
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
 
     cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    result =  cy_sp_enh_update_config_value(handle->sp_enh_context,component_name,comp_value);
+    update = afe_sp_params_begin(handle);
+    update->value_mask |= (1u << index);
+    update->value[index] = value;
+    result = afe_sp_params_end(handle, update);
     cy_rtos_mutex_set(&handle->audio_tuner_mutex);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to update config value");
-        if(result == CY_RSLT_INVALID_PARAMS)
-        {
-            result = CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
-        }
-        else
-        {
-            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
-        }
     }
 
     return result;
@@ -551,13 +1028,9 @@ cy_rslt_t afe_speech_enhancement_get_config_value(void *context, ifx_sp_enh_ip_c
 {
     cy_rslt_t result = CY_RSLT_AFE_GENERIC_ERROR;
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
-    hpf_settings_struct_t hpf_pt;
-    aec_settings_struct_t aec_pt;
-    bf_settings_struct_t bf_pt;
-    es_settings_struct_t es_pt;
-    ns_settings_struct_t ns_pt;
-    dsns_settings_struct_t dsns_pt;
-    void * value_struct_pt = NULL;
+    afe_tuner_params_snapshot_t snapshot;
+    afe_tuner_component_params_t *params = NULL;
+    int32_t index = 0;
 
     if(NULL == value)
     {
@@ -572,104 +1045,30 @@ cy_rslt_t afe_speech_enhancement_get_config_value(void *context, ifx_sp_enh_ip_c
         return result;
     }
 
-    switch (component_name)
+    index = afe_sp_params_index(component_name);
+    if(index < 0)
     {
-        case IFX_SP_ENH_IP_COMPONENT_HPF:
-        {
-            value_struct_pt = &hpf_pt;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_AEC:
-        {
-            value_struct_pt = &aec_pt;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_BF:
-        {
-            value_struct_pt = &bf_pt;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_ES:
-        case IFX_SP_ENH_IP_COMPONENT_DSES:
-        {
-            value_struct_pt = &es_pt;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_DSNS:
-        {
-            value_struct_pt = &dsns_pt;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_NS:
-        {
-            value_struct_pt = &ns_pt;
-        }
-        break;
-        default: /* Other cases do nothing */
-        {
-            CY_SP_PRINTF("Invalid get config component:%d\r\n",component_name);
-            return CY_RSLT_BAD_ARG;
-        }
-            break;
+        CY_SP_PRINTF("Invalid get config component:%d\r\n",component_name);
+        return CY_RSLT_BAD_ARG;
     }
 
-    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    result =  cy_sp_enh_get_config_value(handle->sp_enh_context,component_name,value_struct_pt);
-    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
-    if(result != CY_RSLT_SUCCESS)
+    /* Parameters as last applied, read without blocking the processing context */
+    afe_sp_snapshot_read(handle, &snapshot);
+    params = &snapshot.component[index];
+    if(CY_RSLT_BAD_ARG == params->params_result)
     {
-        cy_afe_log_err(result, "Failed to update config value");
-        if(result == CY_RSLT_INVALID_PARAMS)
-        {
-            result = CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
-        }
-        else
-        {
-            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
-        }
+        CY_SP_PRINTF("Invalid get config component:%d\r\n",component_name);
+        return CY_RSLT_BAD_ARG;
     }
 
-    switch (component_name)
+    result = afe_sp_tuner_result(params->params_result);
+    if(result != CY_RSLT_SUCCESS)
     {
-        case IFX_SP_ENH_IP_COMPONENT_HPF:
-        {
-            *value = hpf_pt.cutoff_freq_hz;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_AEC:
-        {
-            *value = aec_pt.bulk_delay_msec;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_BF:
-        {
-            *value = bf_pt.aggressiveness;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_ES:
-        case IFX_SP_ENH_IP_COMPONENT_DSES:
-        {
-            *value = es_pt.aggressiveness;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_NS:
-        {
-            *value = ns_pt.ns_gain_dB;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_DSNS:
-        {
-            *value = dsns_pt.ns_gain_dB;
-        }
-        break;
-        default: /* Other cases do nothing */
-        {
-            CY_SP_PRINTF("Invalid get config component:%d\r\n",component_name);
-            return CY_RSLT_BAD_ARG;
-        }
-        break;
+        cy_afe_log_err(result, "Failed to update config value");
     }
 
+    *value = params->values[0];
+
     return result;
 }
 
@@ -677,6 +1076,8 @@ cy_rslt_t afe_speech_enhancement_get_component_status(void *context, ifx_sp_enh_
 {
     cy_rslt_t result = CY_RSLT_AFE_GENERIC_ERROR;
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_params_snapshot_t snapshot;
+    int32_t index = 0;
 
     if(NULL == enable)
     {
@@ -691,33 +1092,31 @@ cy_rslt_t afe_speech_enhancement_get_component_status(void *context, ifx_sp_enh_
         return result;
     }
 
-    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    result = cy_sp_enh_get_component_status(handle->sp_enh_context, component_name, enable);
-    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
+    index = afe_sp_params_index(component_name);
+    if(index < 0)
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+
+    afe_sp_snapshot_read(handle, &snapshot);
+    *enable = snapshot.component[index].enabled;
+    result = afe_sp_tuner_result(snapshot.component[index].status_result);
     if(result != CY_RSLT_SUCCESS)
     {
         cy_afe_log_err(result, "Failed to enable/disable component");
-        if(result == CY_RSLT_INVALID_PARAMS)
-        {
-            result = CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
-        }
-        else
-        {
-            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
-        }
     }
 
     return result;
 }
-
-cy_rslt_t afe_speech_enhancement_update_dbg_out_config(void *sp_enh_context, afe_usb_settings_t *pMY_AFE_USB_SETTINGS)
+cy_rslt_t afe_speech_enhancement_update_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *pMY_AFE_USB_SETTINGS)
 {
     cy_rslt_t result;
     unsigned int ifx_out_locator_index = 0;
-    cy_sp_enh_handle* sp_enh_handle = (cy_sp_enh_handle* )sp_enh_context;
+    cy_sp_enh_handle* sp_enh_handle = (cy_sp_enh_handle* )context->sp_enh_context;
+    int32_t *ifx_out_locator = context->ifx_out_locator;
 
     cy_sp_enh_configure_dbg_out(sp_enh_handle, IFX_SP_ENH_IP_COMPONENT_INVALID, false);
-    memset(ifx_out_locator,0xFF,sizeof(ifx_out_locator));
+    memset(ifx_out_locator,0xFF,sizeof(context->ifx_out_locator));
 
     //printf("\r\nMicAddr: %p, %d\r\n",
     //		&sp_enh_handle->sp_enh_info.common.num_mics,
@@ -812,13 +1211,243 @@ cy_rslt_t afe_speech_enhancement_update_dbg_out_config(void *sp_enh_context, afe
     return CY_RSLT_SUCCESS;
 }
 
+cy_rslt_t afe_speech_enhancement_set_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *usb_settings)
+{
+    cy_rslt_t result;
+    afe_tuner_params_update_t *update = NULL;
+
+    cy_rtos_mutex_get(&context->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
+    update = afe_sp_params_begin(context);
+    update->usb_settings_valid = true;
+    update->usb_settings = *usb_settings;
+    result = afe_sp_params_end(context, update);
+    cy_rtos_mutex_set(&context->audio_tuner_mutex);
+
+    return result;
+}
+
+void afe_speech_enhancement_get_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *usb_settings)
+{
+    afe_tuner_params_snapshot_t snapshot;
+
+    afe_sp_snapshot_read(context, &snapshot);
+    *usb_settings = snapshot.usb_settings;
+}
+
+void afe_speech_enhancement_get_tuner_stats(afe_internal_context_t *context, cy_afe_tuner_stats_t *stats)
+{
+    afe_tuner_params_snapshot_t snapshot;
+
+    afe_sp_snapshot_read(context, &snapshot);
+    *stats = snapshot.stats;
+}
+
+void afe_speech_enhancement_get_all_params(afe_internal_context_t *context, afe_tuner_params_snapshot_t *snapshot)
+{
+    afe_sp_snapshot_read(context, snapshot);
+}
+
+cy_rslt_t afe_speech_enhancement_begin_params_transaction(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    cy_rtos_mutex_get(&context->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
+    if(true == context->params_transaction_open)
+    {
+        result = CY_RSLT_AFE_TUNER_INALID_CMD;
+    }
+    else
+    {
+        memset(&context->params_transaction, 0, sizeof(afe_tuner_params_update_t));
+        context->params_transaction_open = true;
+    }
+    cy_rtos_mutex_set(&context->audio_tuner_mutex);
+
+    return result;
+}
+
+cy_rslt_t afe_speech_enhancement_commit_params_transaction(afe_internal_context_t *context)
+{
+    afe_tuner_params_update_t *transaction = &context->params_transaction;
+    afe_tuner_params_update_t *update = NULL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index = 0;
+
+    cy_rtos_mutex_get(&context->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
+    if(false == context->params_transaction_open)
+    {
+        result = CY_RSLT_AFE_TUNER_INALID_CMD;
+        goto CLEAN_RETURN;
+    }
+    context->params_transaction_open = false;
+
+    if((0 == transaction->enable_mask) && (0 == transaction->value_mask) && (false == transaction->usb_settings_valid))
+    {
+        goto CLEAN_RETURN;
+    }
+
+    /* Merged over any update still staged, the transaction settings win */
+    update = afe_sp_params_stage(context);
+    update->enable_value = (update->enable_value & ~transaction->enable_mask) | (transaction->enable_value & transaction->enable_mask);
+    update->enable_mask |= transaction->enable_mask;
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        if(0 != (transaction->value_mask & (1u << index)))
+        {
+            update->value[index] = transaction->value[index];
+        }
+    }
+    update->value_mask |= transaction->value_mask;
+    if(true == transaction->usb_settings_valid)
+    {
+        update->usb_settings_valid = true;
+        update->usb_settings = transaction->usb_settings;
+    }
+    update->atomic = true;
+
+    result = afe_sp_params_commit(context, update);
+
+CLEAN_RETURN:
+    cy_rtos_mutex_set(&context->audio_tuner_mutex);
+    return result;
+}
+
+void afe_speech_enhancement_abort_params_transaction(afe_internal_context_t *context)
+{
+    cy_rtos_mutex_get(&context->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
+    context->params_transaction_open = false;
+    cy_rtos_mutex_set(&context->audio_tuner_mutex);
+}
+
+void afe_speech_enhancement_refresh_params(afe_internal_context_t *context)
+{
+    afe_tuner_component_params_t params;
+    uint32_t index = 0;
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        afe_sp_read_component(context, afe_sp_params_components[index], &params);
+        afe_sp_snapshot_write_begin(context);
+        context->params_snapshot.component[index] = params;
+        afe_sp_snapshot_write_end(context);
+    }
+
+    afe_sp_snapshot_write_begin(context);
+    context->params_snapshot.usb_settings = context->usb_settings;
+    afe_sp_snapshot_write_end(context);
+}
+
+void afe_speech_enhancement_apply_params(afe_internal_context_t *context)
+{
+    uint_fast32_t pending = atomic_exchange_explicit(&context->params_pending, 0, memory_order_acquire);
+    afe_tuner_params_update_t *update = NULL;
+    afe_tuner_component_params_t params;
+    cy_afe_tuner_stats_t *stats = &context->params_snapshot.stats;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_rslt_t component_result = CY_RSLT_SUCCESS;
+    int32_t comp_value[2] = {0};
+    cy_time_t now = 0;
+    uint32_t latency_ms = 0;
+    uint32_t index = 0;
+
+    if(0 == pending)
+    {
+        return;
+    }
+    update = &context->params_update[pending - 1];
+
+    if(NULL == context->sp_enh_context)
+    {
+        result = CY_RSLT_AFE_SYSTEM_MODULE_ERROR;
+        goto APPLIED;
+    }
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        if(0 != (update->enable_mask & (1u << index)))
+        {
+            component_result = cy_sp_enh_enable_disable_component(context->sp_enh_context, afe_sp_params_components[index],
+                    (0 != (update->enable_value & (1u << index))));
+            if(CY_RSLT_SUCCESS == result)
+            {
+                result = afe_sp_tuner_result(component_result);
+            }
+        }
+    }
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        if(0 != (update->value_mask & (1u << index)))
+        {
+            comp_value[0] = update->value[index];
+            comp_value[1] = update->value[index];
+            component_result = cy_sp_enh_update_config_value(context->sp_enh_context, afe_sp_params_components[index], comp_value);
+            if(CY_RSLT_SUCCESS == result)
+            {
+                result = afe_sp_tuner_result(component_result);
+            }
+        }
+    }
+
+    if((CY_RSLT_SUCCESS != result) && (true == update->atomic))
+    {
+        /* Library rejected a setting of the transaction, none of them is kept */
+        cy_afe_log_err(result, "Tuner transaction %"PRIu32" rejected, settings restored", update->sequence);
+        afe_sp_params_restore(context, update);
+    }
+    else if(true == update->usb_settings_valid)
+    {
+        afe_speech_enhancement_update_dbg_out_config(context, &update->usb_settings);
+        context->usb_settings = update->usb_settings;
+    }
+
+    /* Updated components are read back for the tuner */
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        if(0 != ((update->enable_mask | update->value_mask) & (1u << index)))
+        {
+            afe_sp_read_component(context, afe_sp_params_components[index], &params);
+            afe_sp_snapshot_write_begin(context);
+            context->params_snapshot.component[index] = params;
+            afe_sp_snapshot_write_end(context);
+        }
+    }
+
+APPLIED:
+    cy_rtos_get_time(&now);
+    latency_ms = (uint32_t)(now - update->staged_time);
+
+    afe_sp_snapshot_write_begin(context);
+    context->params_snapshot.usb_settings = context->usb_settings;
+    stats->updates_applied++;
+    stats->last_apply_latency_ms = latency_ms;
+    if(latency_ms > stats->max_apply_latency_ms)
+    {
+        stats->max_apply_latency_ms = latency_ms;
+    }
+    afe_sp_snapshot_write_end(context);
+
+    cy_afe_log_dbg("Tuner update %"PRIu32" applied after %"PRIu32" ms", update->sequence, latency_ms);
+
+    context->params_apply_result = result;
+    atomic_store_explicit(&context->params_applied_sequence, update->sequence, memory_order_release);
+    cy_rtos_set_semaphore(&context->params_applied_semaphore, false);
+}
+
+void afe_speech_enhancement_publish_meter(afe_internal_context_t *context)
+{
+    afe_sp_snapshot_write_begin(context);
+    memcpy(context->params_snapshot.audio_meter, context->audio_meter, sizeof(context->audio_meter));
+    afe_sp_snapshot_write_end(context);
+}
+
 cy_rslt_t afe_speech_enhancement_get_sound_meter(void *context, int16_t *audio_meter)
 {
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_params_snapshot_t snapshot;
 
-    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    memcpy(audio_meter, AUDIO_METER,  sizeof(AUDIO_METER));
-    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
+    afe_sp_snapshot_read(handle, &snapshot);
+    memcpy(audio_meter, snapshot.audio_meter, sizeof(snapshot.audio_meter));
 
     return CY_RSLT_SUCCESS;
 }
@@ -828,13 +1457,10 @@ cy_rslt_t afe_speech_enhancement_get_component_params(void *context, ifx_sp_enh_
 {
     cy_rslt_t result = CY_RSLT_AFE_GENERIC_ERROR;
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
-    hpf_settings_struct_t hpf_pt;
-    aec_settings_struct_t aec_pt;
-    bf_settings_struct_t bf_pt;
-    es_settings_struct_t es_pt;
-    ns_settings_struct_t ns_pt;
-    dsns_settings_struct_t dsns_pt;
-    void * value_struct_pt = NULL;
+    afe_tuner_params_snapshot_t snapshot;
+    afe_tuner_component_params_t *params = NULL;
+    int32_t min_count = 0;
+    int32_t index = 0;
 
     if((NULL == value) || (NULL == value_count))
     {
@@ -852,73 +1478,19 @@ cy_rslt_t afe_speech_enhancement_get_component_params(void *context, ifx_sp_enh_
 
     switch (component_name)
     {
-        case IFX_SP_ENH_IP_COMPONENT_HPF:
-        {
-            if(*value_count < 1)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &hpf_pt;
-        }
-        break;
         case IFX_SP_ENH_IP_COMPONENT_AEC:
-        {
-            if(*value_count < 2)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &aec_pt;
-        }
-        break;
+            min_count = 2;
+            break;
         case IFX_SP_ENH_IP_COMPONENT_BF:
-        {
-            if(*value_count < 5)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &bf_pt;
-        }
-        break;
+            min_count = 5;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_HPF:
         case IFX_SP_ENH_IP_COMPONENT_ES:
         case IFX_SP_ENH_IP_COMPONENT_DSES:
-        {
-            if(*value_count < 1)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &es_pt;
-        }
-        break;
         case IFX_SP_ENH_IP_COMPONENT_DSNS:
-        {
-            if(*value_count < 1)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &dsns_pt;
-        }
-        break;
         case IFX_SP_ENH_IP_COMPONENT_NS:
-        {
-            if(*value_count < 1)
-            {
-                result = CY_RSLT_AFE_BAD_ARG;
-                cy_afe_log_err(result, "Invalid value count:%"PRIu32, *value_count);
-                return result;
-            }
-            value_struct_pt = &ns_pt;
-        }
-        break;
+            min_count = 1;
+            break;
         default: /* Other cases do nothing */
         {
             CY_SP_PRINTF("Invalid get config component:%d\r\n",component_name);
@@ -927,75 +1499,30 @@ cy_rslt_t afe_speech_enhancement_get_component_params(void *context, ifx_sp_enh_
             break;
     }
 
-    cy_rtos_mutex_get(&handle->audio_tuner_mutex,CY_RTOS_NEVER_TIMEOUT);
-    result =  cy_sp_enh_get_config_value(handle->sp_enh_context,component_name,value_struct_pt);
-    cy_rtos_mutex_set(&handle->audio_tuner_mutex);
-    if(result != CY_RSLT_SUCCESS)
+    if(*value_count < min_count)
     {
-        cy_afe_log_err(result, "Failed to update config value");
-        if(result == CY_RSLT_INVALID_PARAMS)
-        {
-            result = CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
-        }
-        else
-        {
-            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
-        }
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid value count:%"PRIi32, *value_count);
+        return result;
     }
 
-    switch (component_name)
+    index = afe_sp_params_index(component_name);
+    if(index < 0)
     {
-        case IFX_SP_ENH_IP_COMPONENT_HPF:
-        {
-            value[0] = hpf_pt.cutoff_freq_hz;
-            *value_count = 1;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_AEC:
-        {
-            value[0] = aec_pt.bulk_delay_msec;
-            value[1] = aec_pt.tail_len_msec;
-            *value_count = 2;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_BF:
-        {
-            value[0] = bf_pt.aggressiveness;
-            value[1] = bf_pt.mic_distance_mm;  /* mic distance in mm unit */
-            value[2] = bf_pt.num_beams;        /* number of beams */
-            value[3] = bf_pt.angle_range_start;/* start angle range in degree */
-            value[4] = bf_pt.angle_range_stop; /* end angle range in degree */
-            *value_count = 5;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_ES:
-        case IFX_SP_ENH_IP_COMPONENT_DSES:
-        {
-            value[0] = es_pt.aggressiveness;
-            *value_count = 1;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_NS:
-        {
-            value[0] = ns_pt.ns_gain_dB;
-            *value_count = 1;
-        }
-        break;
-        case IFX_SP_ENH_IP_COMPONENT_DSNS:
-        {
-            value[0] = dsns_pt.ns_gain_dB;
-            *value_count = 1;
-        }
-        break;
-        default: /* Other cases do nothing */
-        {
-            result = CY_RSLT_BAD_ARG;
-            cy_afe_log_err(result,"Invalid get config component:%d",component_name);
-            return result;
-        }
-        break;
+        return CY_RSLT_BAD_ARG;
     }
 
+    afe_sp_snapshot_read(handle, &snapshot);
+    params = &snapshot.component[index];
+    result = afe_sp_tuner_result(params->params_result);
+    if(result != CY_RSLT_SUCCESS)
+    {
+        cy_afe_log_err(result, "Failed to update config value");
+    }
+
+    memcpy(value, params->values, params->value_count * sizeof(int32_t));
+    *value_count = params->value_count;
+
     return result;
 }
 #endif
@@ -43,6 +43,10 @@
 #include "cyabs_rtos.h"
 #include "cy_afe_audio_task.h"
 #include "cy_afe_audio_process.h"
+#include "cy_afe_audio_memory.h"
+#include "cy_afe_audio_dispatch.h"
+#include "cy_afe_audio_dsp.h"
+#include "cy_afe_audio_format.h"
 #include "cyabs_rtos_internal.h"
 /******************************************************
  *                     Macros
@@ -61,6 +65,10 @@
 #define AFE_AUDIO_PROCESSING_MSG_QUEUE_SIZE              (30)
 #endif
 
+/* Input frame followed by AEC reference frame, rounded up to keep every copy 16 byte aligned */
+#define AFE_INPUT_COPY_FRAME_SIZE(context)               \
+    (((context)->input_frame_size + (context)->mono_frame_size + 15u) & ~15u)
+
 /******************************************************
  *                    Constants
  ******************************************************/
@@ -87,32 +95,247 @@
 
 static void afe_audio_processing_task(cy_thread_arg_t arg);
 static cy_rslt_t afe_pop_audio_data_from_queue(afe_internal_context_t *context);
+static void afe_fill_queue_item(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr);
+static cy_rslt_t afe_make_room_in_queue(afe_internal_context_t *context, uint32_t num_frames, uint32_t num_copies);
+static void afe_update_queue_depth(afe_internal_context_t *context);
+static void afe_notify_discarded_frames(afe_internal_context_t *context);
+static cy_rslt_t afe_copy_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item);
+static void afe_release_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item);
+static cy_rslt_t afe_queue_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item);
+static cy_rslt_t afe_queue_input_batch(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames);
+static cy_rslt_t afe_setup_input_queue(afe_internal_context_t *context);
+static cy_rslt_t afe_setup_input_ring(afe_internal_context_t *context);
+static void afe_cleanup_input(afe_internal_context_t *context);
+static cy_rslt_t afe_process_input_ring(afe_internal_context_t *context);
+static cy_rslt_t afe_process_frame_in_caller(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, cy_afe_buffer_info_t *output_info,
+        bool mutex_held);
 
 /******************************************************
  *               Functions
  ******************************************************/
 /**
- * Creates AFE processing queue & thread
+ * Creates AFE input queue, and input pool or discard queue based on the configuration
  */
-cy_rslt_t afe_setup_audio_processing_task(afe_internal_context_t *context)
+static cy_rslt_t afe_setup_input_queue(afe_internal_context_t *context)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t queue_size = context->config_init.input_queue_size;
+
+    if (0 == queue_size)
+    {
+        queue_size = AFE_AUDIO_PROCESSING_MSG_QUEUE_SIZE;
+    }
 
-    cy_afe_log_dbg("Initializing audio processing queue");
+    cy_afe_log_dbg("Initializing audio processing queue of size %"PRIu32, queue_size);
 
     /*
      * Initialize AFE audio processing queue
      */
-    result = cy_rtos_init_queue(&context->audio_processing_queue,
-            AFE_AUDIO_PROCESSING_MSG_QUEUE_SIZE, sizeof(afe_queue_data_item_t));
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+            afe_ring_buffer_size(sizeof(afe_queue_data_item_t), queue_size),
+            &context->audio_processing_queue_buffer);
     if (CY_RSLT_SUCCESS != result)
     {
-        cy_afe_log_err(result, "cy_rtos_init_queue failed");
+        cy_afe_log_err(result, "Failed to allocate audio processing queue");
+        return result;
+    }
+
+    result = afe_ring_init(&context->audio_processing_queue, context->audio_processing_queue_buffer,
+            sizeof(afe_queue_data_item_t), queue_size);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "afe_ring_init failed");
         goto CLEAN_RETURN;
     }
 
     cy_afe_log_dbg("Audio processing queue initialized");
 
+    /*
+     * In copy mode, input and AEC reference are copied to the input pool at feed time.
+     * Two frames more than the queue size are needed, for the frame being processed and
+     * for the frame being gathered by cy_afe_feed_samples.
+     */
+    if (CY_AFE_INPUT_MODE_COPY == context->config_init.input_mode)
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                afe_pool_buffer_size(AFE_INPUT_COPY_FRAME_SIZE(context), queue_size + 2),
+                &context->input_pool_buffer);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to allocate input pool");
+            goto CLEAN_RETURN;
+        }
+
+        result = afe_pool_init(&context->input_pool, context->input_pool_buffer,
+                AFE_INPUT_COPY_FRAME_SIZE(context), queue_size + 2);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "afe_pool_init failed for input pool");
+            goto CLEAN_RETURN;
+        }
+    }
+
+    /*
+     * Frames dropped from the head of the queue are handed over to the audio processing
+     * task through the discard queue, so that output callback can be invoked for them.
+     * Copied frames are owned by AFE and are released right away instead.
+     */
+    if (CY_AFE_OVERLOAD_POLICY_DROP_OLDEST == context->config_init.overload_policy &&
+        CY_AFE_INPUT_MODE_COPY != context->config_init.input_mode)
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                afe_ring_buffer_size(sizeof(afe_queue_data_item_t), queue_size),
+                &context->discard_queue_buffer);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to allocate discard queue");
+            goto CLEAN_RETURN;
+        }
+
+        result = afe_ring_init(&context->discard_queue, context->discard_queue_buffer,
+                sizeof(afe_queue_data_item_t), queue_size);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "afe_ring_init failed for discard queue");
+            goto CLEAN_RETURN;
+        }
+    }
+
+    return CY_RSLT_SUCCESS;
+
+CLEAN_RETURN:
+    afe_cleanup_input(context);
+    return result;
+}
+
+/**
+ * Prepare reading the frames in place from the input ring registered by application
+ */
+static cy_rslt_t afe_setup_input_ring(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t size_in_samples = context->config_init.input_ring.size_in_samples;
+
+    cy_afe_log_dbg("Initializing input ring of %"PRIu32" samples", size_in_samples);
+
+    atomic_init(&context->input_ring_pending, 0);
+    context->input_ring_read_index = 0;
+
+    /* Frames crossing the end of the ring are assembled in a separate frame */
+    if (0 != (size_in_samples % context->frame_samples))
+    {
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                context->input_frame_size + context->mono_frame_size,
+                (void **)&context->input_ring_wrap_buffer);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "Failed to allocate input ring wrap buffer");
+            return result;
+        }
+    }
+
+    result = cy_rtos_init_semaphore(&context->input_ring_semaphore, 1, 0);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "cy_rtos_init_semaphore failed for input ring");
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_ring_wrap_buffer);
+        context->input_ring_wrap_buffer = NULL;
+        return result;
+    }
+
+    cy_afe_log_dbg("Input ring initialized");
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Release the input queues, input pool and input ring resources
+ */
+static void afe_cleanup_input(afe_internal_context_t *context)
+{
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        cy_rtos_deinit_semaphore(&context->input_ring_semaphore);
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_ring_wrap_buffer);
+        context->input_ring_wrap_buffer = NULL;
+        return;
+    }
+
+    afe_ring_deinit(&context->discard_queue);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->discard_queue_buffer);
+    context->discard_queue_buffer = NULL;
+    afe_pool_deinit(&context->input_pool);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_pool_buffer);
+    context->input_pool_buffer = NULL;
+    afe_ring_deinit(&context->audio_processing_queue);
+    afe_memory_free(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->audio_processing_queue_buffer);
+    context->audio_processing_queue_buffer = NULL;
+}
+
+/**
+ * Add the input queue, input pool, discard queue or input ring wrap buffer to the memory required by the instance
+ */
+void afe_require_audio_processing_memory(afe_internal_context_t *context)
+{
+    uint32_t queue_size = context->config_init.input_queue_size;
+
+    if (CY_AFE_PROCESSING_MODE_SYNC == context->config_init.processing_mode)
+    {
+        return;
+    }
+
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        if (0 != (context->config_init.input_ring.size_in_samples % context->frame_samples))
+        {
+            afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE, context->input_frame_size + context->mono_frame_size);
+        }
+        return;
+    }
+
+    if (0 == queue_size)
+    {
+        queue_size = AFE_AUDIO_PROCESSING_MSG_QUEUE_SIZE;
+    }
+
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+            afe_ring_buffer_size(sizeof(afe_queue_data_item_t), queue_size));
+    if (CY_AFE_INPUT_MODE_COPY == context->config_init.input_mode)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                afe_pool_buffer_size(AFE_INPUT_COPY_FRAME_SIZE(context), queue_size + 2));
+    }
+    else if (CY_AFE_OVERLOAD_POLICY_DROP_OLDEST == context->config_init.overload_policy)
+    {
+        afe_memory_require(context, CY_AFE_MEM_ID_AFE_INPUT_QUEUE,
+                afe_ring_buffer_size(sizeof(afe_queue_data_item_t), queue_size));
+    }
+}
+
+/**
+ * Creates AFE processing queue & thread
+ */
+cy_rslt_t afe_setup_audio_processing_task(afe_internal_context_t *context)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        result = afe_setup_input_ring(context);
+    }
+    else
+    {
+        result = afe_setup_input_queue(context);
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
     context->audio_processing_thread_running = true;
 
     cy_afe_log_dbg("Creating audio processing task");
@@ -133,12 +356,8 @@ cy_rslt_t afe_setup_audio_processing_task(afe_internal_context_t *context)
     return CY_RSLT_SUCCESS;
 
 CLEAN_RETURN:
-    if (true == context->audio_processing_thread_running)
-    {
-        cy_rtos_deinit_queue(&context->audio_processing_queue);
-        cy_rtos_terminate_thread(&context->audio_processing_thread);
-        context->audio_processing_thread_running = false;
-    }
+    context->audio_processing_thread_running = false;
+    afe_cleanup_input(context);
 
     return result;
 
@@ -159,7 +378,14 @@ static void afe_audio_processing_task(cy_thread_arg_t arg)
 
     while (true == context->audio_processing_thread_running)
     {
-        afe_pop_audio_data_from_queue(context);
+        if (NULL != context->config_init.input_ring.input_buffer)
+        {
+            afe_process_input_ring(context);
+        }
+        else
+        {
+            afe_pop_audio_data_from_queue(context);
+        }
     }
 
     cy_afe_log_dbg("Exiting from audio processing task routine");
@@ -194,12 +420,7 @@ cy_rslt_t afe_cleanup_audio_processing_task(afe_internal_context_t *context)
         context->audio_processing_thread_running = false;
     }
 
-    result = cy_rtos_deinit_queue(&context->audio_processing_queue);
-    if (CY_RSLT_SUCCESS != result)
-    {
-        cy_afe_log_err(result, "cy_rtos_deinit_queue failed");
-        return result;
-    }
+    afe_cleanup_input(context);
 
     cy_afe_log_dbg("Audio processing queue de-initialized successfully");
 
@@ -214,7 +435,7 @@ static cy_rslt_t afe_pop_audio_data_from_queue(afe_internal_context_t *context)
     cy_rslt_t result = CY_RSLT_SUCCESS;
     afe_queue_data_item_t afe_queue_item;
 
-    result = cy_rtos_get_queue(&context->audio_processing_queue, &afe_queue_item, CY_RTOS_NEVER_TIMEOUT, false);
+    result = afe_ring_pop(&context->audio_processing_queue, &afe_queue_item, CY_RTOS_NEVER_TIMEOUT);
     if(CY_RSLT_SUCCESS != result)
     {
         cy_afe_log_err(result, "Failed to pop message from queue");
@@ -222,50 +443,431 @@ static cy_rslt_t afe_pop_audio_data_from_queue(afe_internal_context_t *context)
     }
     else
     {
-        return afe_process_audio_data(context, &afe_queue_item);
+        /* Frames dropped before the popped frame are notified first. Callbacks are invoked with
+         * process_mutex held, so they never interleave with a frame processed in the caller.
+         */
+        cy_rtos_mutex_get(&context->process_mutex, CY_RTOS_NEVER_TIMEOUT);
+        afe_notify_discarded_frames(context);
+        result = afe_process_audio_data_locked(context, &afe_queue_item, NULL);
+        cy_rtos_mutex_set(&context->process_mutex);
+
+        afe_release_input_frame(context, &afe_queue_item);
+        atomic_fetch_sub_explicit(&context->frames_pending, 1, memory_order_release);
+        return result;
     }
 }
 
 /**
- * Push input audio data to AFE thread queue for processing
+ * Wait for complete frames in the input ring and process them in place
  */
-cy_rslt_t afe_push_audio_data_to_queue(afe_internal_context_t *context,
-        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr)
+static cy_rslt_t afe_process_input_ring(afe_internal_context_t *context)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_afe_input_ring_t *ring = &context->config_init.input_ring;
     afe_queue_data_item_t afe_data_item;
+    CY_AFE_DATA_T *input_ptr = NULL;
+    CY_AFE_DATA_T *aec_ref_ptr = NULL;
+    uint32_t pending = 0;
+    uint32_t max_pending = ring->size_in_samples - context->frame_samples;
+    uint32_t first_part = 0;
+    uint32_t channel = 0;
 
-    if (NULL == context || NULL == input_audio_data_ptr) {
-        result = CY_RSLT_AFE_BAD_ARG;
-        cy_afe_log_err_on_no_isr(result,
-                "Invalid argument. context: [%p], item : [%p]", context,
-                input_audio_data_ptr);
+    result = cy_rtos_get_semaphore(&context->input_ring_semaphore, CY_RTOS_NEVER_TIMEOUT, false);
+    if (CY_RSLT_SUCCESS != result)
+    {
         return result;
     }
 
-    memset(&afe_data_item, 0, sizeof(afe_queue_data_item_t));
+    pending = atomic_load_explicit(&context->input_ring_pending, memory_order_acquire);
+    while (pending >= context->frame_samples)
+    {
+        /* Frames the driver is about to overwrite are skipped, the next frame is read while it is stable */
+        while (pending > max_pending)
+        {
+            context->input_ring_read_index = (context->input_ring_read_index + context->frame_samples) % ring->size_in_samples;
+            pending = atomic_fetch_sub_explicit(&context->input_ring_pending, context->frame_samples,
+                    memory_order_relaxed) - context->frame_samples;
+            afe_update_stats(context, AFE_FRAME_DROP_OLDEST_COUNT);
+        }
+
+        if (pending / context->frame_samples > context->overload_stats.max_queue_depth)
+        {
+            context->overload_stats.max_queue_depth = pending / context->frame_samples;
+        }
+
+        first_part = ring->size_in_samples - context->input_ring_read_index;
+        if (first_part >= context->frame_samples)
+        {
+            /* Channel-2 is found one ring size after channel-1, refer afe_process_audio_data */
+            input_ptr = ring->input_buffer + context->input_ring_read_index;
+            aec_ref_ptr = (NULL == ring->aec_ref_buffer) ? NULL : ring->aec_ref_buffer + context->input_ring_read_index;
+        }
+        else
+        {
+            input_ptr = (CY_AFE_DATA_T *)context->input_ring_wrap_buffer;
+            for (channel = 0; channel < context->num_channels; channel++)
+            {
+                afe_dsp_copy(input_ptr + (channel * context->frame_samples),
+                        ring->input_buffer + (channel * ring->size_in_samples) + context->input_ring_read_index,
+                        first_part * sizeof(CY_AFE_DATA_T));
+                afe_dsp_copy(input_ptr + (channel * context->frame_samples) + first_part,
+                        ring->input_buffer + (channel * ring->size_in_samples),
+                        (context->frame_samples - first_part) * sizeof(CY_AFE_DATA_T));
+            }
+
+            aec_ref_ptr = NULL;
+            if (NULL != ring->aec_ref_buffer)
+            {
+                aec_ref_ptr = (CY_AFE_DATA_T *)(context->input_ring_wrap_buffer + context->input_frame_size);
+                afe_dsp_copy(aec_ref_ptr, ring->aec_ref_buffer + context->input_ring_read_index,
+                        first_part * sizeof(CY_AFE_DATA_T));
+                afe_dsp_copy(aec_ref_ptr + first_part, ring->aec_ref_buffer,
+                        (context->frame_samples - first_part) * sizeof(CY_AFE_DATA_T));
+            }
+        }
+
+        afe_fill_queue_item(context, &afe_data_item, input_ptr, aec_ref_ptr);
+        result = afe_process_audio_data(context, &afe_data_item, NULL);
+
+        context->input_ring_read_index = (context->input_ring_read_index + context->frame_samples) % ring->size_in_samples;
+        pending = atomic_fetch_sub_explicit(&context->input_ring_pending, context->frame_samples,
+                memory_order_acq_rel) - context->frame_samples;
+    }
+
+    return result;
+}
+
+/**
+ * Account new samples written by the driver to the input ring and wake up the audio processing task
+ */
+cy_rslt_t afe_notify_input_ring_samples(afe_internal_context_t *context, uint32_t num_samples)
+{
+    uint32_t pending = 0;
+
+    if (NULL == context->config_init.input_ring.input_buffer)
+    {
+        return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+    }
+
+    pending = atomic_fetch_add_explicit(&context->input_ring_pending, num_samples, memory_order_release);
+
+    /* Task is busy with earlier frames unless this notification completes the first pending frame */
+    if (pending < context->frame_samples && (pending + num_samples) >= context->frame_samples)
+    {
+        cy_rtos_set_semaphore(&context->input_ring_semaphore, is_in_isr());
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Number of input frames waiting to be processed
+ */
+uint32_t afe_get_pending_input_frames(afe_internal_context_t *context)
+{
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        return (uint32_t)atomic_load_explicit(&context->input_ring_pending, memory_order_relaxed) / context->frame_samples;
+    }
+
+    return afe_ring_count(&context->audio_processing_queue);
+}
+
+/**
+ * Invoke output callback for the frames dropped by CY_AFE_OVERLOAD_POLICY_DROP_OLDEST
+ * so that application can release their input and AEC reference buffers, with process_mutex held
+ */
+static void afe_notify_discarded_frames(afe_internal_context_t *context)
+{
+    afe_queue_data_item_t afe_queue_item;
+    cy_afe_buffer_info_t afe_output_info;
+
+    if (NULL == context->discard_queue_buffer)
+    {
+        return;
+    }
+
+    while (CY_RSLT_SUCCESS == afe_ring_pop(&context->discard_queue, &afe_queue_item, 0))
+    {
+        memset(&afe_output_info, 0, sizeof(afe_output_info));
+        afe_output_info.input_buf = afe_queue_item.input_data_ptr;
+        afe_output_info.input_aec_ref_buf = afe_queue_item.aec_ref_ptr;
+
+        afe_dispatch_output(context, &afe_output_info);
+    }
+}
+
+/**
+ * Make room for num_frames in the audio processing queue as per the overload policy. num_copies
+ * of the frames are to be copied to the input pool once room is made.
+ */
+static cy_rslt_t afe_make_room_in_queue(afe_internal_context_t *context, uint32_t num_frames, uint32_t num_copies)
+{
+    afe_ring_t *queue = &context->audio_processing_queue;
+    afe_queue_data_item_t dropped_item;
+    cy_rslt_t result = CY_RSLT_AFE_QUEUE_FULL;
+    cy_time_t start_time = 0;
+    cy_time_t end_time = 0;
+    uint32_t frame = 0;
+    uint32_t free_slots = afe_ring_free_count(queue);
+
+    if (free_slots >= num_frames)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (num_frames <= queue->capacity)
+    {
+        switch (context->config_init.overload_policy)
+        {
+            case CY_AFE_OVERLOAD_POLICY_BLOCK:
+            {
+                /* ISR can not wait, frame is dropped instead */
+                if (is_in_isr())
+                {
+                    break;
+                }
+
+                afe_update_stats(context, AFE_FRAME_BLOCK_COUNT);
+
+                cy_rtos_get_time(&start_time);
+                result = afe_ring_wait_for_space(queue, num_frames, context->config_init.overload_block_timeout_ms);
+                cy_rtos_get_time(&end_time);
+
+                if ((uint32_t)(end_time - start_time) > context->overload_stats.max_block_time_ms)
+                {
+                    context->overload_stats.max_block_time_ms = (uint32_t)(end_time - start_time);
+                }
+
+                if (CY_RSLT_SUCCESS != result)
+                {
+                    afe_update_stats(context, AFE_FRAME_BLOCK_TIMEOUT_COUNT);
+                    result = CY_RSLT_AFE_QUEUE_FULL;
+                }
+                break;
+            }
+
+            case CY_AFE_OVERLOAD_POLICY_DROP_OLDEST:
+            {
+                /* Nothing is dropped unless the copies can be taken afterwards, else one overflow would lose
+                 * the oldest frames and the new ones. Dropped frames of the input pool are returned to it.
+                 */
+                if (0 != num_copies &&
+                    afe_pool_free_count(&context->input_pool) + (num_frames - free_slots) < num_copies)
+                {
+                    break;
+                }
+
+                result = CY_RSLT_SUCCESS;
+                while (afe_ring_free_count(queue) < num_frames)
+                {
+                    /* Frame which can not be notified to application is not dropped, new frame is rejected instead */
+                    if (NULL != context->discard_queue_buffer && 0 == afe_ring_free_count(&context->discard_queue))
+                    {
+                        result = CY_RSLT_AFE_QUEUE_FULL;
+                        break;
+                    }
+
+                    /* Input and AEC reference are dropped together, so both stay aligned for the next frames */
+                    if (afe_ring_drop_oldest(queue, &dropped_item))
+                    {
+                        if (NULL != context->discard_queue_buffer)
+                        {
+                            afe_ring_push(&context->discard_queue, &dropped_item);
+                        }
+                        else
+                        {
+                            afe_release_input_frame(context, &dropped_item);
+                        }
+                        atomic_fetch_sub_explicit(&context->frames_pending, 1, memory_order_relaxed);
+                        afe_update_stats(context, AFE_FRAME_DROP_OLDEST_COUNT);
+                    }
+                }
+                break;
+            }
+
+            case CY_AFE_OVERLOAD_POLICY_DROP_NEWEST:
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        for (frame = 0; frame < num_frames; frame++)
+        {
+            afe_update_stats(context, AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT);
+        }
+        cy_afe_log_err_on_no_isr(result, "No space in audio processing queue for %"PRIu32" frames", num_frames);
+    }
+
+    return result;
+}
+
+/**
+ * Track the highest number of frames queued
+ */
+static void afe_update_queue_depth(afe_internal_context_t *context)
+{
+    uint32_t queue_depth = afe_ring_count(&context->audio_processing_queue);
+
+    if (queue_depth > context->overload_stats.max_queue_depth)
+    {
+        context->overload_stats.max_queue_depth = queue_depth;
+    }
+}
+
+/**
+ * Copy input and AEC reference of the queue item to a frame of the input pool,
+ * so that application can reuse its buffers once feed returns
+ */
+static cy_rslt_t afe_copy_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t *frame = NULL;
+
+    /* Frames gathered by cy_afe_feed_samples are already in the input pool */
+    if (NULL == context->input_pool_buffer || afe_pool_owns(&context->input_pool, afe_data_item->input_data_ptr))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    result = afe_pool_acquire(&context->input_pool, 0, (void **)&frame);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        afe_update_stats(context, AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT);
+        cy_afe_log_err_on_no_isr(result, "No free frame in input pool");
+        return CY_RSLT_AFE_QUEUE_FULL;
+    }
+
+    /* Input in the application layout and sample format is converted in the same pass as the copy */
+    if (true == afe_data_item->app_format)
+    {
+        afe_format_input(context, afe_data_item->input_data_ptr, context->frame_samples, 0, (CY_AFE_DATA_T *)frame, 0,
+                context->frame_samples);
+        if (NULL != afe_data_item->aec_ref_ptr)
+        {
+            afe_format_aec_ref(context, afe_data_item->aec_ref_ptr, context->frame_samples, 0,
+                    (CY_AFE_DATA_T *)(frame + context->input_frame_size), context->frame_samples);
+        }
+        afe_data_item->app_format = false;
+#ifdef CY_AFE_ENABLE_CRC_CHECK
+        afe_data_item->crc_value = afe_get_crc_checksum_val(context, (CY_AFE_DATA_T *)frame);
+#endif
+    }
+    else
+    {
+        afe_dsp_copy(frame, afe_data_item->input_data_ptr, context->input_frame_size);
+        if (NULL != afe_data_item->aec_ref_ptr)
+        {
+            afe_dsp_copy(frame + context->input_frame_size, afe_data_item->aec_ref_ptr, context->mono_frame_size);
+        }
+    }
+    afe_data_item->input_data_ptr = (CY_AFE_DATA_T *)frame;
+    if (NULL != afe_data_item->aec_ref_ptr)
+    {
+        afe_data_item->aec_ref_ptr = (CY_AFE_DATA_T *)(frame + context->input_frame_size);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Return the input pool frame of the queue item, if it was copied at feed time
+ */
+static void afe_release_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item)
+{
+    if (afe_pool_owns(&context->input_pool, afe_data_item->input_data_ptr))
+    {
+        afe_pool_release(&context->input_pool, afe_data_item->input_data_ptr);
+    }
+}
+
+/**
+ * Fill the queue item for the input audio data
+ */
+static void afe_fill_queue_item(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr)
+{
+    memset(afe_data_item, 0, sizeof(afe_queue_data_item_t));
 
 #ifdef CY_AFE_ENABLE_CRC_CHECK
-    afe_data_item.crc_value = afe_get_crc_checksum_val(context, input_audio_data_ptr);
+    afe_data_item->crc_value = afe_get_crc_checksum_val(context, input_audio_data_ptr);
 #endif
 
 #ifdef CY_AFE_ENABLE_TIMESTAMP
     afe_update_timestamp(context, AFE_FRAME_RECEIVED_TIMESTAMP);
 #endif
 
-    afe_data_item.input_data_ptr = input_audio_data_ptr;
-    afe_data_item.aec_ref_ptr = aec_ref_ptr;
+    afe_data_item->input_data_ptr = input_audio_data_ptr;
+    afe_data_item->aec_ref_ptr = aec_ref_ptr;
+
+    /* Frames gathered by cy_afe_feed_samples are converted while they are gathered */
+    afe_data_item->app_format = ((true == context->input_convert || true == context->aec_ref_convert) &&
+            !afe_pool_owns(&context->input_pool, input_audio_data_ptr) &&
+            (uint8_t *)input_audio_data_ptr != context->reframe_sync_frame);
 
 #ifdef CY_AFE_ENABLE_STATS
     afe_update_stats(context, AFE_FRAME_FEED_COUNT);
 #endif
+}
+
+/**
+ * Take the producer side of the audio processing queue and input pool. Both take a single
+ * producer, so a feed which finds another feed in progress, for example from an ISR which
+ * preempted it, is rejected instead of waiting.
+ */
+cy_rslt_t afe_enter_producer(afe_internal_context_t *context, uint32_t num_frames)
+{
+    uint32_t frame = 0;
+
+    if (atomic_flag_test_and_set_explicit(&context->producer_busy, memory_order_acquire))
+    {
+        for (frame = 0; frame < num_frames; frame++)
+        {
+            afe_update_stats(context, AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT);
+        }
+        cy_afe_log_err_on_no_isr(CY_RSLT_AFE_BUSY, "Input is being fed by another caller");
+        return CY_RSLT_AFE_BUSY;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+void afe_exit_producer(afe_internal_context_t *context)
+{
+    atomic_flag_clear_explicit(&context->producer_busy, memory_order_release);
+}
+
+/**
+ * Push input audio data to AFE thread queue for processing, with the producer side taken
+ */
+static cy_rslt_t afe_queue_input_frame(afe_internal_context_t *context, afe_queue_data_item_t *afe_data_item)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
 
 #ifdef ENABLE_AFE_APP_CHECK_POINT
     AFE_APP_CHECK_POINT()
 #endif
 
-    result = cy_rtos_put_queue(&context->audio_processing_queue, &afe_data_item,
-            CY_RTOS_NEVER_TIMEOUT, is_in_isr());
+    result = afe_make_room_in_queue(context, 1,
+            (NULL == context->input_pool_buffer || afe_pool_owns(&context->input_pool, afe_data_item->input_data_ptr)) ? 0 : 1);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        afe_release_input_frame(context, afe_data_item);
+        return result;
+    }
+
+    result = afe_copy_input_frame(context, afe_data_item);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    atomic_fetch_add_explicit(&context->frames_pending, 1, memory_order_relaxed);
+    result = afe_ring_push(&context->audio_processing_queue, afe_data_item);
 
 #ifdef ENABLE_AFE_APP_CHECK_POINT
     AFE_APP_CHECK_POINT()
@@ -273,10 +875,314 @@ cy_rslt_t afe_push_audio_data_to_queue(afe_internal_context_t *context,
 
     if (CY_RSLT_SUCCESS != result)
     {
+        atomic_fetch_sub_explicit(&context->frames_pending, 1, memory_order_relaxed);
+        afe_release_input_frame(context, afe_data_item);
         afe_update_stats(context, AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT);
-        cy_afe_log_err_on_no_isr(result, "cy_rtos_put_queue failed");
+        cy_afe_log_err_on_no_isr(result, "Audio processing queue is full");
+        return result;
+    }
+
+    afe_update_queue_depth(context);
+
+    return result;
+}
+
+/**
+ * Push input audio data to AFE thread queue for processing
+ */
+cy_rslt_t afe_push_audio_data_to_queue(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    afe_queue_data_item_t afe_data_item;
+
+    if (NULL == context || NULL == input_audio_data_ptr) {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err_on_no_isr(result,
+                "Invalid argument. context: [%p], item : [%p]", context,
+                input_audio_data_ptr);
+        return result;
+    }
+
+    afe_fill_queue_item(context, &afe_data_item, input_audio_data_ptr, aec_ref_ptr);
+
+    result = afe_enter_producer(context, 1);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        /* Frame gathered by cy_afe_feed_samples is owned by AFE and goes back to the pool */
+        afe_release_input_frame(context, &afe_data_item);
+        return result;
+    }
+
+    result = afe_queue_input_frame(context, &afe_data_item);
+    afe_exit_producer(context);
+
+    return result;
+}
+
+/**
+ * Push a block of input audio frames to AFE thread queue with a single consumer notification,
+ * with the producer side taken
+ */
+static cy_rslt_t afe_queue_input_batch(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    afe_queue_data_item_t *afe_data_item = NULL;
+    uint32_t frame = 0;
+
+    result = afe_make_room_in_queue(context, num_frames, (NULL == context->input_pool_buffer) ? 0 : num_frames);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    for (frame = 0; frame < num_frames; frame++)
+    {
+        afe_data_item = (afe_queue_data_item_t *)afe_ring_write_slot(&context->audio_processing_queue, frame);
+        afe_fill_queue_item(context, afe_data_item,
+                (CY_AFE_DATA_T *)((uint8_t *)input_audio_data_ptr + (frame * context->app_input_frame_size)),
+                (NULL == aec_ref_ptr) ? NULL :
+                (CY_AFE_DATA_T *)((uint8_t *)aec_ref_ptr + (frame * context->app_aec_ref_frame_size)));
+
+        result = afe_copy_input_frame(context, afe_data_item);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            /* Block is rejected as a whole, frames copied so far are returned to the pool */
+            while (frame > 0)
+            {
+                frame--;
+                afe_release_input_frame(context,
+                        (afe_queue_data_item_t *)afe_ring_write_slot(&context->audio_processing_queue, frame));
+            }
+            return result;
+        }
+    }
+
+    atomic_fetch_add_explicit(&context->frames_pending, num_frames, memory_order_relaxed);
+    afe_ring_commit(&context->audio_processing_queue, num_frames);
+
+    afe_update_queue_depth(context);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Push a block of input audio frames to AFE thread queue with a single consumer notification
+ */
+cy_rslt_t afe_push_audio_data_batch_to_queue(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    result = afe_enter_producer(context, num_frames);
+    if (CY_RSLT_SUCCESS != result)
+    {
         return result;
     }
 
+    result = afe_queue_input_batch(context, input_audio_data_ptr, aec_ref_ptr, num_frames);
+    afe_exit_producer(context);
+
+    return result;
+}
+
+/**
+ * Process input audio data in the caller context, taking process_mutex unless the caller holds it
+ */
+static cy_rslt_t afe_process_frame_in_caller(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, cy_afe_buffer_info_t *output_info,
+        bool mutex_held)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    afe_queue_data_item_t afe_data_item;
+
+    if (NULL == context || NULL == input_audio_data_ptr)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Invalid argument. context: [%p], item : [%p]", context,
+                input_audio_data_ptr);
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    afe_fill_queue_item(context, &afe_data_item, input_audio_data_ptr, aec_ref_ptr);
+
+    if (true == mutex_held)
+    {
+        result = afe_process_audio_data_locked(context, &afe_data_item, output_info);
+    }
+    else
+    {
+        result = afe_process_audio_data(context, &afe_data_item, output_info);
+    }
+    afe_release_input_frame(context, &afe_data_item);
+
+    return result;
+}
+
+/**
+ * Process input audio data in the caller context
+ */
+cy_rslt_t afe_process_audio_data_in_caller(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, cy_afe_buffer_info_t *output_info)
+{
+    return afe_process_frame_in_caller(context, input_audio_data_ptr, aec_ref_ptr, output_info, false);
+}
+
+/**
+ * Claim the instance to process frames in the caller, CY_AFE_PROCESSING_MODE_ADAPTIVE only.
+ * Succeeds when process_mutex is free and no frame is queued or processed elsewhere. The claim
+ * holds process_mutex, so frames fed meanwhile are queued and processed by AFE processing task,
+ * and their callbacks invoked, only once the frames of the claim are done.
+ */
+static bool afe_claim_caller_processing(afe_internal_context_t *context)
+{
+    uint_fast32_t expected = 0;
+
+    if (is_in_isr())
+    {
+        return false;
+    }
+
+    if (CY_RSLT_SUCCESS != cy_rtos_mutex_get(&context->process_mutex, 0))
+    {
+        return false;
+    }
+
+    if (!atomic_compare_exchange_strong_explicit(&context->frames_pending, &expected, 1,
+            memory_order_acquire, memory_order_relaxed))
+    {
+        cy_rtos_mutex_set(&context->process_mutex);
+        return false;
+    }
+
+    return true;
+}
+
+static void afe_release_caller_processing(afe_internal_context_t *context)
+{
+    atomic_fetch_sub_explicit(&context->frames_pending, 1, memory_order_release);
+    cy_rtos_mutex_set(&context->process_mutex);
+}
+
+/**
+ * Feed input audio data based on the processing mode of the instance
+ */
+cy_rslt_t afe_feed_audio_data(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    /* Input is read from the input ring instead */
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+    }
+
+    switch (context->config_init.processing_mode)
+    {
+        case CY_AFE_PROCESSING_MODE_SYNC:
+        {
+            if (is_in_isr())
+            {
+                return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+            }
+            return afe_process_audio_data_in_caller(context, input_audio_data_ptr, aec_ref_ptr, NULL);
+        }
+
+        case CY_AFE_PROCESSING_MODE_ADAPTIVE:
+        {
+            /* No frame is pending once claimed, so processing the frame right here does
+             * not reorder it with queued frames.
+             */
+            if (true == afe_claim_caller_processing(context))
+            {
+                result = afe_process_frame_in_caller(context, input_audio_data_ptr, aec_ref_ptr, NULL, true);
+                afe_release_caller_processing(context);
+                return result;
+            }
+            return afe_push_audio_data_to_queue(context, input_audio_data_ptr, aec_ref_ptr);
+        }
+
+        case CY_AFE_PROCESSING_MODE_TASK:
+        default:
+        {
+            return afe_push_audio_data_to_queue(context, input_audio_data_ptr, aec_ref_ptr);
+        }
+    }
+}
+
+/**
+ * Feed a block of input audio frames based on the processing mode of the instance
+ */
+cy_rslt_t afe_feed_audio_data_batch(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    cy_rslt_t frame_result = CY_RSLT_SUCCESS;
+    uint32_t frame = 0;
+    bool process_in_caller = false;
+
+    if (NULL != context->config_init.input_ring.input_buffer)
+    {
+        return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+    }
+
+    switch (context->config_init.processing_mode)
+    {
+        case CY_AFE_PROCESSING_MODE_SYNC:
+        {
+            if (is_in_isr())
+            {
+                return CY_RSLT_AFE_INVALID_PROCESSING_MODE;
+            }
+            process_in_caller = true;
+            break;
+        }
+
+        case CY_AFE_PROCESSING_MODE_ADAPTIVE:
+        {
+            process_in_caller = afe_claim_caller_processing(context);
+            break;
+        }
+
+        case CY_AFE_PROCESSING_MODE_TASK:
+        default:
+        {
+            break;
+        }
+    }
+
+    if (false == process_in_caller)
+    {
+        return afe_push_audio_data_batch_to_queue(context, input_audio_data_ptr, aec_ref_ptr, num_frames);
+    }
+
+    for (frame = 0; frame < num_frames; frame++)
+    {
+        /* The adaptive mode claim already holds process_mutex */
+        frame_result = afe_process_frame_in_caller(context,
+                (CY_AFE_DATA_T *)((uint8_t *)input_audio_data_ptr + (frame * context->app_input_frame_size)),
+                (NULL == aec_ref_ptr) ? NULL :
+                (CY_AFE_DATA_T *)((uint8_t *)aec_ref_ptr + (frame * context->app_aec_ref_frame_size)), NULL,
+                (CY_AFE_PROCESSING_MODE_ADAPTIVE == context->config_init.processing_mode));
+
+        /* Dropped output only loses that frame, later frames of the block are still processed */
+        if (CY_RSLT_AFE_QUEUE_FULL == frame_result)
+        {
+            result = frame_result;
+            continue;
+        }
+        if (CY_RSLT_SUCCESS != frame_result)
+        {
+            result = frame_result;
+            break;
+        }
+    }
+
+    if (CY_AFE_PROCESSING_MODE_ADAPTIVE == context->config_init.processing_mode)
+    {
+        afe_release_caller_processing(context);
+    }
+
     return result;
 }
@@ -80,7 +80,7 @@ uint32_t afe_get_crc_checksum_val(afe_internal_context_t* context, CY_AFE_DATA_T
 
     start = (uint32_t*) input_audio_ptr;
 
-    audio_input_bytes = (CY_AFE_SAMPLE_FREQ * (CY_AFE_SAMPLE_WIDTH_SIZE/8) * CY_AFE_INPUT_NUM_OF_CHANNELS * CY_AFE_FRAME_SIZE_MS);
+    audio_input_bytes = (int)context->input_frame_size;
 
     end = (uint32_t*) (((char*) input_audio_ptr) + audio_input_bytes) - sizeof(uint32_t);
 
@@ -45,8 +45,16 @@
 #include "cy_afe_profiler.h"
 #include "cy_profiler.h"
 #include "cy_afe_audio_log_msg.h"
+#include "cy_afe_audio_resample.h"
+#include "cy_afe_audio_dsp.h"
+#include "cy_audio_front_end_error.h"
+#include "cy_afe_audio_internal.h"
+#include "cy_afe_audio_ring.h"
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #define CY_CYCLE_MAX(x, y) (((x) > (y)) ? (x) : (y))
 
 /******************************************************************************
@@ -54,9 +62,65 @@
 *****************************************************************************/
 #define AFE_1SEC_FRAME_COUNT    (100)
 #define AFE_MCPS_FOR_1SEC       (1000000)
+#define AFE_RESAMPLE_BENCHMARK_FRAMES   (100)
+#define AFE_RESAMPLE_BENCHMARK_STREAMS  (3)
+#define AFE_FORMAT_BENCHMARK_FRAMES     (100)
+#define AFE_RING_BENCHMARK_DEPTH        (8)
+/* Largest supported frame: 10 ms at 48 kHz, 32 bit samples, CY_AFE_AEC_REF_MAX_CHANNELS channels */
+#define AFE_CHANNEL_BENCHMARK_BUFFER_SIZE   (480 * sizeof(int32_t) * CY_AFE_AEC_REF_MAX_CHANNELS)
+#define AFE_MULTI_INSTANCE_THREAD_STACK_SIZE    (8 * 1024)
+#define AFE_MULTI_INSTANCE_THREAD_PRIORITY      (CY_RTOS_PRIORITY_NORMAL)
+/* Output consumer slower than real time, so that frames fed back to back overload the input queue */
+#define AFE_OVERLOAD_BENCHMARK_CONSUMER_DELAY_MS    (20)
+#define AFE_OVERLOAD_BENCHMARK_BLOCK_TIMEOUT_MS     (5)
+/* Covers the tick granularity of cy_rtos_get_time and the error log of a rejected frame */
+#define AFE_OVERLOAD_BENCHMARK_LATENCY_MARGIN_MS    (10)
+#define AFE_OVERLOAD_BENCHMARK_POLL_MS              (10)
+#define AFE_CHECKSUM_SEED       (2166136261u)
+#define AFE_CHECKSUM_PRIME      (16777619u)
 /******************************************************************************
 * Constants
 *****************************************************************************/
+typedef enum
+{
+    AFE_FORMAT_BENCHMARK_S32_TO_S16,
+    AFE_FORMAT_BENCHMARK_S24_TO_S16,
+    AFE_FORMAT_BENCHMARK_F32_TO_S16,
+    AFE_FORMAT_BENCHMARK_S16_TO_S32,
+    AFE_FORMAT_BENCHMARK_S16_TO_S24,
+    AFE_FORMAT_BENCHMARK_S16_TO_F32,
+    AFE_FORMAT_BENCHMARK_MAX
+} afe_format_benchmark_t;
+
+static const cy_afe_overload_policy_t afe_overload_benchmark_policies[] =
+{
+    CY_AFE_OVERLOAD_POLICY_DROP_NEWEST, CY_AFE_OVERLOAD_POLICY_DROP_OLDEST, CY_AFE_OVERLOAD_POLICY_BLOCK
+};
+
+static const char *afe_overload_benchmark_names[] =
+{
+    "DropNewest", "DropOldest", "Block"
+};
+
+static const char *afe_format_benchmark_names[AFE_FORMAT_BENCHMARK_MAX] =
+{
+    "S32->S16", "S24->S16", "F32->S16", "S16->S32", "S16->S24", "S16->F32"
+};
+
+typedef struct
+{
+    cy_afe_memory_usage_t memory;
+    uint64_t tot_cycles;
+    unsigned int max_cycles;
+} afe_channel_benchmark_t;
+
+typedef struct
+{
+    const cy_afe_config_t *config;
+    const cy_afe_memory_usage_t *expected_memory;
+    uint32_t iterations;
+    cy_rslt_t result;
+} afe_create_delete_job_t;
 
 /******************************************************************************
 * Variables
@@ -182,4 +246,752 @@ cy_rslt_t cy_afe_profile(afe_profile_command cmd,
     return CY_RSLT_SUCCESS;
 }
 
+cy_rslt_t cy_afe_profile_resampler(uint32_t sample_rate, uint32_t frame_size_ms)
+{
+    afe_resampler_t resampler;
+    uint32_t input_samples = (sample_rate * frame_size_ms) / 1000;
+    uint32_t core_samples = (afe_resample_get_core_rate(sample_rate) * frame_size_ms) / 1000;
+    uint32_t taps = 0, index = 0, frame = 0, stream = 0, sample = 0;
+    uint64_t decimation_cycles = 0, interpolation_cycles = 0;
+    int16_t *input = NULL, *core = NULL, *output = NULL;
+    void *buffer = NULL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (core_samples == input_samples)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    input = calloc(input_samples, sizeof(int16_t));
+    output = calloc(input_samples, sizeof(int16_t));
+    core = calloc(core_samples, sizeof(int16_t));
+    if (NULL == input || NULL == output || NULL == core)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        goto CLEAN_RETURN;
+    }
+
+    for (sample = 0; sample < input_samples; sample++)
+    {
+        input[sample] = (int16_t)((sample * 2731u) & 0x3FFF) - 0x2000;
+    }
+
+    while (CY_RSLT_SUCCESS == afe_resample_get_filter_taps(sample_rate, index++, &taps))
+    {
+        buffer = calloc(1, afe_resample_get_buffer_size(sample_rate, taps, input_samples, AFE_RESAMPLE_BENCHMARK_STREAMS));
+        if (NULL == buffer)
+        {
+            result = CY_RSLT_AFE_OUT_OF_MEMORY;
+            goto CLEAN_RETURN;
+        }
+        afe_resample_init(&resampler, sample_rate, taps, input_samples, AFE_RESAMPLE_BENCHMARK_STREAMS, buffer);
+
+        decimation_cycles = 0;
+        interpolation_cycles = 0;
+        for (frame = 0; frame < AFE_RESAMPLE_BENCHMARK_FRAMES; frame++)
+        {
+            cy_profiler_start();
+            for (stream = 0; stream < AFE_RESAMPLE_BENCHMARK_STREAMS; stream++)
+            {
+                afe_resample_decimate(&resampler, stream, input, core);
+            }
+            cy_profiler_stop();
+            decimation_cycles += cy_profiler_get_cycles();
+
+            cy_profiler_start();
+            afe_resample_interpolate(&resampler, core, output);
+            cy_profiler_stop();
+            interpolation_cycles += cy_profiler_get_cycles();
+        }
+
+        cy_afe_log_info("AFEResample:Rate:%u Taps:%u DecimationCycles/Frame:%u InterpolationCycles/Frame:%u",
+                (unsigned int)sample_rate, (unsigned int)taps,
+                (unsigned int)(decimation_cycles / AFE_RESAMPLE_BENCHMARK_FRAMES),
+                (unsigned int)(interpolation_cycles / AFE_RESAMPLE_BENCHMARK_FRAMES));
+        printf("AFE-Resample:Rate:%u Taps:%u DecimationCycles/Frame:%u InterpolationCycles/Frame:%u\n",
+                (unsigned int)sample_rate, (unsigned int)taps,
+                (unsigned int)(decimation_cycles / AFE_RESAMPLE_BENCHMARK_FRAMES),
+                (unsigned int)(interpolation_cycles / AFE_RESAMPLE_BENCHMARK_FRAMES));
+
+        free(buffer);
+        buffer = NULL;
+    }
+
+CLEAN_RETURN:
+    free(input);
+    free(output);
+    free(core);
+    return result;
+}
+
+cy_rslt_t cy_afe_profile_ring(uint32_t iterations)
+{
+    afe_ring_t ring;
+    cy_queue_t queue;
+    afe_queue_data_item_t item;
+    void *buffer = NULL;
+    bool ring_initialized = false, queue_initialized = false;
+    uint32_t iteration = 0;
+    uint64_t ring_push_cycles = 0, ring_pop_cycles = 0, queue_put_cycles = 0, queue_get_cycles = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (0 == iterations)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    memset(&item, 0, sizeof(item));
+
+    buffer = calloc(1, afe_ring_buffer_size(sizeof(afe_queue_data_item_t), AFE_RING_BENCHMARK_DEPTH));
+    if (NULL == buffer)
+    {
+        return CY_RSLT_AFE_OUT_OF_MEMORY;
+    }
+
+    result = afe_ring_init(&ring, buffer, sizeof(afe_queue_data_item_t), AFE_RING_BENCHMARK_DEPTH);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+    ring_initialized = true;
+
+    result = cy_rtos_init_queue(&queue, AFE_RING_BENCHMARK_DEPTH, sizeof(afe_queue_data_item_t));
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+    queue_initialized = true;
+
+    /* Same item as fed to the audio processing task, one item in flight as in steady state */
+    for (iteration = 0; iteration < iterations && CY_RSLT_SUCCESS == result; iteration++)
+    {
+        cy_profiler_start();
+        result = afe_ring_push(&ring, &item);
+        cy_profiler_stop();
+        ring_push_cycles += cy_profiler_get_cycles();
+        if (CY_RSLT_SUCCESS != result)
+        {
+            break;
+        }
+
+        cy_profiler_start();
+        result = afe_ring_pop(&ring, &item, 0);
+        cy_profiler_stop();
+        ring_pop_cycles += cy_profiler_get_cycles();
+    }
+
+    for (iteration = 0; iteration < iterations && CY_RSLT_SUCCESS == result; iteration++)
+    {
+        cy_profiler_start();
+        result = cy_rtos_put_queue(&queue, &item, 0, false);
+        cy_profiler_stop();
+        queue_put_cycles += cy_profiler_get_cycles();
+        if (CY_RSLT_SUCCESS != result)
+        {
+            break;
+        }
+
+        cy_profiler_start();
+        result = cy_rtos_get_queue(&queue, &item, 0, false);
+        cy_profiler_stop();
+        queue_get_cycles += cy_profiler_get_cycles();
+    }
+
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+
+    cy_afe_log_info("AFERing:ItemSize:%u Ring Push:%u Pop:%u Queue Put:%u Get:%u Cycles/Item",
+            (unsigned int)sizeof(afe_queue_data_item_t),
+            (unsigned int)(ring_push_cycles / iterations), (unsigned int)(ring_pop_cycles / iterations),
+            (unsigned int)(queue_put_cycles / iterations), (unsigned int)(queue_get_cycles / iterations));
+    printf("AFE-Ring:ItemSize:%u Ring Push:%u Pop:%u Queue Put:%u Get:%u Cycles/Item\n",
+            (unsigned int)sizeof(afe_queue_data_item_t),
+            (unsigned int)(ring_push_cycles / iterations), (unsigned int)(ring_pop_cycles / iterations),
+            (unsigned int)(queue_put_cycles / iterations), (unsigned int)(queue_get_cycles / iterations));
+
+CLEAN_RETURN:
+    if (queue_initialized)
+    {
+        cy_rtos_deinit_queue(&queue);
+    }
+    if (ring_initialized)
+    {
+        afe_ring_deinit(&ring);
+    }
+    free(buffer);
+    return result;
+}
+
+cy_rslt_t cy_afe_profile_format_conversion(uint32_t samples)
+{
+    int32_t *wide = NULL;
+    int16_t *narrow = NULL;
+    uint32_t conversion = 0, frame = 0, sample = 0, dither = 0;
+    uint32_t dither_state = 1;
+    uint64_t cycles = 0;
+
+    wide = calloc(samples, sizeof(int32_t));
+    narrow = calloc(samples, sizeof(int16_t));
+    if (NULL == wide || NULL == narrow)
+    {
+        free(wide);
+        free(narrow);
+        return CY_RSLT_AFE_OUT_OF_MEMORY;
+    }
+
+    for (sample = 0; sample < samples; sample++)
+    {
+        narrow[sample] = (int16_t)((sample * 2731u) & 0x3FFF) - 0x2000;
+    }
+
+    for (conversion = 0; conversion < AFE_FORMAT_BENCHMARK_MAX; conversion++)
+    {
+        /* Only the conversions to 16 bit are dithered */
+        for (dither = 0; dither < ((conversion <= AFE_FORMAT_BENCHMARK_F32_TO_S16) ? 2u : 1u); dither++)
+        {
+            cycles = 0;
+            for (frame = 0; frame < AFE_FORMAT_BENCHMARK_FRAMES; frame++)
+            {
+                cy_profiler_start();
+                switch (conversion)
+                {
+                    case AFE_FORMAT_BENCHMARK_S32_TO_S16:
+                        afe_dsp_s32_to_s16(wide, 1, 0, narrow, samples, dither ? &dither_state : NULL);
+                        break;
+                    case AFE_FORMAT_BENCHMARK_S24_TO_S16:
+                        afe_dsp_s32_to_s16(wide, 1, 8, narrow, samples, dither ? &dither_state : NULL);
+                        break;
+                    case AFE_FORMAT_BENCHMARK_F32_TO_S16:
+                        afe_dsp_f32_to_s16((const float *)wide, 1, narrow, samples, dither ? &dither_state : NULL);
+                        break;
+                    case AFE_FORMAT_BENCHMARK_S16_TO_S32:
+                        afe_dsp_s16_to_s32(narrow, 16, wide, samples);
+                        break;
+                    case AFE_FORMAT_BENCHMARK_S16_TO_S24:
+                        afe_dsp_s16_to_s32(narrow, 8, wide, samples);
+                        break;
+                    default:
+                        afe_dsp_s16_to_f32(narrow, (float *)wide, samples);
+                        break;
+                }
+                cy_profiler_stop();
+                cycles += cy_profiler_get_cycles();
+            }
+
+            cy_afe_log_info("AFEFormat:%s Dither:%u Samples:%u Cycles/Frame:%u",
+                    afe_format_benchmark_names[conversion], (unsigned int)dither, (unsigned int)samples,
+                    (unsigned int)(cycles / AFE_FORMAT_BENCHMARK_FRAMES));
+            printf("AFE-Format:%s Dither:%u Samples:%u Cycles/Frame:%u\n",
+                    afe_format_benchmark_names[conversion], (unsigned int)dither, (unsigned int)samples,
+                    (unsigned int)(cycles / AFE_FORMAT_BENCHMARK_FRAMES));
+        }
+    }
+
+    free(wide);
+    free(narrow);
+    return CY_RSLT_SUCCESS;
+}
+
+static void afe_profile_sync_config(const cy_afe_config_t *config, cy_afe_config_t *sync_config)
+{
+    /* Frames are processed one by one in this context with AFE internal output buffers */
+    *sync_config = *config;
+    sync_config->processing_mode = CY_AFE_PROCESSING_MODE_SYNC;
+    sync_config->output_mode = CY_AFE_OUTPUT_MODE_CALLBACK;
+    sync_config->afe_output_callback = NULL;
+    sync_config->afe_get_buffer_callback = NULL;
+    memset(&sync_config->input_ring, 0, sizeof(sync_config->input_ring));
+}
+
+static cy_rslt_t afe_profile_instance(const cy_afe_config_t *config, uint32_t frames,
+        CY_AFE_DATA_T *input, CY_AFE_DATA_T *aec_ref, afe_channel_benchmark_t *benchmark)
+{
+    cy_afe_config_t sync_config;
+    cy_afe_buffer_info_t output;
+    afe_profile_data_t data = {0};
+    cy_afe_t handle = NULL;
+    uint32_t frame = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    afe_profile_sync_config(config, &sync_config);
+
+    result = cy_afe_create(&sync_config, &handle);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    cy_afe_get_memory_usage(handle, &benchmark->memory);
+
+    /* Speech enhancement cycles are collected by the frame profiling of the audio path */
+    cy_afe_profile(AFE_PROFILE_CMD_ENABLE, NULL);
+    for (frame = 0; frame < frames && CY_RSLT_SUCCESS == result; frame++)
+    {
+        result = cy_afe_process(handle, input, aec_ref, &output);
+    }
+    cy_afe_profile(AFE_PROFILE_CMD_GET_DATA, &data);
+    cy_afe_profile(AFE_PROFILE_CMD_DISABLE, NULL);
+
+    benchmark->tot_cycles = data.tot_cycles;
+    benchmark->max_cycles = data.max_cycles;
+
+    cy_afe_delete(&handle);
+    return result;
+}
+
+cy_rslt_t cy_afe_profile_mono_stereo(const cy_afe_config_t *mono_config, const cy_afe_config_t *stereo_config,
+        uint32_t frames)
+{
+    afe_channel_benchmark_t mono = {0}, stereo = {0};
+    CY_AFE_DATA_T *input = NULL, *aec_ref = NULL;
+    uint32_t mem_id = 0, sample = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == mono_config || NULL == stereo_config || 0 == frames)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    input = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    aec_ref = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    if (NULL == input || NULL == aec_ref)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        goto CLEAN_RETURN;
+    }
+
+    for (sample = 0; sample < AFE_CHANNEL_BENCHMARK_BUFFER_SIZE / sizeof(int16_t); sample++)
+    {
+        ((int16_t *)input)[sample] = (int16_t)((sample * 2731u) & 0x3FFF) - 0x2000;
+        ((int16_t *)aec_ref)[sample] = (int16_t)((sample * 1237u) & 0x3FFF) - 0x2000;
+    }
+
+    result = afe_profile_instance(mono_config, frames, input, aec_ref, &mono);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+    result = afe_profile_instance(stereo_config, frames, input, aec_ref, &stereo);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+
+    for (mem_id = 0; mem_id < CY_AFE_MEM_ID_MAX; mem_id++)
+    {
+        if (0 != mono.memory.bytes[mem_id] || 0 != stereo.memory.bytes[mem_id])
+        {
+            cy_afe_log_info("AFEChannels:MemId:%u Mono:%u Stereo:%u", (unsigned int)mem_id,
+                    (unsigned int)mono.memory.bytes[mem_id], (unsigned int)stereo.memory.bytes[mem_id]);
+            printf("AFE-Channels:MemId:%u Mono:%u Stereo:%u\n", (unsigned int)mem_id,
+                    (unsigned int)mono.memory.bytes[mem_id], (unsigned int)stereo.memory.bytes[mem_id]);
+        }
+    }
+    cy_afe_log_info("AFEChannels:TotalBytes Mono:%u Stereo:%u Cycles/Frame Mono:%u Stereo:%u PeakCyc Mono:%u Stereo:%u",
+            (unsigned int)mono.memory.total_bytes, (unsigned int)stereo.memory.total_bytes,
+            (unsigned int)(mono.tot_cycles / frames), (unsigned int)(stereo.tot_cycles / frames),
+            mono.max_cycles, stereo.max_cycles);
+    printf("AFE-Channels:TotalBytes Mono:%u Stereo:%u Cycles/Frame Mono:%u Stereo:%u PeakCyc Mono:%u Stereo:%u\n",
+            (unsigned int)mono.memory.total_bytes, (unsigned int)stereo.memory.total_bytes,
+            (unsigned int)(mono.tot_cycles / frames), (unsigned int)(stereo.tot_cycles / frames),
+            mono.max_cycles, stereo.max_cycles);
+
+CLEAN_RETURN:
+    free(input);
+    free(aec_ref);
+    return result;
+}
+
+static uint32_t afe_profile_checksum(uint32_t checksum, const uint8_t *data, uint32_t size)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < size; index++)
+    {
+        checksum = (checksum ^ data[index]) * AFE_CHECKSUM_PRIME;
+    }
+    return checksum;
+}
+
+static bool afe_profile_same_memory(const cy_afe_memory_usage_t *a, const cy_afe_memory_usage_t *b)
+{
+    return (0 == memcmp(a->bytes, b->bytes, sizeof(a->bytes))) && (a->total_bytes == b->total_bytes);
+}
+
+static cy_rslt_t afe_profile_process_checksum(cy_afe_t handle, CY_AFE_DATA_T *input, CY_AFE_DATA_T *aec_ref,
+        uint32_t *checksum)
+{
+    afe_internal_context_t *context = (afe_internal_context_t *) handle;
+    cy_afe_buffer_info_t output;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    result = cy_afe_process(handle, input, aec_ref, &output);
+    if (CY_RSLT_SUCCESS == result && NULL != output.output_buf)
+    {
+        *checksum = afe_profile_checksum(*checksum, (const uint8_t *)output.output_buf, context->app_output_frame_size);
+    }
+    return result;
+}
+
+static cy_rslt_t afe_profile_solo(const cy_afe_config_t *config, uint32_t frames, CY_AFE_DATA_T *input,
+        CY_AFE_DATA_T *aec_ref, cy_afe_memory_usage_t *memory, uint32_t *checksum)
+{
+    cy_afe_config_t sync_config;
+    cy_afe_t handle = NULL;
+    uint32_t frame = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    afe_profile_sync_config(config, &sync_config);
+    result = cy_afe_create(&sync_config, &handle);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    cy_afe_get_memory_usage(handle, memory);
+    *checksum = AFE_CHECKSUM_SEED;
+    for (frame = 0; frame < frames && CY_RSLT_SUCCESS == result; frame++)
+    {
+        result = afe_profile_process_checksum(handle, input, aec_ref, checksum);
+    }
+
+    cy_afe_delete(&handle);
+    return result;
+}
+
+static void afe_profile_create_delete_task(cy_thread_arg_t arg)
+{
+    afe_create_delete_job_t *job = (afe_create_delete_job_t *) arg;
+    cy_afe_config_t sync_config;
+    cy_afe_memory_usage_t memory;
+    cy_afe_t handle = NULL;
+    uint32_t iteration = 0;
+
+    afe_profile_sync_config(job->config, &sync_config);
+    job->result = CY_RSLT_SUCCESS;
+    for (iteration = 0; iteration < job->iterations && CY_RSLT_SUCCESS == job->result; iteration++)
+    {
+        job->result = cy_afe_create(&sync_config, &handle);
+        if (CY_RSLT_SUCCESS != job->result)
+        {
+            break;
+        }
+
+        /* Library allocations made while the other thread creates or deletes its instance must not be
+         * charged to this one */
+        cy_afe_get_memory_usage(handle, &memory);
+        if (!afe_profile_same_memory(&memory, job->expected_memory))
+        {
+            job->result = CY_RSLT_AFE_GENERIC_ERROR;
+        }
+
+        cy_afe_delete(&handle);
+    }
+}
+
+cy_rslt_t cy_afe_profile_multi_instance(const cy_afe_config_t *config_a, const cy_afe_config_t *config_b,
+        uint32_t frames, uint32_t iterations)
+{
+    cy_afe_memory_usage_t solo_memory[2], memory[2];
+    uint32_t solo_checksum[2], checksum[2];
+    afe_create_delete_job_t job[2];
+    cy_thread_t thread[2];
+    bool thread_created[2] = {false, false};
+    const cy_afe_config_t *config[2] = {config_a, config_b};
+    cy_afe_config_t sync_config;
+    cy_afe_t handle[2] = {NULL, NULL};
+    CY_AFE_DATA_T *input = NULL, *aec_ref = NULL;
+    uint32_t index = 0, frame = 0, sample = 0;
+    bool memory_isolated = true, output_isolated = true;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (NULL == config_a || NULL == config_b || 0 == frames)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    input = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    aec_ref = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    if (NULL == input || NULL == aec_ref)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        goto CLEAN_RETURN;
+    }
+
+    for (sample = 0; sample < AFE_CHANNEL_BENCHMARK_BUFFER_SIZE / sizeof(int16_t); sample++)
+    {
+        ((int16_t *)input)[sample] = (int16_t)((sample * 2731u) & 0x3FFF) - 0x2000;
+        ((int16_t *)aec_ref)[sample] = (int16_t)((sample * 1237u) & 0x3FFF) - 0x2000;
+    }
+
+    /* Reference: each configuration alone */
+    for (index = 0; index < 2; index++)
+    {
+        result = afe_profile_solo(config[index], frames, input, aec_ref, &solo_memory[index], &solo_checksum[index]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            goto CLEAN_RETURN;
+        }
+    }
+
+    /* Both instances alive, frames processed alternately */
+    for (index = 0; index < 2; index++)
+    {
+        afe_profile_sync_config(config[index], &sync_config);
+        result = cy_afe_create(&sync_config, &handle[index]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            goto CLEAN_RETURN;
+        }
+        checksum[index] = AFE_CHECKSUM_SEED;
+    }
+    for (frame = 0; frame < frames && CY_RSLT_SUCCESS == result; frame++)
+    {
+        for (index = 0; index < 2 && CY_RSLT_SUCCESS == result; index++)
+        {
+            result = afe_profile_process_checksum(handle[index], input, aec_ref, &checksum[index]);
+        }
+    }
+    if (CY_RSLT_SUCCESS != result)
+    {
+        goto CLEAN_RETURN;
+    }
+    for (index = 0; index < 2; index++)
+    {
+        cy_afe_get_memory_usage(handle[index], &memory[index]);
+        memory_isolated = memory_isolated && afe_profile_same_memory(&memory[index], &solo_memory[index]);
+        output_isolated = output_isolated && (checksum[index] == solo_checksum[index]);
+        cy_afe_log_info("AFEMultiInstance:Instance:%u TotalBytes Solo:%u Shared:%u Checksum Solo:0x%08x Shared:0x%08x",
+                (unsigned int)index, (unsigned int)solo_memory[index].total_bytes, (unsigned int)memory[index].total_bytes,
+                (unsigned int)solo_checksum[index], (unsigned int)checksum[index]);
+        printf("AFE-MultiInstance:Instance:%u TotalBytes Solo:%u Shared:%u Checksum Solo:0x%08x Shared:0x%08x\n",
+                (unsigned int)index, (unsigned int)solo_memory[index].total_bytes, (unsigned int)memory[index].total_bytes,
+                (unsigned int)solo_checksum[index], (unsigned int)checksum[index]);
+        cy_afe_delete(&handle[index]);
+    }
+
+    /* Create and delete both configurations concurrently from two threads */
+    for (index = 0; index < 2; index++)
+    {
+        job[index].config = config[index];
+        job[index].expected_memory = &solo_memory[index];
+        job[index].iterations = iterations;
+        job[index].result = CY_RSLT_SUCCESS;
+        result = cy_rtos_create_thread(&thread[index], afe_profile_create_delete_task, NULL, NULL,
+                AFE_MULTI_INSTANCE_THREAD_STACK_SIZE, AFE_MULTI_INSTANCE_THREAD_PRIORITY, &job[index]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "cy_rtos_create_thread failed");
+            goto CLEAN_RETURN;
+        }
+        thread_created[index] = true;
+    }
+    for (index = 0; index < 2; index++)
+    {
+        cy_rtos_join_thread(&thread[index]);
+        thread_created[index] = false;
+        cy_afe_log_info("AFEMultiInstance:Instance:%u CreateDelete Iterations:%u Result:0x%08x",
+                (unsigned int)index, (unsigned int)iterations, (unsigned int)job[index].result);
+        printf("AFE-MultiInstance:Instance:%u CreateDelete Iterations:%u Result:0x%08x\n",
+                (unsigned int)index, (unsigned int)iterations, (unsigned int)job[index].result);
+        if (CY_RSLT_SUCCESS != job[index].result)
+        {
+            result = job[index].result;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result && (!memory_isolated || !output_isolated))
+    {
+        result = CY_RSLT_AFE_GENERIC_ERROR;
+    }
+    cy_afe_log_info("AFEMultiInstance:MemoryIsolated:%u OutputIsolated:%u", memory_isolated, output_isolated);
+    printf("AFE-MultiInstance:MemoryIsolated:%u OutputIsolated:%u\n", memory_isolated, output_isolated);
+
+CLEAN_RETURN:
+    for (index = 0; index < 2; index++)
+    {
+        if (thread_created[index])
+        {
+            cy_rtos_join_thread(&thread[index]);
+        }
+        if (NULL != handle[index])
+        {
+            cy_afe_delete(&handle[index]);
+        }
+    }
+    free(input);
+    free(aec_ref);
+    return result;
+}
+
+static cy_rslt_t afe_profile_overload_output_cb(cy_afe_t handle, cy_afe_buffer_info_t *output_buffer, void *user_arg)
+{
+    atomic_uint_fast32_t *processed = (atomic_uint_fast32_t *) user_arg;
+
+    (void) handle;
+
+    /* Frames discarded by CY_AFE_OVERLOAD_POLICY_DROP_OLDEST are not processed */
+    if (NULL != output_buffer->output_buf)
+    {
+        atomic_fetch_add_explicit(processed, 1, memory_order_relaxed);
+        cy_rtos_delay_milliseconds(AFE_OVERLOAD_BENCHMARK_CONSUMER_DELAY_MS);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_profile_overload_policy(const cy_afe_config_t *config, cy_afe_overload_policy_t policy,
+        const char *name, uint32_t frames, uint32_t queue_size, CY_AFE_DATA_T *input, CY_AFE_DATA_T *aec_ref)
+{
+    cy_afe_config_t task_config = *config;
+    cy_afe_overload_stats_t stats;
+    atomic_uint_fast32_t processed;
+    cy_afe_t handle = NULL;
+    cy_time_t start_time = 0, end_time = 0, drain_time = 0;
+    uint32_t frame = 0, accepted = 0, rejected = 0, max_feed_ms = 0, latency_limit_ms = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    bool passed = true;
+
+    atomic_init(&processed, 0);
+
+    /* Frames are copied, so the same input buffers are fed back to back */
+    task_config.processing_mode = CY_AFE_PROCESSING_MODE_TASK;
+    task_config.output_mode = CY_AFE_OUTPUT_MODE_CALLBACK;
+    task_config.input_mode = CY_AFE_INPUT_MODE_COPY;
+    task_config.afe_output_callback = afe_profile_overload_output_cb;
+    task_config.afe_get_buffer_callback = NULL;
+    task_config.user_arg_callbacks = &processed;
+    task_config.output_queue_size = 0;
+    task_config.input_queue_size = queue_size;
+    task_config.overload_policy = policy;
+    task_config.overload_block_timeout_ms = AFE_OVERLOAD_BENCHMARK_BLOCK_TIMEOUT_MS;
+    memset(&task_config.input_ring, 0, sizeof(task_config.input_ring));
+
+    result = cy_afe_create(&task_config, &handle);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    for (frame = 0; frame < frames; frame++)
+    {
+        cy_rtos_get_time(&start_time);
+        result = cy_afe_feed(handle, input, aec_ref);
+        cy_rtos_get_time(&end_time);
+
+        max_feed_ms = CY_CYCLE_MAX(max_feed_ms, (uint32_t)(end_time - start_time));
+        if (CY_RSLT_SUCCESS == result)
+        {
+            accepted++;
+        }
+        else if (CY_RSLT_AFE_QUEUE_FULL == result)
+        {
+            rejected++;
+        }
+        else
+        {
+            goto CLEAN_RETURN;
+        }
+    }
+    result = CY_RSLT_SUCCESS;
+
+    /* Wait till every accepted frame is processed or discarded */
+    cy_rtos_get_time(&start_time);
+    do
+    {
+        cy_rtos_delay_milliseconds(AFE_OVERLOAD_BENCHMARK_POLL_MS);
+        cy_afe_get_overload_stats(handle, &stats);
+        cy_rtos_get_time(&drain_time);
+    } while ((0 != stats.queue_depth ||
+              atomic_load_explicit(&processed, memory_order_relaxed) + stats.frames_dropped_oldest < accepted) &&
+             (uint32_t)(drain_time - start_time) < (queue_size + 1) * AFE_OVERLOAD_BENCHMARK_CONSUMER_DELAY_MS * 2);
+
+    /* Only a blocking feed may wait, and never longer than the block timeout */
+    latency_limit_ms = AFE_OVERLOAD_BENCHMARK_LATENCY_MARGIN_MS;
+    if (CY_AFE_OVERLOAD_POLICY_BLOCK == policy)
+    {
+        latency_limit_ms += AFE_OVERLOAD_BENCHMARK_BLOCK_TIMEOUT_MS;
+    }
+
+    passed = (rejected == stats.frames_dropped_newest) &&
+             (atomic_load_explicit(&processed, memory_order_relaxed) + stats.frames_dropped_oldest == accepted) &&
+             (stats.max_queue_depth <= queue_size) &&
+             (max_feed_ms <= latency_limit_ms) &&
+             (stats.max_block_time_ms <= latency_limit_ms) &&
+             (stats.block_timeout_count <= stats.block_count);
+    switch (policy)
+    {
+        case CY_AFE_OVERLOAD_POLICY_DROP_NEWEST:
+            passed = passed && (0 == stats.frames_dropped_oldest) && (0 == stats.block_count);
+            break;
+        case CY_AFE_OVERLOAD_POLICY_DROP_OLDEST:
+            passed = passed && (0 == stats.block_count);
+            break;
+        default:
+            passed = passed && (0 == stats.frames_dropped_oldest) && (stats.block_timeout_count <= rejected);
+            break;
+    }
+
+    cy_afe_log_info("AFEOverload:Policy:%s Fed:%u Processed:%u DroppedNewest:%u DroppedOldest:%u Blocks:%u BlockTimeouts:%u "
+            "MaxBlockMs:%u MaxQueueDepth:%u MaxFeedMs:%u Passed:%u", name, (unsigned int)frames,
+            (unsigned int)atomic_load_explicit(&processed, memory_order_relaxed),
+            (unsigned int)stats.frames_dropped_newest, (unsigned int)stats.frames_dropped_oldest,
+            (unsigned int)stats.block_count, (unsigned int)stats.block_timeout_count,
+            (unsigned int)stats.max_block_time_ms, (unsigned int)stats.max_queue_depth,
+            (unsigned int)max_feed_ms, passed);
+    printf("AFE-Overload:Policy:%s Fed:%u Processed:%u DroppedNewest:%u DroppedOldest:%u Blocks:%u BlockTimeouts:%u "
+            "MaxBlockMs:%u MaxQueueDepth:%u MaxFeedMs:%u Passed:%u\n", name, (unsigned int)frames,
+            (unsigned int)atomic_load_explicit(&processed, memory_order_relaxed),
+            (unsigned int)stats.frames_dropped_newest, (unsigned int)stats.frames_dropped_oldest,
+            (unsigned int)stats.block_count, (unsigned int)stats.block_timeout_count,
+            (unsigned int)stats.max_block_time_ms, (unsigned int)stats.max_queue_depth,
+            (unsigned int)max_feed_ms, passed);
+
+    if (!passed)
+    {
+        result = CY_RSLT_AFE_GENERIC_ERROR;
+    }
+
+CLEAN_RETURN:
+    cy_afe_delete(&handle);
+    return result;
+}
+
+cy_rslt_t cy_afe_profile_overload(const cy_afe_config_t *config, uint32_t frames, uint32_t queue_size)
+{
+    CY_AFE_DATA_T *input = NULL, *aec_ref = NULL;
+    uint32_t index = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS, policy_result = CY_RSLT_SUCCESS;
+
+    if (NULL == config || 0 == frames || 0 == queue_size)
+    {
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    input = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    aec_ref = calloc(1, AFE_CHANNEL_BENCHMARK_BUFFER_SIZE);
+    if (NULL == input || NULL == aec_ref)
+    {
+        result = CY_RSLT_AFE_OUT_OF_MEMORY;
+        goto CLEAN_RETURN;
+    }
+
+    /* Every policy is run, the first failure is returned */
+    for (index = 0; index < sizeof(afe_overload_benchmark_policies) / sizeof(afe_overload_benchmark_policies[0]); index++)
+    {
+        policy_result = afe_profile_overload_policy(config, afe_overload_benchmark_policies[index],
+                afe_overload_benchmark_names[index], frames, queue_size, input, aec_ref);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = policy_result;
+        }
+    }
+
+CLEAN_RETURN:
+    free(input);
+    free(aec_ref);
+    return result;
+}
+
 #endif
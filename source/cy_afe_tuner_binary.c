@@ -0,0 +1,688 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_tuner_binary.c
+ * @brief Binary tuner protocol. Frames are checked and dispatched through a table indexed by command ID,
+ *        parameters are read in place and the response is built in the response buffer, without heap use.
+ *
+ */
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+#include "cy_audio_front_end.h"
+#include "cy_afe_audio_internal.h"
+#include "cy_afe_tuner_process.h"
+#include "cy_afe_tuner_binary.h"
+#include "cy_afe_audio_speech_enh.h"
+
+/******************************************************
+ *                     Macros
+ ******************************************************/
+#define AFE_TUNER_BIN_TLV_HEADER_LEN         (2)
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+/* Response payload being built in the response buffer */
+typedef struct
+{
+    uint8_t *payload;       // first payload byte of the response frame
+    uint16_t length;        // payload bytes written
+    uint16_t max_length;    // payload capacity
+    bool overflow;          // a parameter did not fit
+} afe_tuner_bin_writer_t;
+
+typedef cy_rslt_t (*afe_tuner_bin_handler_t)(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response);
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static cy_rslt_t afe_tuner_bin_get_component_state(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_set_component_state(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_config_value(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_set_config_value(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_component_params(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_sound_meter(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_audio_channels(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_set_audio_channels(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_all_params(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_begin(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_commit(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_abort(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+static cy_rslt_t afe_tuner_bin_get_tuner_stats(afe_internal_context_t *context, const uint8_t *payload, uint16_t length, afe_tuner_bin_writer_t *response);
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+static const struct
+{
+    afe_tuner_bin_handler_t handler;
+    bool staged;            // set command, staged until commit while a transaction is open
+} afe_tuner_bin_cmds[AFE_TUNER_BIN_CMD_MAX] =
+{
+    [AFE_TUNER_BIN_CMD_GET_COMPONENT_STATE]  = { afe_tuner_bin_get_component_state,  false },
+    [AFE_TUNER_BIN_CMD_SET_COMPONENT_STATE]  = { afe_tuner_bin_set_component_state,  true  },
+    [AFE_TUNER_BIN_CMD_GET_CONFIG_VALUE]     = { afe_tuner_bin_get_config_value,     false },
+    [AFE_TUNER_BIN_CMD_SET_CONFIG_VALUE]     = { afe_tuner_bin_set_config_value,     true  },
+    [AFE_TUNER_BIN_CMD_GET_COMPONENT_PARAMS] = { afe_tuner_bin_get_component_params, false },
+    [AFE_TUNER_BIN_CMD_GET_SOUND_METER]      = { afe_tuner_bin_get_sound_meter,      false },
+    [AFE_TUNER_BIN_CMD_GET_AUDIO_CHANNELS]   = { afe_tuner_bin_get_audio_channels,   false },
+    [AFE_TUNER_BIN_CMD_SET_AUDIO_CHANNELS]   = { afe_tuner_bin_set_audio_channels,   true  },
+    [AFE_TUNER_BIN_CMD_GET_ALL_PARAMS]       = { afe_tuner_bin_get_all_params,       false },
+    [AFE_TUNER_BIN_CMD_BEGIN]                = { afe_tuner_bin_begin,                false },
+    [AFE_TUNER_BIN_CMD_COMMIT]               = { afe_tuner_bin_commit,               false },
+    [AFE_TUNER_BIN_CMD_ABORT]                = { afe_tuner_bin_abort,                false },
+    [AFE_TUNER_BIN_CMD_GET_TUNER_STATS]      = { afe_tuner_bin_get_tuner_stats,      false },
+};
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+
+/* CRC-16/CCITT-FALSE, one nibble at a time */
+static uint16_t afe_tuner_bin_crc16(const uint8_t *data, uint32_t length)
+{
+    static const uint16_t crc_table[16] =
+    {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+    };
+    uint16_t crc = 0xFFFF;
+    uint32_t index = 0;
+
+    for(index = 0; index < length; index++)
+    {
+        crc = (uint16_t)((crc << 4) ^ crc_table[((crc >> 12) ^ (data[index] >> 4)) & 0x0F]);
+        crc = (uint16_t)((crc << 4) ^ crc_table[((crc >> 12) ^ (data[index] & 0x0F)) & 0x0F]);
+    }
+
+    return crc;
+}
+
+static uint16_t afe_tuner_bin_get_u16(const uint8_t *data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t afe_tuner_bin_get_u32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void afe_tuner_bin_put_u16(uint8_t *data, uint16_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+static void afe_tuner_bin_put_u32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+/* Find the first parameter of a type holding at least min_length bytes, NULL if none */
+static const uint8_t *afe_tuner_bin_find_tlv(const uint8_t *payload, uint16_t length, uint8_t type, uint8_t min_length)
+{
+    uint16_t offset = 0;
+
+    while((offset + AFE_TUNER_BIN_TLV_HEADER_LEN) <= length)
+    {
+        uint8_t tlv_type = payload[offset];
+        uint8_t tlv_length = payload[offset + 1];
+
+        if((offset + AFE_TUNER_BIN_TLV_HEADER_LEN + tlv_length) > length)
+        {
+            break;
+        }
+
+        if((tlv_type == type) && (tlv_length >= min_length))
+        {
+            return &payload[offset + AFE_TUNER_BIN_TLV_HEADER_LEN];
+        }
+
+        offset = offset + AFE_TUNER_BIN_TLV_HEADER_LEN + tlv_length;
+    }
+
+    return NULL;
+}
+
+/* Append a parameter to the response, returns where to write its value or NULL if it does not fit */
+static uint8_t *afe_tuner_bin_put_tlv(afe_tuner_bin_writer_t *response, uint8_t type, uint8_t length)
+{
+    uint8_t *tlv = NULL;
+
+    if((response->length + AFE_TUNER_BIN_TLV_HEADER_LEN + length) > response->max_length)
+    {
+        response->overflow = true;
+        return NULL;
+    }
+
+    tlv = response->payload + response->length;
+    tlv[0] = type;
+    tlv[1] = length;
+    response->length = (uint16_t)(response->length + AFE_TUNER_BIN_TLV_HEADER_LEN + length);
+
+    return tlv + AFE_TUNER_BIN_TLV_HEADER_LEN;
+}
+
+static void afe_tuner_bin_put_values(afe_tuner_bin_writer_t *response, uint8_t type, const int32_t *values, int32_t count)
+{
+    uint8_t *value = afe_tuner_bin_put_tlv(response, type, (uint8_t)(count * sizeof(int32_t)));
+    int32_t index = 0;
+
+    for(index = 0; (NULL != value) && (index < count); index++)
+    {
+        afe_tuner_bin_put_u32(&value[index * sizeof(int32_t)], (uint32_t)values[index]);
+    }
+}
+
+static uint8_t afe_tuner_bin_status(cy_rslt_t result)
+{
+    switch(result)
+    {
+        case CY_RSLT_SUCCESS:
+            return AFE_TUNER_BIN_STATUS_OK;
+        case CY_RSLT_AFE_TUNER_INALID_CMD:
+            return AFE_TUNER_BIN_STATUS_INVALID_CMD;
+        case CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS:
+            return AFE_TUNER_BIN_STATUS_INVALID_PARAMS;
+        case CY_RSLT_AFE_TUNER_GENERIC_ERROR:
+            return AFE_TUNER_BIN_STATUS_ERROR;
+        case CY_RSLT_AFE_TUNER_COMPONENT_NOT_ENABLED:
+            return AFE_TUNER_BIN_STATUS_COMPONENT_NOT_ENABLED;
+        case CY_RSLT_AFE_TUNER_CMD_NOT_SUPPORTED:
+            return AFE_TUNER_BIN_STATUS_NOT_SUPPORTED;
+        default:
+            return AFE_TUNER_BIN_STATUS_INTERNAL_ERROR;
+    }
+}
+
+static cy_rslt_t afe_tuner_bin_get_component(const uint8_t *payload, uint16_t length, ifx_sp_enh_ip_component_config_t *component)
+{
+    const uint8_t *value = afe_tuner_bin_find_tlv(payload, length, AFE_TUNER_BIN_TLV_COMPONENT, 1);
+
+    if(NULL == value)
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+
+    *component = (ifx_sp_enh_ip_component_config_t)value[0];
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_get_component_state(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    ifx_sp_enh_ip_component_config_t component;
+    cy_rslt_t result;
+    uint8_t *value = NULL;
+    bool enable = false;
+
+    result = afe_tuner_bin_get_component(payload, length, &component);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    result = afe_speech_enhancement_get_component_status(context, component, &enable);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_ENABLE, 1);
+    if(NULL != value)
+    {
+        value[0] = enable ? 1 : 0;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_set_component_state(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    ifx_sp_enh_ip_component_config_t component;
+    const uint8_t *enable = afe_tuner_bin_find_tlv(payload, length, AFE_TUNER_BIN_TLV_ENABLE, 1);
+    cy_rslt_t result;
+
+    result = afe_tuner_bin_get_component(payload, length, &component);
+    if((CY_RSLT_SUCCESS != result) || (NULL == enable))
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+
+    return afe_speech_enhancement_enable_disable_component(context, component, (0 != enable[0]));
+}
+
+static cy_rslt_t afe_tuner_bin_get_config_value(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    ifx_sp_enh_ip_component_config_t component;
+    cy_rslt_t result;
+    int32_t config_value = 0;
+
+    result = afe_tuner_bin_get_component(payload, length, &component);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    result = afe_speech_enhancement_get_config_value(context, component, &config_value);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    afe_tuner_bin_put_values(response, AFE_TUNER_BIN_TLV_VALUE, &config_value, 1);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_set_config_value(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    ifx_sp_enh_ip_component_config_t component;
+    const uint8_t *value = afe_tuner_bin_find_tlv(payload, length, AFE_TUNER_BIN_TLV_VALUE, sizeof(int32_t));
+    cy_afe_config_setting_t config_setting;
+    cy_rslt_t result;
+    int config_value = 0;
+
+    result = afe_tuner_bin_get_component(payload, length, &component);
+    if((CY_RSLT_SUCCESS != result) || (NULL == value))
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+    config_value = (int)(int32_t)afe_tuner_bin_get_u32(value);
+
+    memset(&config_setting, 0, sizeof(cy_afe_config_setting_t));
+    config_setting.action = CY_AFE_NOTIFY_CONFIG;
+    config_setting.value = (int*) &config_value;
+
+    /* Same settings as the text commands, each notified to the application */
+    switch(component)
+    {
+        case IFX_SP_ENH_IP_COMPONENT_AEC:
+            config_setting.config_name = CY_AFE_CONFIG_AEC_BULK_DELAY;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_BF:
+            config_setting.config_name = CY_AFE_CONFIG_INFERENCE_CANCELLER;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_ES:
+        case IFX_SP_ENH_IP_COMPONENT_DSES:
+            config_setting.config_name = CY_AFE_CONFIG_ECHO_SUPPRESSOR;
+            break;
+        case IFX_SP_ENH_IP_COMPONENT_NS:
+        case IFX_SP_ENH_IP_COMPONENT_DSNS:
+            config_setting.config_name = CY_AFE_CONFIG_NOISE_SUPPRESSOR;
+            break;
+        default:
+            /* High pass filter frequency is not supported by the algorithm */
+            return CY_RSLT_AFE_TUNER_CMD_NOT_SUPPORTED;
+    }
+
+    result = afe_speech_enhancement_update_config_value(context, component, config_value);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    afe_tuner_notify_settings(context, &config_setting);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_get_component_params(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    ifx_sp_enh_ip_component_config_t component;
+    cy_rslt_t result;
+    int32_t values[6];
+    int32_t value_count = sizeof(values)/sizeof(values[0]);
+
+    result = afe_tuner_bin_get_component(payload, length, &component);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    memset(values, 0, sizeof(values));
+    result = afe_speech_enhancement_get_component_params(context, component, values, &value_count);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        return result;
+    }
+
+    afe_tuner_bin_put_values(response, AFE_TUNER_BIN_TLV_VALUES, values, value_count);
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_get_sound_meter(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    int16_t audio_meter[CY_AFE_AUDIO_METER_MAX];
+    uint8_t *value = NULL;
+    uint32_t index = 0;
+
+    afe_speech_enhancement_get_sound_meter(context, audio_meter);
+
+    value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_METER, sizeof(audio_meter));
+    for(index = 0; (NULL != value) && (index < CY_AFE_AUDIO_METER_MAX); index++)
+    {
+        afe_tuner_bin_put_u16(&value[index * sizeof(int16_t)], (uint16_t)audio_meter[index]);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_get_audio_channels(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    afe_usb_settings_t usb_settings;
+    uint8_t *value = NULL;
+
+    afe_speech_enhancement_get_dbg_out_config(context, &usb_settings);
+
+    value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_CHANNELS, 4);
+    if(NULL != value)
+    {
+        value[0] = (uint8_t)usb_settings.channel_0;
+        value[1] = (uint8_t)usb_settings.channel_1;
+        value[2] = (uint8_t)usb_settings.channel_2;
+        value[3] = (uint8_t)usb_settings.channel_3;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_set_audio_channels(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    const uint8_t *value = afe_tuner_bin_find_tlv(payload, length, AFE_TUNER_BIN_TLV_CHANNELS, 4);
+    afe_usb_settings_t usb_settings;
+    uint32_t index = 0;
+
+    if(NULL == value)
+    {
+        return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+    }
+
+    for(index = 0; index < 4; index++)
+    {
+        if(AFE_USB_SELECT_SIG_C < value[index])
+        {
+            return CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS;
+        }
+    }
+
+    usb_settings.channel_0 = value[0];
+    usb_settings.channel_1 = value[1];
+    usb_settings.channel_2 = value[2];
+    usb_settings.channel_3 = value[3];
+
+    return afe_speech_enhancement_set_dbg_out_config(context, &usb_settings);
+}
+
+static cy_rslt_t afe_tuner_bin_get_all_params(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    afe_tuner_params_snapshot_t snapshot;
+    afe_tuner_component_params_t *component = NULL;
+    uint8_t *value = NULL;
+    uint32_t index = 0;
+
+    afe_speech_enhancement_get_all_params(context, &snapshot);
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        component = &snapshot.component[index];
+        if(CY_RSLT_SUCCESS != component->status_result)
+        {
+            continue;
+        }
+
+        value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_COMPONENT, 1);
+        if(NULL != value)
+        {
+            value[0] = (uint8_t)component->id;
+        }
+
+        value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_ENABLE, 1);
+        if(NULL != value)
+        {
+            value[0] = component->enabled ? 1 : 0;
+        }
+
+        if((CY_RSLT_SUCCESS == component->params_result) && (0 < component->value_count))
+        {
+            afe_tuner_bin_put_values(response, AFE_TUNER_BIN_TLV_VALUES, component->values, component->value_count);
+        }
+    }
+
+    value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_CHANNELS, 4);
+    if(NULL != value)
+    {
+        value[0] = (uint8_t)snapshot.usb_settings.channel_0;
+        value[1] = (uint8_t)snapshot.usb_settings.channel_1;
+        value[2] = (uint8_t)snapshot.usb_settings.channel_2;
+        value[3] = (uint8_t)snapshot.usb_settings.channel_3;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t afe_tuner_bin_begin(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    return afe_tuner_transaction_begin(context);
+}
+
+static cy_rslt_t afe_tuner_bin_commit(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    afe_tuner_transaction_t *transaction = &context->tuner_transaction;
+    cy_rslt_t result;
+    uint8_t *value = NULL;
+
+    if(false == transaction->open)
+    {
+        return CY_RSLT_AFE_TUNER_INALID_CMD;
+    }
+
+    result = afe_tuner_transaction_end(context, true);
+    if(CY_RSLT_SUCCESS == result)
+    {
+        value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_COUNT, sizeof(uint32_t));
+        if(NULL != value)
+        {
+            afe_tuner_bin_put_u32(value, transaction->count);
+        }
+    }
+    else if(0 != transaction->failed_index)
+    {
+        /* Position of the first rejected set command, the error response keeps this parameter */
+        value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_INDEX, sizeof(uint32_t));
+        if(NULL != value)
+        {
+            afe_tuner_bin_put_u32(value, transaction->failed_index);
+        }
+    }
+
+    return result;
+}
+
+static cy_rslt_t afe_tuner_bin_abort(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    return afe_tuner_transaction_end(context, false);
+}
+
+static cy_rslt_t afe_tuner_bin_get_tuner_stats(afe_internal_context_t *context, const uint8_t *payload, uint16_t length,
+        afe_tuner_bin_writer_t *response)
+{
+    cy_afe_tuner_stats_t stats;
+    uint8_t *value = NULL;
+
+    afe_speech_enhancement_get_tuner_stats(context, &stats);
+
+    value = afe_tuner_bin_put_tlv(response, AFE_TUNER_BIN_TLV_STATS, 3 * sizeof(uint32_t));
+    if(NULL != value)
+    {
+        afe_tuner_bin_put_u32(&value[0], stats.updates_applied);
+        afe_tuner_bin_put_u32(&value[4], stats.last_apply_latency_ms);
+        afe_tuner_bin_put_u32(&value[8], stats.max_apply_latency_ms);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+uint16_t afe_tuner_binary_frame_length(const uint8_t *data, uint16_t length, uint16_t max_length)
+{
+    uint16_t payload_length = 0;
+
+    if(length < AFE_TUNER_BIN_HEADER_LEN)
+    {
+        return 0;
+    }
+
+    payload_length = afe_tuner_bin_get_u16(&data[4]);
+    if((AFE_TUNER_BIN_SYNC != data[0]) || (0 != (data[1] & AFE_TUNER_BIN_RESPONSE)) ||
+            ((AFE_TUNER_BIN_HEADER_LEN + payload_length + AFE_TUNER_BIN_CRC_LEN) > max_length))
+    {
+        return AFE_TUNER_BIN_FRAME_INVALID;
+    }
+
+    if(length < (AFE_TUNER_BIN_HEADER_LEN + payload_length + AFE_TUNER_BIN_CRC_LEN))
+    {
+        return 0;
+    }
+
+    return (uint16_t)(AFE_TUNER_BIN_HEADER_LEN + payload_length + AFE_TUNER_BIN_CRC_LEN);
+}
+
+void afe_tuner_binary_process_frame(afe_internal_context_t *context, const uint8_t *frame, uint16_t length)
+{
+    afe_tuner_transaction_t *transaction = &context->tuner_transaction;
+    cy_afe_tuner_buffer_t response_buffer;
+    afe_tuner_bin_writer_t response;
+    uint8_t *res = context->afe_response_buffer;
+    uint16_t payload_length = (uint16_t)(length - AFE_TUNER_BIN_HEADER_LEN - AFE_TUNER_BIN_CRC_LEN);
+    uint8_t command = frame[1];
+    uint8_t status = AFE_TUNER_BIN_STATUS_OK;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    memset(&response, 0, sizeof(response));
+    response.payload = res + AFE_TUNER_BIN_HEADER_LEN;
+    response.max_length = (uint16_t)(sizeof(context->afe_response_buffer) - AFE_TUNER_BIN_HEADER_LEN - AFE_TUNER_BIN_CRC_LEN);
+
+    res[0] = AFE_TUNER_BIN_SYNC;
+    res[1] = (uint8_t)(command | AFE_TUNER_BIN_RESPONSE);
+    res[2] = frame[2];
+
+    if(afe_tuner_bin_crc16(frame, length - AFE_TUNER_BIN_CRC_LEN) != afe_tuner_bin_get_u16(&frame[length - AFE_TUNER_BIN_CRC_LEN]))
+    {
+        cy_afe_log_err(CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS, "Tuner frame CRC mismatch, command %u", command);
+        status = AFE_TUNER_BIN_STATUS_CRC_ERROR;
+        goto send_response;
+    }
+
+    cy_afe_log_dbg("Tuner binary command received:%u length:%u", command, payload_length);
+
+    if((command >= AFE_TUNER_BIN_CMD_MAX) || (NULL == afe_tuner_bin_cmds[command].handler))
+    {
+        result = CY_RSLT_AFE_TUNER_INALID_CMD;
+    }
+    else if((true == transaction->open) && (true == afe_tuner_bin_cmds[command].staged))
+    {
+        /* Staged until commit, which answers for all the set commands of the transaction */
+        transaction->count++;
+        result = afe_tuner_bin_cmds[command].handler(context, &frame[AFE_TUNER_BIN_HEADER_LEN], payload_length, &response);
+        if((CY_RSLT_SUCCESS != result) && (CY_RSLT_SUCCESS == transaction->result))
+        {
+            transaction->result = result;
+            transaction->failed_index = transaction->count;
+        }
+        return;
+    }
+    else
+    {
+        result = afe_tuner_bin_cmds[command].handler(context, &frame[AFE_TUNER_BIN_HEADER_LEN], payload_length, &response);
+    }
+
+    if(true == response.overflow)
+    {
+        result = CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
+        cy_afe_log_err(result, "Sizeof AFE response buffer is not sufficient");
+        response.length = 0;
+    }
+    status = afe_tuner_bin_status(result);
+
+send_response:
+    res[3] = status;
+    afe_tuner_bin_put_u16(&res[4], response.length);
+    afe_tuner_bin_put_u16(&res[AFE_TUNER_BIN_HEADER_LEN + response.length],
+            afe_tuner_bin_crc16(res, AFE_TUNER_BIN_HEADER_LEN + response.length));
+
+    memset(&response_buffer, 0, sizeof(cy_afe_tuner_buffer_t));
+    response_buffer.buffer = res;
+    response_buffer.length = (uint16_t)(AFE_TUNER_BIN_HEADER_LEN + response.length + AFE_TUNER_BIN_CRC_LEN);
+
+#ifdef ENABLE_AFE_MW_TUNER_CHECK_POINT
+    AFE_MW_TUNER_CHECK_POINT()
+#endif
+
+    context->tuner_callbacks.write_response_callback(context, &response_buffer, context->config_init.user_arg_callbacks);
+
+#ifdef ENABLE_AFE_MW_TUNER_CHECK_POINT
+    AFE_MW_TUNER_CHECK_POINT()
+#endif
+}
+
+#endif
@@ -47,12 +47,14 @@
 /******************************************************
  *                     Macros
  ******************************************************/
-#define SET_CMD "set"
-#define GET_CMD "get"
-
 #define SET_START_STREAM "start_stream"
 #define SET_STOP_STREAM "stop_stream"
 #define AFE_SOUND_METER "sound_meter"
+#define AFE_ALL_PARAMS "all_params"
+
+#define TRANSACTION_BEGIN  "begin"
+#define TRANSACTION_COMMIT "commit"
+#define TRANSACTION_ABORT  "abort"
 
 #define COMPONENT_ED_NAME_IC    "comp_bf"
 #define COMPONENT_ED_NAME_DR    "comp_dr"
@@ -135,6 +137,26 @@ const static struct {
 #endif
 };
 
+const static struct {
+    ifx_sp_enh_ip_component_config_t val;
+    const char *str;
+} sp_enh_ip_all_params_component_name [] = {
+    {IFX_SP_ENH_IP_COMPONENT_HPF, "hpf"},
+    {IFX_SP_ENH_IP_COMPONENT_AEC, "aec"},
+    {IFX_SP_ENH_IP_COMPONENT_BF, "bf"},
+    {IFX_SP_ENH_IP_COMPONENT_DRVB, "dr"},
+#ifdef ENABLE_IFX_ES
+    {IFX_SP_ENH_IP_COMPONENT_ES, "es"},
+#else
+    {IFX_SP_ENH_IP_COMPONENT_DSES, "es"},
+#endif
+#ifdef ENABLE_IFX_NS
+    {IFX_SP_ENH_IP_COMPONENT_NS, "ns"},
+#else
+    {IFX_SP_ENH_IP_COMPONENT_DSNS, "ns"},
+#endif
+};
+
 
 
 static cy_rslt_t config_input_gain(void *context, char** params, int params_cnt);
@@ -151,49 +173,55 @@ static cy_rslt_t config_start_aec_calibration(void *context, char** params, int
 static cy_rslt_t config_get_sound_meter(void *context, char** params, int params_cnt);
 static cy_rslt_t config_get_component_params(void *context, char** params, int params_cnt);
 static cy_rslt_t config_get_input_params(void *context, char** params, int params_cnt);
+static cy_rslt_t config_get_all_params(void *context, char** params, int params_cnt);
+static cy_rslt_t config_transaction(void *context, char** params, int params_cnt);
 
 /******************************************************
  *                 Global Variables
  ******************************************************/
 cy_afe_tuner_cmd_t cmds[]=
 {
-    {SET_CMD, "input_gain",                   config_input_gain,                  1, ","},
-    {GET_CMD, "input_gain",                   config_input_gain,                  0, ","},
-    {SET_CMD, "hpf",                          config_hpf,                         1, ","}, //ToDo:- Do not support freq, need to enable once algo supported
-    {GET_CMD, "hpf",                          config_hpf,                         0, ","},
-    {SET_CMD, "bulk_delay",                   config_bulk_delay,                  1, ","},
-    {GET_CMD, "bulk_delay",                   config_bulk_delay,                  0, ","},
-    {GET_CMD, "ic",                           config_ic,                          0, ","},
-    {SET_CMD, "ic",                           config_ic,                          1, ","},
-    {GET_CMD, "es",                           config_es,                          0, ","},
-    {SET_CMD, "es",                           config_es,                          1, ","},
-    {GET_CMD, "ns",                           config_ns,                          0, ","},
-    {SET_CMD, "ns",                           config_ns,                          1, ","},
-    {SET_CMD, COMPONENT_ED_NAME_IC,           config_enable_or_disable_module,    1, ","},
-    {GET_CMD, COMPONENT_ED_NAME_IC,           config_enable_or_disable_module,    0, ","},
-    {SET_CMD, COMPONENT_ED_NAME_DR,           config_enable_or_disable_module,    1, ","},
-    {GET_CMD, COMPONENT_ED_NAME_DR,           config_enable_or_disable_module,    0, ","},
-    // {SET_CMD, COMPONENT_ED_NAME_NS_ES,        config_enable_or_disable_module,    1, ","},
-    // {GET_CMD, COMPONENT_ED_NAME_NS_ES,        config_enable_or_disable_module,    0, ","},
-    {SET_CMD, COMPONENT_ED_NAME_NS,           config_enable_or_disable_module,    1, ","},
-    {GET_CMD, COMPONENT_ED_NAME_NS,           config_enable_or_disable_module,    0, ","},
-    {SET_CMD, COMPONENT_ED_NAME_ES,           config_enable_or_disable_module,    1, ","},
-    {GET_CMD, COMPONENT_ED_NAME_ES,           config_enable_or_disable_module,    0, ","},
-    {SET_CMD, COMPONENT_ED_NAME_AEC,          config_enable_or_disable_module,    1, ","},
-    {GET_CMD, COMPONENT_ED_NAME_AEC,          config_enable_or_disable_module,    0, ","},
-    {SET_START_STREAM, NULL,                  config_start_stop_stream,           0, ","},
-    {SET_STOP_STREAM,  NULL,                  config_start_stop_stream,           0, ","},
-    {SET_CMD, "audio-channels",               config_set_audio_channels,          4, ","},
-    {GET_CMD, "audio-channels",               config_get_audio_channels,          0, ","},
-    {"start", "aec-calibration",              config_start_aec_calibration,       0, ","},
-    {GET_CMD, AFE_SOUND_METER,                config_get_sound_meter,             0, ","},
-    {GET_CMD, COMPONENT_NAME_HPF_PARAM,       config_get_component_params,        0, ","},
-    {GET_CMD, COMPONENT_NAME_AEC_PARAM,       config_get_component_params,        0, ","},
-    {GET_CMD, COMPONENT_NAME_BF_PARAM,        config_get_component_params,        0, ","},
-    {GET_CMD, COMPONENT_NAME_ES_PARAM,        config_get_component_params,        0, ","},
-    {GET_CMD, COMPONENT_NAME_NS_PARAM,        config_get_component_params,        0, ","},
-    {GET_CMD, COMPONENT_NAME_INPUT_PARAM,     config_get_input_params,            0, ","},
-    { NULL, NULL, NULL, 0, NULL}
+    {SET_CMD, "input_gain",                   config_input_gain,                  1, ",", false},
+    {GET_CMD, "input_gain",                   config_input_gain,                  0, ",", false},
+    {SET_CMD, "hpf",                          config_hpf,                         1, ",", false}, //ToDo:- Do not support freq, need to enable once algo supported
+    {GET_CMD, "hpf",                          config_hpf,                         0, ",", false},
+    {SET_CMD, "bulk_delay",                   config_bulk_delay,                  1, ",", true},
+    {GET_CMD, "bulk_delay",                   config_bulk_delay,                  0, ",", false},
+    {GET_CMD, "ic",                           config_ic,                          0, ",", false},
+    {SET_CMD, "ic",                           config_ic,                          1, ",", true},
+    {GET_CMD, "es",                           config_es,                          0, ",", false},
+    {SET_CMD, "es",                           config_es,                          1, ",", true},
+    {GET_CMD, "ns",                           config_ns,                          0, ",", false},
+    {SET_CMD, "ns",                           config_ns,                          1, ",", true},
+    {SET_CMD, COMPONENT_ED_NAME_IC,           config_enable_or_disable_module,    1, ",", true},
+    {GET_CMD, COMPONENT_ED_NAME_IC,           config_enable_or_disable_module,    0, ",", false},
+    {SET_CMD, COMPONENT_ED_NAME_DR,           config_enable_or_disable_module,    1, ",", true},
+    {GET_CMD, COMPONENT_ED_NAME_DR,           config_enable_or_disable_module,    0, ",", false},
+    // {SET_CMD, COMPONENT_ED_NAME_NS_ES,        config_enable_or_disable_module,    1, ",", false},
+    // {GET_CMD, COMPONENT_ED_NAME_NS_ES,        config_enable_or_disable_module,    0, ",", false},
+    {SET_CMD, COMPONENT_ED_NAME_NS,           config_enable_or_disable_module,    1, ",", true},
+    {GET_CMD, COMPONENT_ED_NAME_NS,           config_enable_or_disable_module,    0, ",", false},
+    {SET_CMD, COMPONENT_ED_NAME_ES,           config_enable_or_disable_module,    1, ",", true},
+    {GET_CMD, COMPONENT_ED_NAME_ES,           config_enable_or_disable_module,    0, ",", false},
+    {SET_CMD, COMPONENT_ED_NAME_AEC,          config_enable_or_disable_module,    1, ",", true},
+    {GET_CMD, COMPONENT_ED_NAME_AEC,          config_enable_or_disable_module,    0, ",", false},
+    {SET_START_STREAM, NULL,                  config_start_stop_stream,           0, ",", false},
+    {SET_STOP_STREAM,  NULL,                  config_start_stop_stream,           0, ",", false},
+    {SET_CMD, "audio-channels",               config_set_audio_channels,          4, ",", true},
+    {GET_CMD, "audio-channels",               config_get_audio_channels,          0, ",", false},
+    {"start", "aec-calibration",              config_start_aec_calibration,       0, ",", false},
+    {GET_CMD, AFE_SOUND_METER,                config_get_sound_meter,             0, ",", false},
+    {GET_CMD, COMPONENT_NAME_HPF_PARAM,       config_get_component_params,        0, ",", false},
+    {GET_CMD, COMPONENT_NAME_AEC_PARAM,       config_get_component_params,        0, ",", false},
+    {GET_CMD, COMPONENT_NAME_BF_PARAM,        config_get_component_params,        0, ",", false},
+    {GET_CMD, COMPONENT_NAME_ES_PARAM,        config_get_component_params,        0, ",", false},
+    {GET_CMD, COMPONENT_NAME_NS_PARAM,        config_get_component_params,        0, ",", false},
+    {GET_CMD, COMPONENT_NAME_INPUT_PARAM,     config_get_input_params,            0, ",", false},
+    {GET_CMD, AFE_ALL_PARAMS,                 config_get_all_params,              0, ",", false},
+    {TRANSACTION_BEGIN,  NULL,                config_transaction,                 0, ",", false},
+    {TRANSACTION_COMMIT, NULL,                config_transaction,                 0, ",", false},
+    {TRANSACTION_ABORT,  NULL,                config_transaction,                 0, ",", false},
+    { NULL, NULL, NULL, 0, NULL, false}
 };
 
 
@@ -238,6 +266,113 @@ static cy_rslt_t afe_str_to_sp_enh_ip_component_id (const char *str, ifx_sp_enh_
      return CY_RSLT_SUCCESS;
 }
 
+/**
+ * Notify the application of a setting applied by AFE. Settings staged by an open transaction are
+ * notified once the transaction is committed.
+ */
+void afe_tuner_notify_settings(afe_internal_context_t *handle, cy_afe_config_setting_t *config_setting)
+{
+    afe_tuner_transaction_t *transaction = &handle->tuner_transaction;
+    uint32_t index = 0;
+
+    if(false == transaction->open)
+    {
+        handle->tuner_callbacks.notify_settings_callback(handle, config_setting,
+                handle->config_init.user_arg_callbacks);
+        return;
+    }
+
+    /* A setting changed twice in the transaction is notified once with the last value */
+    for(index = 0; index < transaction->notify_count; index++)
+    {
+        if(transaction->notify[index].config_name == config_setting->config_name)
+        {
+            break;
+        }
+    }
+
+    if(index == AFE_TUNER_TRANSACTION_MAX_NOTIFY)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_TUNER_INTERNAL_ERROR, "Too many settings in transaction, %d not notified",
+                config_setting->config_name);
+        return;
+    }
+
+    transaction->notify[index].config_name = config_setting->config_name;
+    transaction->notify[index].value = *(int*)config_setting->value;
+    if(index == transaction->notify_count)
+    {
+        transaction->notify_count++;
+    }
+}
+
+/**
+ * Open a transaction, set commands are staged until it is closed
+ */
+cy_rslt_t afe_tuner_transaction_begin(afe_internal_context_t *handle)
+{
+    afe_tuner_transaction_t *transaction = &handle->tuner_transaction;
+    cy_rslt_t result;
+
+    result = afe_speech_enhancement_begin_params_transaction(handle);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Tuner transaction already open");
+        return result;
+    }
+
+    memset(transaction, 0, sizeof(afe_tuner_transaction_t));
+    transaction->open = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * Close the transaction. On commit the staged settings are applied in a single frame boundary
+ * unless a set command of the transaction failed, and the application is notified of them.
+ */
+cy_rslt_t afe_tuner_transaction_end(afe_internal_context_t *handle, bool commit)
+{
+    afe_tuner_transaction_t *transaction = &handle->tuner_transaction;
+    cy_afe_config_setting_t config_setting;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index = 0;
+
+    if(false == transaction->open)
+    {
+        result = CY_RSLT_AFE_TUNER_INALID_CMD;
+        cy_afe_log_err(result, "No tuner transaction open");
+        return result;
+    }
+    transaction->open = false;
+
+    if((false == commit) || (CY_RSLT_SUCCESS != transaction->result))
+    {
+        /* Aborted, or a command was rejected: none of the transaction is applied */
+        afe_speech_enhancement_abort_params_transaction(handle);
+        return commit ? transaction->result : CY_RSLT_SUCCESS;
+    }
+
+    result = afe_speech_enhancement_commit_params_transaction(handle);
+    if(CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "Failed to apply tuner transaction");
+        return result;
+    }
+
+    memset(&config_setting, 0, sizeof(cy_afe_config_setting_t));
+    config_setting.action = CY_AFE_NOTIFY_CONFIG;
+    for(index = 0; index < transaction->notify_count; index++)
+    {
+        config_setting.config_name = transaction->notify[index].config_name;
+        config_setting.value = (int*) &transaction->notify[index].value;
+        handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
+                handle->config_init.user_arg_callbacks);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
 static cy_rslt_t config_start_stop_stream(void *context, char** params, int params_cnt)
 {
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
@@ -450,8 +585,7 @@ static cy_rslt_t config_bulk_delay(void *context, char** params, int params_cnt)
     AFE_MW_TUNER_CHECK_POINT()
 #endif
 
-        handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
-                handle->config_init.user_arg_callbacks);
+        afe_tuner_notify_settings(handle, &config_setting);
 
 #ifdef ENABLE_AFE_MW_TUNER_CHECK_POINT
     AFE_MW_TUNER_CHECK_POINT()
@@ -510,8 +644,7 @@ static cy_rslt_t config_ic(void *context, char** params, int params_cnt)
         config_setting.config_name = CY_AFE_CONFIG_INFERENCE_CANCELLER;
         config_setting.value = (int*) &aggressiveness;
 
-        handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
-                handle->config_init.user_arg_callbacks);
+        afe_tuner_notify_settings(handle, &config_setting);
         afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
     }
     else
@@ -569,8 +702,7 @@ static cy_rslt_t config_es(void *context, char** params, int params_cnt)
         config_setting.config_name = CY_AFE_CONFIG_ECHO_SUPPRESSOR;
         config_setting.value = (int*)&echo_suppressor;
 
-        handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
-                handle->config_init.user_arg_callbacks);
+        afe_tuner_notify_settings(handle, &config_setting);
         afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
     }
     else
@@ -623,8 +755,7 @@ static cy_rslt_t config_ns(void *context, char** params, int params_cnt)
         config_setting.config_name = CY_AFE_CONFIG_NOISE_SUPPRESSOR;
         config_setting.value = (int*) &suppression_gain_db;
 
-        handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
-                handle->config_init.user_arg_callbacks);
+        afe_tuner_notify_settings(handle, &config_setting);
         afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
     }
     else
@@ -773,7 +904,7 @@ static cy_rslt_t config_set_audio_channels(void *context, char** params, int par
         goto send_response;
     }
 
-    result = afe_speech_enhancement_update_dbg_out_config(handle->sp_enh_context, &AFE_USB_SETTINGS);
+    result = afe_speech_enhancement_set_dbg_out_config(handle, &AFE_USB_SETTINGS);
     if(CY_RSLT_SUCCESS != result)
     {
         cy_afe_log_err(result, "Failed to update debug config");
@@ -783,7 +914,6 @@ static cy_rslt_t config_set_audio_channels(void *context, char** params, int par
     else
     {
         afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
-        MY_AFE_USB_SETTINGS = AFE_USB_SETTINGS;
     }
     return CY_RSLT_SUCCESS;
 
@@ -798,11 +928,13 @@ static cy_rslt_t config_get_audio_channels(void *context, char** params, int par
     afe_internal_context_t *handle = (afe_internal_context_t*) context;
     cy_rslt_t result;
     char data[16] = {0};
+    afe_usb_settings_t usb_settings;
 
     memset(data, 0, sizeof(data));
 
-    sprintf(data, "%u,%u,%u,%u", MY_AFE_USB_SETTINGS.channel_0, MY_AFE_USB_SETTINGS.channel_1,
-            MY_AFE_USB_SETTINGS.channel_2, MY_AFE_USB_SETTINGS.channel_3);
+    afe_speech_enhancement_get_dbg_out_config(handle, &usb_settings);
+    sprintf(data, "%u,%u,%u,%u", usb_settings.channel_0, usb_settings.channel_1,
+            usb_settings.channel_2, usb_settings.channel_3);
     result = CY_RSLT_SUCCESS;
     afe_send_tuner_command_res(handle, get_status_string_from_result(result), data);
 
@@ -833,7 +965,7 @@ static cy_rslt_t config_start_aec_calibration(void *context, char** params, int
     handle->tuner_callbacks.notify_settings_callback(handle, &config_setting,
         handle->config_init.user_arg_callbacks);
 
-    cy_afe_bd_calc_wait_for_complete(CY_RTOS_NEVER_TIMEOUT, &bulk_delay_ms);
+    cy_afe_bd_calc_wait_for_complete(handle, CY_RTOS_NEVER_TIMEOUT, &bulk_delay_ms);
 
     config_setting.action = CY_AFE_NOTIFY_CONFIG;
     config_setting.config_name = CY_AFE_CONFIG_BULK_DELAY_CALC_STOPPED;
@@ -867,11 +999,14 @@ static cy_rslt_t config_get_sound_meter(void *context, char** params, int params
     memset(audio_meter_data, 0, sizeof(audio_meter_data));
     afe_speech_enhancement_get_sound_meter(context, audio_meter_data);
 
-#if CY_AFE_INPUT_NUM_OF_CHANNELS == 2
-    sprintf(data, "%"PRIu16",%"PRIu16",%"PRIu16, audio_meter_data[0], audio_meter_data[1],audio_meter_data[2]);
-#else
-    sprintf(data, "%"PRIu16",%"PRIu16, audio_meter_data[0], audio_meter_data[1]);
-#endif
+    if (CY_AFE_AUDIO_STEREO_CHANNEL == handle->num_channels)
+    {
+        sprintf(data, "%"PRIu16",%"PRIu16",%"PRIu16, audio_meter_data[0], audio_meter_data[1],audio_meter_data[2]);
+    }
+    else
+    {
+        sprintf(data, "%"PRIu16",%"PRIu16, audio_meter_data[0], audio_meter_data[1]);
+    }
 
     result = CY_RSLT_SUCCESS;
     afe_send_tuner_command_res(handle, get_status_string_from_result(result), data);
@@ -991,8 +1126,8 @@ static cy_rslt_t config_get_input_params(void *context, char** params, int param
     cy_rslt_t result = CY_RSLT_AFE_BAD_ARG;
     cy_afe_config_setting_t config_setting;
     char data[160];
-    int32_t input_gain, num_channels = AFE_INPUT_NUMBER_CHANNELS, input_source = AFE_INPUT_SOURCE;
-    int32_t input_frame_ms = AFE_FRAME_SIZE_MS, input_sr = AFE_FRAME_RATE_SPS, aec_ref = AFE_USE_USB_AEC_REF;
+    int32_t input_gain, num_channels = (int32_t)handle->num_channels, input_source = AFE_INPUT_SOURCE;
+    int32_t input_frame_ms = (int32_t)handle->frame_size_ms, input_sr = (int32_t)handle->sample_rate, aec_ref = AFE_USE_USB_AEC_REF;
     int32_t uart_br = AFE_UART_BAUDRATE, target_speaker = AFE_USE_TARGET_SPEAKER;
 
     memset(data, 0, sizeof(data));
@@ -1030,4 +1165,148 @@ send_response:
     return CY_RSLT_SUCCESS;
 }
 
+static const char *afe_level_to_string(int32_t level)
+{
+    return (level==0)?"low":(level==1)?"medium":"high";
+}
+
+/**
+ * Read back all component states and parameters in one response:
+ * <component>,<enabled>[,<parameters>];...;audio-channels,<ch0>,<ch1>,<ch2>,<ch3>
+ */
+static cy_rslt_t config_get_all_params(void *context, char** params, int params_cnt)
+{
+    afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_params_snapshot_t snapshot;
+    afe_tuner_component_params_t *component = NULL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    char data[CY_AFE_TUNER_MAX_RESPONSE_BUFFER_SIZE];
+    int length = 0;
+    int32_t value_index = 0;
+    uint32_t name_index = 0;
+    uint32_t index = 0;
+
+    memset(data, 0, sizeof(data));
+
+    afe_speech_enhancement_get_all_params(handle, &snapshot);
+
+    for(index = 0; index < AFE_TUNER_PARAMS_COMPONENTS; index++)
+    {
+        component = &snapshot.component[index];
+        if(CY_RSLT_SUCCESS != component->status_result)
+        {
+            continue;
+        }
+
+        for(name_index = 0; name_index < sizeof(sp_enh_ip_all_params_component_name)/sizeof(sp_enh_ip_all_params_component_name[0]); name_index++)
+        {
+            if(sp_enh_ip_all_params_component_name[name_index].val == component->id)
+            {
+                break;
+            }
+        }
+        if(name_index == sizeof(sp_enh_ip_all_params_component_name)/sizeof(sp_enh_ip_all_params_component_name[0]))
+        {
+            continue;
+        }
+
+        length += snprintf(data + length, sizeof(data) - length, "%s,%d",
+                sp_enh_ip_all_params_component_name[name_index].str, component->enabled);
+
+        if(CY_RSLT_SUCCESS == component->params_result)
+        {
+            for(value_index = 0; value_index < component->value_count; value_index++)
+            {
+                /* Aggressiveness of BF and ES is reported as a level, like the set commands take it */
+                if((0 == value_index) && ((IFX_SP_ENH_IP_COMPONENT_BF == component->id) ||
+                        (IFX_SP_ENH_IP_COMPONENT_ES == component->id) || (IFX_SP_ENH_IP_COMPONENT_DSES == component->id)))
+                {
+                    length += snprintf(data + length, sizeof(data) - length, ",%s", afe_level_to_string(component->values[0]));
+                }
+                else
+                {
+                    length += snprintf(data + length, sizeof(data) - length, ",%"PRIi32, component->values[value_index]);
+                }
+            }
+        }
+
+        length += snprintf(data + length, sizeof(data) - length, ";");
+        if(length >= (int)sizeof(data))
+        {
+            result = CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
+            cy_afe_log_err(result, "All params do not fit the response");
+            goto send_response;
+        }
+    }
+
+    length += snprintf(data + length, sizeof(data) - length, "audio-channels,%u,%u,%u,%u",
+            snapshot.usb_settings.channel_0, snapshot.usb_settings.channel_1,
+            snapshot.usb_settings.channel_2, snapshot.usb_settings.channel_3);
+    if(length >= (int)sizeof(data))
+    {
+        result = CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
+        cy_afe_log_err(result, "All params do not fit the response");
+        goto send_response;
+    }
+
+    afe_send_tuner_command_res(handle, get_status_string_from_result(result), data);
+    return CY_RSLT_SUCCESS;
+
+send_response:
+    afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
+    return CY_RSLT_SUCCESS;
+}
+
+/**
+ * begin: set commands received until commit are validated and staged, without response.
+ * commit: apply the staged settings in a single frame boundary, one response for all of them:
+ *         ok,<number of set commands> or <status of the first failed command>,<its index>.
+ * abort: drop the staged settings.
+ */
+static cy_rslt_t config_transaction(void *context, char** params, int params_cnt)
+{
+    afe_internal_context_t *handle = (afe_internal_context_t*) context;
+    afe_tuner_transaction_t *transaction = &handle->tuner_transaction;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    char data[12];
+
+    memset(data, 0, sizeof(data));
+
+    if(strcmp(TRANSACTION_BEGIN, params[0]) == 0)
+    {
+        result = afe_tuner_transaction_begin(handle);
+        goto send_response;
+    }
+
+    if(strcmp(TRANSACTION_ABORT, params[0]) == 0)
+    {
+        result = afe_tuner_transaction_end(handle, false);
+        goto send_response;
+    }
+
+    if(false == transaction->open)
+    {
+        result = CY_RSLT_AFE_TUNER_INALID_CMD;
+        goto send_response;
+    }
+
+    result = afe_tuner_transaction_end(handle, true);
+    if((CY_RSLT_SUCCESS != result) && (0 != transaction->failed_index))
+    {
+        snprintf(data, sizeof(data) - 1, "%"PRIu32, transaction->failed_index);
+        afe_send_tuner_command_res(handle, get_status_string_from_result(result), data);
+        return CY_RSLT_SUCCESS;
+    }
+    else if(CY_RSLT_SUCCESS == result)
+    {
+        snprintf(data, sizeof(data) - 1, "%"PRIu32, transaction->count);
+        afe_send_tuner_command_res(handle, get_status_string_from_result(result), data);
+        return CY_RSLT_SUCCESS;
+    }
+
+send_response:
+    afe_send_tuner_command_res(handle, get_status_string_from_result(result), NULL);
+    return CY_RSLT_SUCCESS;
+}
+
 #endif
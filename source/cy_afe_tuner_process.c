@@ -41,6 +41,7 @@
 #include "cy_audio_front_end.h"
 #include "include/cy_afe_audio_internal.h"
 #include "include/cy_afe_tuner_process.h"
+#include "include/cy_afe_tuner_binary.h"
 
 /******************************************************
  *                     Macros
@@ -78,6 +79,7 @@ extern cy_afe_tuner_cmd_t cmds[];
  *               Static Functions
  ******************************************************/
 static cy_rslt_t afe_process_tuner_command_req(afe_internal_context_t* context, uint8_t* req_cmd, uint16_t req_len);
+static cy_rslt_t afe_process_buffered_tuner_requests(afe_internal_context_t* context);
 
 /******************************************************
  *               Functions
@@ -145,6 +147,33 @@ const char* get_status_string_from_result(cy_rslt_t result)
     return str;
 }
 
+/**
+ * Get the result a status string was made from, CY_RSLT_AFE_TUNER_INTERNAL_ERROR if unknown
+ */
+static cy_rslt_t afe_tuner_result_from_status(const char *status)
+{
+    static const cy_rslt_t results[] =
+    {
+        CY_RSLT_SUCCESS,
+        CY_RSLT_AFE_TUNER_INALID_CMD,
+        CY_RSLT_AFE_TUNER_GENERIC_ERROR,
+        CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS,
+        CY_RSLT_AFE_TUNER_COMPONENT_NOT_ENABLED,
+        CY_RSLT_AFE_TUNER_CMD_NOT_SUPPORTED,
+    };
+    uint32_t index = 0;
+
+    for(index = 0; index < sizeof(results)/sizeof(results[0]); index++)
+    {
+        if(0 == strcmp(status, get_status_string_from_result(results[index])))
+        {
+            return results[index];
+        }
+    }
+
+    return CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
+}
+
 /**
  * Function to send response back to configurator tool
  */
@@ -155,13 +184,25 @@ cy_rslt_t afe_send_tuner_command_res(afe_internal_context_t *context, const char
     int length = 0;
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
+    /* Set commands of a transaction are answered by the commit, which reports the first failure */
+    if(true == context->tuner_transaction.fold_response)
+    {
+        if((CY_RSLT_SUCCESS == context->tuner_transaction.result) &&
+                (0 != strcmp(status, get_status_string_from_result(CY_RSLT_SUCCESS))))
+        {
+            context->tuner_transaction.result = afe_tuner_result_from_status(status);
+            context->tuner_transaction.failed_index = context->tuner_transaction.count;
+        }
+        return CY_RSLT_SUCCESS;
+    }
+
     memset(&response_buffer, 0, sizeof(cy_afe_tuner_buffer_t));
     memset(context->afe_response_buffer, 0, sizeof(context->afe_response_buffer));
 
     res = context->afe_response_buffer;
     response_buffer.buffer = res;
 
-    if(strlen(status + AFE_CRLF_LEN + AFE_RESPONSE_HEADER_LEN) > (sizeof(context->afe_response_buffer)-1))
+    if((strlen(status) + AFE_CRLF_LEN + AFE_RESPONSE_HEADER_LEN) > (sizeof(context->afe_response_buffer)-1))
     {
         result = CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
         cy_afe_log_err(result, "Sizeof AFE response buffer is not sufficient");
@@ -181,7 +222,7 @@ cy_rslt_t afe_send_tuner_command_res(afe_internal_context_t *context, const char
     /* Added response text, if any */
     if(NULL != text)
     {
-        if((strlen(status)+ strlen(text) + AFE_CRLF_LEN) > (sizeof(context->afe_response_buffer)-1))
+        if((AFE_RESPONSE_HEADER_LEN + strlen(status) + 1 + strlen(text) + AFE_CRLF_LEN) > (sizeof(context->afe_response_buffer)-1))
         {
             result = CY_RSLT_AFE_TUNER_INTERNAL_ERROR;
             cy_afe_log_err(result, "Sizeof AFE response buffer is not sufficient");
@@ -220,7 +261,8 @@ cy_rslt_t afe_send_tuner_command_res(afe_internal_context_t *context, const char
 }
 
 /**
- * Process received tuner command request from configurator tool
+ * Process received text command request from configurator tool. The command is tokenized in place,
+ * req_cmd holds at least req_len + 1 bytes.
  */
 static cy_rslt_t afe_process_tuner_command_req(afe_internal_context_t* context, uint8_t* req_cmd, uint16_t req_len)
 {
@@ -231,25 +273,18 @@ static cy_rslt_t afe_process_tuner_command_req(afe_internal_context_t* context,
     int params_cnt = 0;
     bool cmd_found = false;
 
-    char *copy = malloc (req_len + 1);
-    if ( copy == NULL )
-    {
-        return CY_RSLT_AFE_OUT_OF_MEMORY;
-    }
-
     cy_afe_log_dbg("Tuner command received:%.*s", req_len, req_cmd);
 
-    memset(copy, 0, req_len+ 1);
-    memcpy(copy, req_cmd, req_len);
+    req_cmd[req_len] = '\0';
 
-    params[params_cnt++] = strtok_r(copy,",", &saveptr);
+    params[params_cnt++] = strtok_r((char*)req_cmd, ",", &saveptr);
     params[params_cnt++] = strtok_r( NULL, (char *) ",", &saveptr);
 
-    for(cmd = cmds; cmd->cmd_name != NULL; cmd++)
+    for(cmd = cmds; (NULL != params[0]) && (cmd->cmd_name != NULL); cmd++)
     {
         if(NULL != cmd->sub_cmd_name)
         {
-            if((strcmp(cmd->cmd_name, params[0]) == 0) && (strcmp(cmd->sub_cmd_name, params[1]) == 0))
+            if((strcmp(cmd->cmd_name, params[0]) == 0) && (NULL != params[1]) && (strcmp(cmd->sub_cmd_name, params[1]) == 0))
             {
                 cmd_found = true;
                 break;
@@ -278,47 +313,127 @@ static cy_rslt_t afe_process_tuner_command_req(afe_internal_context_t* context,
     else
     {
         /* parse arguments */
-        while ( saveptr != NULL && saveptr[ 0 ] != '\0' )
+        while ( saveptr != NULL && saveptr[ 0 ] != '\0' && params_cnt < MAX_NUM_PARAMS )
         {
             params[params_cnt++] = strtok_r( NULL, (char *) ",", &saveptr );
         }
 
-        cmd->command(context, params, params_cnt);
+        if((uint32_t)(params_cnt - 2) < cmd->arg_count)
+        {
+            result = afe_send_tuner_command_res(context, get_status_string_from_result(CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS), NULL);
+        }
+        else if((true == context->tuner_transaction.open) && (strcmp(SET_CMD, params[0]) == 0))
+        {
+            /* Staged until commit. Settings applied by the application cannot be part of the frame boundary update. */
+            context->tuner_transaction.count++;
+            context->tuner_transaction.fold_response = true;
+            if(true == cmd->transaction)
+            {
+                cmd->command(context, params, params_cnt);
+            }
+            else
+            {
+                afe_send_tuner_command_res(context, get_status_string_from_result(CY_RSLT_AFE_TUNER_CMD_NOT_SUPPORTED), NULL);
+            }
+            context->tuner_transaction.fold_response = false;
+        }
+        else
+        {
+            cmd->command(context, params, params_cnt);
+        }
     }
 
-    free(copy);
-
     return CY_RSLT_SUCCESS;
 }
 
 /**
- * Check for newline(\r\n) in the received command
+ * Process the binary frames and text commands complete in the local command buffer and
+ * keep the partial one, if any, at the start of the buffer
  */
-static bool check_for_newline_in_received_data(uint8_t* data, uint16_t length)
+static cy_rslt_t afe_process_buffered_tuner_requests(afe_internal_context_t* context)
 {
-    if(length > 2)
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint8_t *data = context->internal_request_cmd_buffer;
+    uint8_t *newline = NULL;
+    uint8_t *sync = NULL;
+    uint16_t frame_len = 0;
+
+    while(context->internal_request_cmd_len > 0)
     {
-        if(data[length-2] == '\r' && data[length-1] == '\n')
+        if(AFE_TUNER_BIN_SYNC == data[0])
+        {
+            frame_len = afe_tuner_binary_frame_length(data, context->internal_request_cmd_len,
+                    (uint16_t)(context->internal_request_cmd_buffer_size - 1));
+            if(AFE_TUNER_BIN_FRAME_INVALID == frame_len)
+            {
+                /* Not a frame header, resynchronize on the next byte */
+                frame_len = 1;
+            }
+            else if(0 != frame_len)
+            {
+                afe_tuner_binary_process_frame(context, data, frame_len);
+            }
+        }
+        else
+        {
+            /**
+             * Check if command received ends with \r\n, if yes, then start processing command
+             */
+            newline = memchr(data, '\n', context->internal_request_cmd_len);
+            sync = memchr(data, AFE_TUNER_BIN_SYNC, context->internal_request_cmd_len);
+            frame_len = 0;
+            if((NULL != sync) && ((NULL == newline) || (sync < newline)))
+            {
+                /* Text commands are ASCII, drop the partial line in front of a binary frame */
+                frame_len = (uint16_t)(sync - data);
+            }
+            else if(NULL != newline)
+            {
+                frame_len = (uint16_t)(newline - data) + 1;
+                if((frame_len >= NEWLINE_AT_END_OF_CMD) && ('\r' == newline[-1]))
+                {
+                    result = afe_process_tuner_command_req(context, data, (frame_len - NEWLINE_AT_END_OF_CMD));
+                    if (CY_RSLT_SUCCESS != result)
+                    {
+                        cy_afe_log_err(result, "Failed to process tuner commands");
+                    }
+                }
+            }
+        }
+
+        if(0 == frame_len)
         {
-            return true;
+            if(context->internal_request_cmd_len >= (context->internal_request_cmd_buffer_size - 1))
+            {
+                /* Command longer than the buffer, drop it */
+                cy_afe_log_err(CY_RSLT_AFE_TUNER_INVALID_CMD_PARAMS, "Tuner command too long, dropped");
+                context->internal_request_cmd_len = 0;
+            }
+            return CY_RSLT_AFE_TUNER_NEED_MORE_DATA;
         }
+
+        context->internal_request_cmd_len = (context->internal_request_cmd_len - frame_len);
+        memmove(data, data + frame_len, context->internal_request_cmd_len);
     }
 
-    return false;
+    return CY_RSLT_SUCCESS;
 }
 
 /**
- * Receive tuner command request from configurator tool
+ * Receive tuner command request from configurator tool. Binary frames and text commands
+ * ending with \r\n may arrive back to back, each one is processed as soon as it is complete.
  */
 cy_rslt_t afe_receive_tuner_command_req(afe_internal_context_t* context)
 {
     cy_afe_tuner_buffer_t request_buffer;
     cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint16_t copy_len = 0;
+    uint16_t received = 0;
 
     memset(&request_buffer, 0, sizeof(cy_afe_tuner_buffer_t));
 
     request_buffer.buffer = context->afe_request_buffer;
-    request_buffer.buffer_max_len = CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE;
+    request_buffer.buffer_max_len = context->afe_request_buffer_size;
 
 #ifdef ENABLE_AFE_MW_TUNER_CHECK_POINT
     AFE_MW_TUNER_CHECK_POINT()
@@ -331,6 +446,18 @@ cy_rslt_t afe_receive_tuner_command_req(afe_internal_context_t* context)
     AFE_MW_TUNER_CHECK_POINT()
 #endif
 
+    if(CY_RSLT_AFE_TUNER_DISCONNECTED == result)
+    {
+        /* The next client starts a new session: its data must not complete a command of the previous one */
+        cy_afe_log_dbg("Tuner client disconnected, partial command and open transaction dropped");
+        context->internal_request_cmd_len = 0;
+        if(true == context->tuner_transaction.open)
+        {
+            afe_tuner_transaction_end(context, false);
+        }
+        return CY_RSLT_AFE_TUNER_WAIT_FOR_POLL_TIMEOUT;
+    }
+
     if(CY_RSLT_SUCCESS != result)
     {
         cy_afe_log_err(result, "Tuner read request callback failed");
@@ -347,31 +474,23 @@ cy_rslt_t afe_receive_tuner_command_req(afe_internal_context_t* context)
     }
 
     /**
-     * Store incoming data from application to local command buffer for further processing
+     * Store incoming data from application to local command buffer for further processing.
+     * One byte is kept free to terminate a text command in place. When a partial command is
+     * already buffered, the data may not fit at once: the complete commands are processed
+     * to make room and the rest of the data is copied on the next pass.
      */
-    memcpy(context->internal_request_cmd_buffer + context->internal_request_cmd_len, request_buffer.buffer, MIN(request_buffer.length, CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE));
-    context->internal_request_cmd_len = (context->internal_request_cmd_len + request_buffer.length);
-
-    /**
-     * Check if command received ends with \r\n, if yes, then start processing command
-     */
-    if(true == check_for_newline_in_received_data(context->internal_request_cmd_buffer, context->internal_request_cmd_len))
+    while(received < request_buffer.length)
     {
-        result = afe_process_tuner_command_req(context, context->internal_request_cmd_buffer, (context->internal_request_cmd_len - NEWLINE_AT_END_OF_CMD));
-        if (CY_RSLT_SUCCESS != result)
-        {
-            cy_afe_log_err(result, "Failed to process tuner commands");
-            return result;
-        }
-
-        memset(context->internal_request_cmd_buffer, 0, CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE);
-        context->internal_request_cmd_len = 0;
-    }
-    else
-    {
-        return CY_RSLT_AFE_TUNER_NEED_MORE_DATA;
+        copy_len = MIN((uint16_t)(request_buffer.length - received),
+                (uint16_t)(context->internal_request_cmd_buffer_size - 1 - context->internal_request_cmd_len));
+        memcpy(context->internal_request_cmd_buffer + context->internal_request_cmd_len,
+                request_buffer.buffer + received, copy_len);
+        context->internal_request_cmd_len = (context->internal_request_cmd_len + copy_len);
+        received = (uint16_t)(received + copy_len);
+
+        result = afe_process_buffered_tuner_requests(context);
     }
 
-    return CY_RSLT_SUCCESS;
+    return result;
 }
 #endif
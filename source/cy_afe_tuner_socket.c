@@ -0,0 +1,344 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_tuner_socket.c
+ * @brief Reference tuner transport over a local Unix domain or TCP socket for POSIX host builds
+ *
+ */
+
+#if defined(CY_AFE_ENABLE_TUNING_FEATURE) && defined(CY_AFE_TUNER_SOCKET_TRANSPORT)
+#include "cy_afe_tuner_socket.h"
+#include "cy_afe_audio_internal.h"
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/******************************************************
+ *                     Macros
+ ******************************************************/
+#define AFE_TUNER_SOCKET_BACKLOG             (1)
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL                         (0)
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static void afe_tuner_socket_drop_client(cy_afe_tuner_socket_t *tuner_socket)
+{
+    if(tuner_socket->client_fd >= 0)
+    {
+        close(tuner_socket->client_fd);
+        tuner_socket->client_fd = -1;
+        tuner_socket->client_dropped = true;
+        cy_afe_log_dbg("Tuner client disconnected");
+    }
+}
+
+/*
+ * Wait for fd to become readable, returns false on timeout
+ */
+static bool afe_tuner_socket_wait(int fd, int timeout_ms)
+{
+    struct pollfd poll_fd;
+    int ret = 0;
+
+    poll_fd.fd = fd;
+    poll_fd.events = POLLIN;
+    poll_fd.revents = 0;
+
+    do
+    {
+        ret = poll(&poll_fd, 1, timeout_ms);
+    } while((ret < 0) && (EINTR == errno));
+
+    return (ret > 0);
+}
+
+static cy_rslt_t afe_tuner_socket_accept(cy_afe_tuner_socket_t *tuner_socket)
+{
+    int fd = -1;
+    int enable = 1;
+
+    if(false == afe_tuner_socket_wait(tuner_socket->listen_fd, tuner_socket->read_timeout_ms))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    fd = accept(tuner_socket->listen_fd, NULL, NULL);
+    if(fd < 0)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_SYSTEM_MODULE_ERROR, "accept failed, errno:[%d]", errno);
+        return CY_RSLT_AFE_SYSTEM_MODULE_ERROR;
+    }
+
+    if(CY_AFE_TUNER_SOCKET_TCP == tuner_socket->type)
+    {
+        /* Responses are single small writes, send them without coalescing */
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+
+    tuner_socket->client_fd = fd;
+    cy_afe_log_dbg("Tuner client connected");
+
+    return CY_RSLT_SUCCESS;
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+cy_rslt_t cy_afe_tuner_socket_open(cy_afe_tuner_socket_t *tuner_socket, const cy_afe_tuner_socket_config_t *config)
+{
+    struct sockaddr_un unix_addr;
+    struct sockaddr_in tcp_addr;
+    struct sockaddr *addr = NULL;
+    socklen_t addr_len = 0;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    int enable = 1;
+
+    if((NULL == tuner_socket) || (NULL == config))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. tuner_socket:[%p], config:[%p]", tuner_socket, config);
+        return result;
+    }
+
+    memset(tuner_socket, 0, sizeof(cy_afe_tuner_socket_t));
+    tuner_socket->listen_fd = -1;
+    tuner_socket->client_fd = -1;
+    tuner_socket->type = config->type;
+    tuner_socket->read_timeout_ms = config->read_timeout_ms;
+
+    if(CY_AFE_TUNER_SOCKET_UNIX == config->type)
+    {
+        if((NULL == config->path) || (0 == strlen(config->path)) || (strlen(config->path) >= sizeof(unix_addr.sun_path)))
+        {
+            result = CY_RSLT_AFE_BAD_ARG;
+            cy_afe_log_err(result, "Invalid Unix domain socket path");
+            return result;
+        }
+
+        memset(&unix_addr, 0, sizeof(unix_addr));
+        unix_addr.sun_family = AF_UNIX;
+        memcpy(unix_addr.sun_path, config->path, strlen(config->path));
+        memcpy(tuner_socket->path, config->path, strlen(config->path));
+        unlink(tuner_socket->path);
+
+        addr = (struct sockaddr*) &unix_addr;
+        addr_len = sizeof(unix_addr);
+        tuner_socket->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    }
+    else if(CY_AFE_TUNER_SOCKET_TCP == config->type)
+    {
+        memset(&tcp_addr, 0, sizeof(tcp_addr));
+        tcp_addr.sin_family = AF_INET;
+        tcp_addr.sin_port = htons(config->port);
+        tcp_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        addr = (struct sockaddr*) &tcp_addr;
+        addr_len = sizeof(tcp_addr);
+        tuner_socket->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if(tuner_socket->listen_fd >= 0)
+        {
+            setsockopt(tuner_socket->listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        }
+    }
+    else
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid socket type:[%d]", config->type);
+        return result;
+    }
+
+    if(tuner_socket->listen_fd < 0)
+    {
+        result = CY_RSLT_AFE_SYSTEM_MODULE_ERROR;
+        cy_afe_log_err(result, "socket failed, errno:[%d]", errno);
+        return result;
+    }
+
+    if((0 != bind(tuner_socket->listen_fd, addr, addr_len)) ||
+            (0 != listen(tuner_socket->listen_fd, AFE_TUNER_SOCKET_BACKLOG)))
+    {
+        result = CY_RSLT_AFE_SYSTEM_MODULE_ERROR;
+        cy_afe_log_err(result, "bind/listen failed, errno:[%d]", errno);
+        cy_afe_tuner_socket_close(tuner_socket);
+        return result;
+    }
+
+    return result;
+}
+
+cy_rslt_t cy_afe_tuner_socket_close(cy_afe_tuner_socket_t *tuner_socket)
+{
+    if(NULL == tuner_socket)
+    {
+        cy_afe_log_err(CY_RSLT_AFE_BAD_ARG, "Invalid argument passed. tuner_socket:[%p]", tuner_socket);
+        return CY_RSLT_AFE_BAD_ARG;
+    }
+
+    afe_tuner_socket_drop_client(tuner_socket);
+
+    if(tuner_socket->listen_fd >= 0)
+    {
+        close(tuner_socket->listen_fd);
+        tuner_socket->listen_fd = -1;
+    }
+
+    if('\0' != tuner_socket->path[0])
+    {
+        unlink(tuner_socket->path);
+        tuner_socket->path[0] = '\0';
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_tuner_socket_read(cy_afe_tuner_socket_t *tuner_socket, cy_afe_tuner_buffer_t *request_buffer)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    ssize_t received = 0;
+
+    if((NULL == tuner_socket) || (NULL == request_buffer) || (tuner_socket->listen_fd < 0))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. tuner_socket:[%p], request_buffer:[%p]", tuner_socket, request_buffer);
+        return result;
+    }
+
+    request_buffer->length = 0;
+
+    /* Let the tuner drop what it buffered from the previous client before serving the next one */
+    if(true == tuner_socket->client_dropped)
+    {
+        tuner_socket->client_dropped = false;
+        return CY_RSLT_AFE_TUNER_DISCONNECTED;
+    }
+
+    if(tuner_socket->client_fd < 0)
+    {
+        result = afe_tuner_socket_accept(tuner_socket);
+        if((CY_RSLT_SUCCESS != result) || (tuner_socket->client_fd < 0))
+        {
+            return result;
+        }
+    }
+
+    if(false == afe_tuner_socket_wait(tuner_socket->client_fd, tuner_socket->read_timeout_ms))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    received = recv(tuner_socket->client_fd, request_buffer->buffer, request_buffer->buffer_max_len, 0);
+    if(received > 0)
+    {
+        request_buffer->length = (uint16_t) received;
+    }
+    else if((0 == received) || ((EINTR != errno) && (EAGAIN != errno)))
+    {
+        /* Closed by the client or broken, wait for the next one */
+        afe_tuner_socket_drop_client(tuner_socket);
+        tuner_socket->client_dropped = false;
+        return CY_RSLT_AFE_TUNER_DISCONNECTED;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_afe_tuner_socket_write(cy_afe_tuner_socket_t *tuner_socket, cy_afe_tuner_buffer_t *response_buffer)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint16_t offset = 0;
+    ssize_t sent = 0;
+
+    if((NULL == tuner_socket) || (NULL == response_buffer))
+    {
+        result = CY_RSLT_AFE_BAD_ARG;
+        cy_afe_log_err(result, "Invalid argument passed. tuner_socket:[%p], response_buffer:[%p]", tuner_socket, response_buffer);
+        return result;
+    }
+
+    if(tuner_socket->client_fd < 0)
+    {
+        result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
+        cy_afe_log_err(result, "No tuner client connected, response dropped");
+        return result;
+    }
+
+    while(offset < response_buffer->length)
+    {
+        sent = send(tuner_socket->client_fd, response_buffer->buffer + offset, response_buffer->length - offset, MSG_NOSIGNAL);
+        if(sent < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            result = CY_RSLT_AFE_TUNER_GENERIC_ERROR;
+            cy_afe_log_err(result, "send failed, errno:[%d]", errno);
+            afe_tuner_socket_drop_client(tuner_socket);
+            return result;
+        }
+        offset = (uint16_t)(offset + sent);
+    }
+
+    return result;
+}
+#endif
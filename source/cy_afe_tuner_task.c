@@ -43,6 +43,7 @@
 #include "cy_afe_tuner_process.h"
 #include "cy_afe_audio_speech_enh.h"
 #include "cy_afe_tuner_task.h"
+#include "cy_afe_audio_memory.h"
 /******************************************************
  *                     Macros
  ******************************************************/
@@ -87,59 +88,49 @@ cy_rslt_t afe_cleanup_memory_for_dbg_output(afe_internal_context_t* context)
 {
     if(NULL != context->dbg_output1)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,context->dbg_output1);
-        }
-        else
-        {
-            free(context->dbg_output1);
-        }
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->dbg_output1);
         context->dbg_output1 = NULL;
     }
 
     if(NULL != context->dbg_output2)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,context->dbg_output2);
-        }
-        else
-        {
-            free(context->dbg_output2);
-        }
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->dbg_output2);
         context->dbg_output2 = NULL;
     }
 
     if(NULL != context->dbg_output3)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,context->dbg_output3);
-        }
-        else
-        {
-            free(context->dbg_output3);
-        }
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->dbg_output3);
         context->dbg_output3 = NULL;
     }
 
     if(NULL != context->dbg_output4)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,context->dbg_output4);
-        }
-        else
-        {
-            free(context->dbg_output4);
-        }
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->dbg_output4);
         context->dbg_output4 = NULL;
     }
 
     return CY_RSLT_SUCCESS;
 }
 
+void afe_require_audio_tuner_memory(afe_internal_context_t *context, cy_afe_config_t *config)
+{
+    uint32_t request_size = (0 != config->tuner_request_buffer_size) ?
+            config->tuner_request_buffer_size : CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE;
+    uint32_t command_size = (0 != config->tuner_command_buffer_size) ?
+            config->tuner_command_buffer_size : CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE;
+
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, command_size);
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, request_size);
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, (uint32_t)(MAX_NUM_PARAMS*sizeof(char*)));
+
+    /* Four debug output frames of afe_allocate_memory_for_dbg_output */
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size);
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size);
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size);
+    afe_memory_require(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size);
+}
+
 cy_rslt_t afe_allocate_memory_for_dbg_output(afe_internal_context_t* context)
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
@@ -150,72 +141,40 @@ cy_rslt_t afe_allocate_memory_for_dbg_output(afe_internal_context_t* context)
 
     if(NULL == context->dbg_output1)
     {
-        if(afe_alloc_memory)
-        {
-            afe_alloc_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,  (uint32_t)CY_AFE_MONO_FRAME_SIZE_IN_BYTES,
-                    (void **)&context->dbg_output1);
-        }
-        else
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size,
+                (void **)&context->dbg_output1);
+        if(CY_RSLT_SUCCESS != result)
         {
-            context->dbg_output1 = calloc(1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
-        }
-        if(NULL == context->dbg_output1)
-        {
-            result = CY_RSLT_AFE_OUT_OF_MEMORY;
             return result;
         }
     }
 
     if(NULL == context->dbg_output2)
     {
-        if(afe_alloc_memory)
-        {
-            afe_alloc_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,  (uint32_t)CY_AFE_MONO_FRAME_SIZE_IN_BYTES,
-                    (void **)&context->dbg_output2);
-        }
-        else
-        {
-            context->dbg_output2 = calloc(1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
-        }
-        if(NULL == context->dbg_output2)
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size,
+                (void **)&context->dbg_output2);
+        if(CY_RSLT_SUCCESS != result)
         {
-            result = CY_RSLT_AFE_OUT_OF_MEMORY;
             return result;
         }
     }
 
     if(NULL == context->dbg_output3)
     {
-        if(afe_alloc_memory)
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size,
+                (void **)&context->dbg_output3);
+        if(CY_RSLT_SUCCESS != result)
         {
-            afe_alloc_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,  (uint32_t)CY_AFE_MONO_FRAME_SIZE_IN_BYTES,
-                    (void **)&context->dbg_output3);
-        }
-        else
-        {
-            context->dbg_output3 = calloc(1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
-        }
-        if(NULL == context->dbg_output3)
-        {
-            result = CY_RSLT_AFE_OUT_OF_MEMORY;
             return result;
         }
     }
 
     if(NULL == context->dbg_output4)
     {
-        if(afe_alloc_memory)
-        {
-            afe_alloc_memory(CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER,  (uint32_t)CY_AFE_MONO_FRAME_SIZE_IN_BYTES,
-                    (void **)&context->dbg_output4);
-        }
-        else
-        {
-            context->dbg_output4 = calloc(1, CY_AFE_MONO_FRAME_SIZE_IN_BYTES);
-        }
-        if(NULL == context->dbg_output4)
+        result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_DBG_OUT_BUFFER, context->core_frame_size,
+                (void **)&context->dbg_output4);
+        if(CY_RSLT_SUCCESS != result)
         {
-            result = CY_RSLT_AFE_OUT_OF_MEMORY;
             return result;
         }
     }
@@ -230,64 +189,84 @@ cy_rslt_t afe_setup_audio_tuner_task(afe_internal_context_t *context, cy_afe_con
 {
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
+    context->afe_request_buffer_size = (0 != config->tuner_request_buffer_size) ?
+            (uint16_t)config->tuner_request_buffer_size : CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE;
+    context->internal_request_cmd_buffer_size = (0 != config->tuner_command_buffer_size) ?
+            (uint16_t)config->tuner_command_buffer_size : CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE;
+
     /*
      * Allocate memory to accumulate tuning request which comes from configurator tool
      *
      */
-    if(afe_alloc_memory)
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, (uint32_t)context->internal_request_cmd_buffer_size,
+            (void **)&context->internal_request_cmd_buffer);
+    if(CY_RSLT_SUCCESS != result)
     {
-        afe_alloc_memory(CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, (uint32_t)CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE,
-                (void **)&context->internal_request_cmd_buffer);
+        cy_afe_log_err(result, "Memory allocation failed for command buffer");
+        afe_cleanup_audio_tuner_task(context);
+        return result;
     }
-    else
+
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, (uint32_t)context->afe_request_buffer_size,
+            (void **)&context->afe_request_buffer);
+    if(CY_RSLT_SUCCESS != result)
     {
-        context->internal_request_cmd_buffer = malloc(CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE);
-        if(NULL == context->internal_request_cmd_buffer)
-        {
-            cy_afe_log_err(result, "Memory allocation failed for command buffer");
-            afe_cleanup_audio_tuner_task(context);
-            return result;
-        }
-        memset(context->internal_request_cmd_buffer, 0, CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE);
+        cy_afe_log_err(result, "Memory allocation failed for request buffer");
+        afe_cleanup_audio_tuner_task(context);
+        return result;
     }
 
-    context->poll_interval_ms = config->poll_interval_ms;
-    context->audio_tuner_thread_running = true;
-
-    /*
-     * Create AFE audio tuner task
-     */
-    result = cy_rtos_create_thread(&context->audio_tuner_thread, afe_tuner_task,
-            AFE_AUDIO_TUNER_TASK_NAME, NULL,
-            AFE_TUNER_TASK_THREAD_STACK_SIZE, AFE_TUNER_TASK_PRIORITY, context);
+    result = afe_memory_alloc(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, (uint32_t)(MAX_NUM_PARAMS*sizeof(char*)),
+            (void **)&context->tuner_cmd_params);
     if (CY_RSLT_SUCCESS != result)
     {
-        cy_afe_log_err(result, "cy_rtos_create_thread failed");
+        cy_afe_log_err(result, "Failed to allocate memory for tuner command params");
         afe_cleanup_audio_tuner_task(context);
         return result;
     }
 
-    if(afe_alloc_memory)
-    {
-        afe_alloc_memory(CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER,  (uint32_t)(MAX_NUM_PARAMS*sizeof(char*)),
-                (void **)&context->tuner_cmd_params);
-    }
-    else
+    result = cy_rtos_mutex_init(&context->audio_tuner_mutex, false);
+    if (CY_RSLT_SUCCESS != result)
     {
-        context->tuner_cmd_params = (char**) calloc(MAX_NUM_PARAMS, sizeof(char*));
+        cy_afe_log_err(result, "semaphore init failed");
+        afe_cleanup_audio_tuner_task(context);
+        return result;
     }
-    if ( NULL == context->tuner_cmd_params )
+
+    result = cy_rtos_init_semaphore(&context->params_applied_semaphore, 1, 0);
+    if (CY_RSLT_SUCCESS != result)
     {
-        result = CY_RSLT_AFE_OUT_OF_MEMORY;
-        cy_afe_log_err(result, "Failed to allocate memory for tuner command params");
+        cy_afe_log_err(result, "semaphore init failed");
         afe_cleanup_audio_tuner_task(context);
         return result;
     }
 
-    result = cy_rtos_mutex_init(&context->audio_tuner_mutex, false);
+    context->poll_interval_ms = config->poll_interval_ms;
+    context->tuner_transport = config->tuner_transport;
+    if (CY_AFE_TUNER_TRANSPORT_NOTIFY == context->tuner_transport)
+    {
+        /* Binary semaphore, signals received while the task is reading are merged */
+        result = cy_rtos_init_semaphore(&context->tuner_rx_semaphore, 1, 0);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            cy_afe_log_err(result, "semaphore init failed");
+            afe_cleanup_audio_tuner_task(context);
+            return result;
+        }
+        context->tuner_rx_semaphore_initialized = true;
+    }
+
+    /*
+     * Create AFE audio tuner task, once everything it uses is ready
+     */
+    context->audio_tuner_thread_running = true;
+    result = cy_rtos_create_thread(&context->audio_tuner_thread, afe_tuner_task,
+            AFE_AUDIO_TUNER_TASK_NAME, NULL,
+            AFE_TUNER_TASK_THREAD_STACK_SIZE, AFE_TUNER_TASK_PRIORITY, context);
     if (CY_RSLT_SUCCESS != result)
     {
-        cy_afe_log_err(result, "semaphore init failed");
+        cy_afe_log_err(result, "cy_rtos_create_thread failed");
+        context->audio_tuner_thread_running = false;
         afe_cleanup_audio_tuner_task(context);
         return result;
     }
@@ -313,10 +292,17 @@ static void afe_tuner_task(cy_thread_arg_t arg)
     {
         result = afe_receive_tuner_command_req(context);
 
-        /** Wait for poll timeout */
-        if(CY_RSLT_AFE_TUNER_WAIT_FOR_POLL_TIMEOUT == result)
+        /** Read again while data comes in, else wait for poll timeout or for the application to signal new data */
+        if((CY_RSLT_SUCCESS != result) && (CY_RSLT_AFE_TUNER_NEED_MORE_DATA != result))
         {
-            cy_rtos_delay_milliseconds(context->poll_interval_ms);
+            if(CY_AFE_TUNER_TRANSPORT_NOTIFY == context->tuner_transport)
+            {
+                cy_rtos_get_semaphore(&context->tuner_rx_semaphore, CY_RTOS_NEVER_TIMEOUT, false);
+            }
+            else
+            {
+                cy_rtos_delay_milliseconds(context->poll_interval_ms);
+            }
         }
     }
 
@@ -357,28 +343,31 @@ cy_rslt_t afe_cleanup_audio_tuner_task(afe_internal_context_t *context)
 
     if(NULL != context->internal_request_cmd_buffer)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER,context->internal_request_cmd_buffer);
-        }
-        else
-        {
-            free(context->internal_request_cmd_buffer);
-        }
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, context->internal_request_cmd_buffer);
         context->internal_request_cmd_buffer = NULL;
     }
 
+    if(NULL != context->afe_request_buffer)
+    {
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, context->afe_request_buffer);
+        context->afe_request_buffer = NULL;
+    }
+
     if(NULL != context->tuner_cmd_params)
     {
-        if(afe_free_memory)
-        {
-            afe_free_memory(CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER,context->tuner_cmd_params);
-        }
-        else
+        afe_memory_free(context, CY_AFE_MEM_ID_AFE_TUNER_CMD_BUFFER, context->tuner_cmd_params);
+        context->tuner_cmd_params = NULL;
+    }
+
+    if(true == context->tuner_rx_semaphore_initialized)
+    {
+        result = cy_rtos_deinit_semaphore(&context->tuner_rx_semaphore);
+        if (CY_RSLT_SUCCESS != result)
         {
-            free(context->tuner_cmd_params);
+            cy_afe_log_err(result, "semaphore deinit failed");
+            return result;
         }
-        context->tuner_cmd_params = NULL;
+        context->tuner_rx_semaphore_initialized = false;
     }
 
     result = cy_rtos_mutex_deinit(&context->audio_tuner_mutex);
@@ -388,6 +377,13 @@ cy_rslt_t afe_cleanup_audio_tuner_task(afe_internal_context_t *context)
         return result;
     }
 
+    result = cy_rtos_deinit_semaphore(&context->params_applied_semaphore);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        cy_afe_log_err(result, "semaphore deinit failed");
+        return result;
+    }
+
     return result;
 }
 #endif
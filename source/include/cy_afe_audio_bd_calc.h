@@ -83,6 +83,18 @@ extern "C"
 /******************************************************
  *                    Structures
  ******************************************************/
+/* Bulk delay measurement state of an AFE instance. Allocated by cy_afe_bd_calc_init
+ * and freed by cy_afe_bd_calc_deinit.
+ */
+struct afe_bdm_context_s
+{
+    bdm_struct_t bdm_struct;
+    unsigned int ref_frame_count;
+    unsigned int repeat_count;
+    unsigned int num_ref_frames;
+    cy_semaphore_t sync_semaphore;
+    int bulk_delay_output;
+};
 
 /******************************************************
  *                 Type Definitions
@@ -99,8 +111,8 @@ extern "C"
 cy_rslt_t cy_afe_bd_calc_process(afe_internal_context_t *context,
         afe_sp_enh_input_output_t *sp_enh_input_output);
 
-cy_rslt_t cy_afe_bd_calc_wait_for_complete(unsigned int ui_timout_ms,
-        int *bulk_delay);
+cy_rslt_t cy_afe_bd_calc_wait_for_complete(afe_internal_context_t *context,
+        unsigned int ui_timout_ms, int *bulk_delay);
 
 #endif
 
@@ -62,7 +62,10 @@ typedef enum
 {
     AFE_FRAME_FEED_COUNT,
     AFE_FRAME_PROCESSED_COUNT,
-    AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT
+    AFE_FRAME_PUSH_TO_QUEUE_FAIL_COUNT,
+    AFE_FRAME_DROP_OLDEST_COUNT,
+    AFE_FRAME_BLOCK_COUNT,
+    AFE_FRAME_BLOCK_TIMEOUT_COUNT
 } afe_stats_type_t;
 
 #ifdef CY_AFE_ENABLE_TIMESTAMP
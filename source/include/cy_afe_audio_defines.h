@@ -50,7 +50,8 @@ extern "C" {
  *                     Macros
  ******************************************************/
 /* Mapping of configurator file defines. This is done to avoid any code change
- * if defines in configurator generated file changes */
+ * if defines in configurator generated file changes. These are the defaults of
+ * sample_rate, frame_size_ms and num_channels of cy_afe_config_t. */
 #define CY_AFE_INPUT_NUM_OF_CHANNELS (AFE_INPUT_NUMBER_CHANNELS)
 #define CY_AFE_FRAME_SIZE_MS         (AFE_FRAME_SIZE_MS)
 #define CY_AFE_SAMPLE_FREQ           (AFE_FRAME_RATE_SPS)
@@ -90,9 +91,8 @@ extern "C" {
 #define CY_AFE_AUDIO_MONO_CHANNEL    (1)
 #define CY_AFE_AUDIO_STEREO_CHANNEL  (2)
 
-#define CY_AFE_MONO_FRAME_SIZE_IN_BYTES     (320)
-#define CY_AFE_STEREO_FRAME_SIZE_IN_BYTES   (640)
-#define CY_AFE_MONITOR_OUT_MAX_SIZE 		(4 * CY_AFE_MONO_FRAME_SIZE_IN_BYTES)
+#define CY_AFE_SAMPLE_SIZE_IN_BYTES  (CY_AFE_SAMPLE_WIDTH_SIZE / 8)
+#define CY_AFE_MONITOR_OUT_MAX_FRAMES 		(4)
 #define CY_AFE_AUDIO_METER_MAX 	        	(3)
 
 /******************************************************
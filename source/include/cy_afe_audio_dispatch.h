@@ -0,0 +1,161 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_dispatch.h
+ * @brief Set of routines to deliver the processed audio frames to application, either
+ *        inline or from a separate output dispatch task
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_AUDIO_DISPATCH_H__
+#define AUDIO_FRONT_END_AUDIO_DISPATCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_afe_audio_internal.h"
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Add the memory of the output buffer pool and output queue set up by \ref afe_setup_output_dispatch
+ * to the memory required by the instance, without allocating it
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_require_output_dispatch_memory(afe_internal_context_t *context);
+
+/**
+ * Setup output buffer pool, output queue and output dispatch task. Output queue is not created if
+ * output_queue_size is not configured in callback mode, output is then delivered inline by
+ * \ref afe_dispatch_output. In pull mode the output dispatch task is not created.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+cy_rslt_t afe_setup_output_dispatch(afe_internal_context_t *context);
+
+/**
+ * Cleanup output dispatch task, queue and output buffer pool. Outputs which are not yet delivered are dropped.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+cy_rslt_t afe_cleanup_output_dispatch(afe_internal_context_t *context);
+
+/**
+ * Get the internal output buffer for the next frame when application has not registered
+ * afe_get_buffer_callback. Waits till a consumer releases a buffer if all buffers are in use.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ * @return    Output buffer; NULL if output buffer pool is not used.
+ */
+uint32_t *afe_dispatch_get_pool_buffer(afe_internal_context_t *context);
+
+/**
+ * Deliver output of a frame to application registered afe_output_callback. Output is queued to the
+ * output dispatch task if it is running, else the callback is invoked in the caller context.
+ * Must be called from a single context at a time.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  output_info           Output buffer information
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_QUEUE_FULL if the output queue stayed full and the
+ *            output was dropped.
+ */
+cy_rslt_t afe_dispatch_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info);
+
+/**
+ * Read next output from the output queue. Must be called from a single context at a time.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[out] output_info           Output buffer information
+ * @param[in]  timeout_ms            Time to wait for an output
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TIMEOUT if no output was available in time.
+ */
+cy_rslt_t afe_dispatch_read_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info, uint32_t timeout_ms);
+
+/**
+ * Add a reference to the internal output buffer of an output, so that it stays valid till
+ * \ref afe_dispatch_release_output is called for the reference
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  output_info           Output buffer information
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if output buffer is not an internal buffer in use.
+ */
+cy_rslt_t afe_dispatch_hold_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info);
+
+/**
+ * Return the internal output buffer of a consumed output to the output pool
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  output_info           Output buffer information returned by \ref afe_dispatch_read_output
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if output buffer is already released.
+ */
+cy_rslt_t afe_dispatch_release_output(afe_internal_context_t *context, cy_afe_buffer_info_t *output_info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_AUDIO_DISPATCH_H__ */
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_dsp.h
+ * @brief Sample buffer helpers and FIR kernels used on the audio path. Helium (MVE), NEON
+ *        or SSE2 is used when the target supports it, else the portable implementation is used.
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_DSP_H__
+#define AUDIO_FRONT_END_DSP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Copy an audio buffer. Buffers must not overlap.
+ *
+ * @param[out] dst           Destination buffer
+ * @param[in]  src           Source buffer
+ * @param[in]  size          Number of bytes to copy
+ */
+void afe_dsp_copy(void *dst, const void *src, uint32_t size);
+
+/**
+ * Split interleaved stereo samples into two channel buffers
+ *
+ * @param[in]  input         Interleaved samples, channel-1 first
+ * @param[out] output1       Channel-1 samples
+ * @param[out] output2       Channel-2 samples
+ * @param[in]  samples       Number of samples of each channel
+ */
+void afe_dsp_deinterleave_s16(const int16_t *input, int16_t *output1, int16_t *output2, uint32_t samples);
+
+/**
+ * Downmix channels to mono: output n is the weighted sum of the samples of every channel,
+ * rounded from Q15 with saturation. Sum of the absolute weights must not exceed 65535.
+ * Interleaved stereo and non-interleaved channels are vectorized.
+ *
+ * @param[in]  input          Sample 0 of channel 0
+ * @param[in]  channels       Number of channels
+ * @param[in]  channel_stride Distance in samples between sample 0 of two channels, 1 for interleaved channels
+ * @param[in]  sample_stride  Distance in samples between two samples of a channel, channels for interleaved channels
+ * @param[in]  weights        Q15 weight of each channel
+ * @param[out] output         Mono samples
+ * @param[in]  samples        Number of samples per channel
+ */
+void afe_dsp_downmix_s16(const int16_t *input, uint32_t channels, uint32_t channel_stride, uint32_t sample_stride,
+        const int16_t *weights, int16_t *output, uint32_t samples);
+
+/**
+ * Convert 32 bit samples to 16 bit with rounding and saturation. Samples are first shifted
+ * left by shift so that full scale is the 32 bit range (8 for 24 bit samples in the low bits
+ * of 32 bit words, whose upper byte is ignored). If dither_state is not NULL, triangular
+ * dither of +/-1 output LSB is added before rounding and the generator state is updated.
+ *
+ * @param[in]     input         32 bit samples
+ * @param[in]     stride        Distance in samples between two input samples to convert, 2 to pick one
+ *                              channel of interleaved stereo. Only a stride of 1 is vectorized.
+ * @param[in]     shift         Left shift normalizing input to full scale, 0 .. 8
+ * @param[out]    output        16 bit samples
+ * @param[in]     samples       Number of samples to convert
+ * @param[in,out] dither_state  Non zero dither generator state, NULL to convert without dither
+ */
+void afe_dsp_s32_to_s16(const int32_t *input, uint32_t stride, uint32_t shift, int16_t *output, uint32_t samples,
+        uint32_t *dither_state);
+
+/**
+ * Convert float samples, full scale +/-1.0, to 16 bit with rounding and saturation. If dither_state
+ * is not NULL, triangular dither of +/-1 output LSB is added before rounding.
+ *
+ * @param[in]     input         Float samples
+ * @param[in]     stride        Distance in samples between two input samples to convert. Only a stride of 1 is vectorized.
+ * @param[out]    output        16 bit samples
+ * @param[in]     samples       Number of samples to convert
+ * @param[in,out] dither_state  Non zero dither generator state, NULL to convert without dither
+ */
+void afe_dsp_f32_to_s16(const float *input, uint32_t stride, int16_t *output, uint32_t samples,
+        uint32_t *dither_state);
+
+/**
+ * Convert 16 bit samples to 32 bit words, the sample being shifted left by shift
+ * (16 for full scale 32 bit samples, 8 for 24 bit samples in the low bits)
+ *
+ * @param[in]  input         16 bit samples
+ * @param[in]  shift         Left shift, 8 .. 16
+ * @param[out] output        32 bit samples
+ * @param[in]  samples       Number of samples to convert
+ */
+void afe_dsp_s16_to_s32(const int16_t *input, uint32_t shift, int32_t *output, uint32_t samples);
+
+/**
+ * Convert 16 bit samples to float samples, full scale +/-1.0
+ *
+ * @param[in]  input         16 bit samples
+ * @param[out] output        Float samples
+ * @param[in]  samples       Number of samples to convert
+ */
+void afe_dsp_s16_to_f32(const int16_t *input, float *output, uint32_t samples);
+
+/**
+ * FIR filter and decimate Q15 samples. Output n is the dot product of coefficients with
+ * input[n * factor] .. input[n * factor + taps - 1], so input holds taps - 1 history samples
+ * followed by the new samples. Coefficients are stored in reversed order.
+ *
+ * @param[in]  input          History followed by (output_samples * factor) new samples
+ * @param[in]  coefficients   Filter coefficients, Q15
+ * @param[in]  taps           Number of filter coefficients
+ * @param[in]  factor         Decimation factor
+ * @param[out] output         Decimated samples
+ * @param[in]  output_samples Number of samples to write to output
+ */
+void afe_dsp_fir_decimate_q15(const int16_t *input, const int16_t *coefficients, uint32_t taps,
+        uint32_t factor, int16_t *output, uint32_t output_samples);
+
+/**
+ * Interpolate Q15 samples with a polyphase FIR filter. For each input sample n, factor
+ * outputs are written, output phase p being the dot product of branch p of coefficients
+ * with input[n] .. input[n + taps_per_phase - 1]. Input holds taps_per_phase - 1 history
+ * samples followed by the new samples.
+ *
+ * @param[in]  input          History followed by input_samples new samples
+ * @param[in]  coefficients   factor branches of taps_per_phase reversed coefficients, Q15
+ * @param[in]  taps_per_phase Number of coefficients of one branch
+ * @param[in]  factor         Interpolation factor
+ * @param[out] output         (input_samples * factor) interpolated samples
+ * @param[in]  input_samples  Number of new input samples
+ */
+void afe_dsp_fir_interpolate_q15(const int16_t *input, const int16_t *coefficients, uint32_t taps_per_phase,
+        uint32_t factor, int16_t *output, uint32_t input_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_DSP_H__ */
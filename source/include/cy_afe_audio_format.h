@@ -0,0 +1,165 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+
+/**
+ * @file cy_afe_audio_format.h
+ * @brief Conversion of application input, AEC reference and output buffers from and to the
+ *        16 bit non-interleaved frames processed by AFE middleware
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_AUDIO_FORMAT_H__
+#define AUDIO_FRONT_END_AUDIO_FORMAT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_afe_audio_internal.h"
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Get the size of one sample of a format
+ *
+ * @param[in]  sample_format   Sample format
+ *
+ * @return    Number of bytes of one sample, 0 if the format is not supported.
+ */
+uint32_t afe_format_sample_size(cy_afe_sample_format_t sample_format);
+
+/**
+ * Get the scratch memory needed by the format conversion in the scratch arena of the instance. The AEC reference
+ * downmix borrows the arena when frames are converted and processed in the same context (CY_AFE_PROCESSING_MODE_SYNC)
+ * and the arena is not lent to the application.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ * @return    Number of bytes, 0 if the format conversion has its own scratch memory or needs none.
+ */
+uint32_t afe_format_get_scratch_size(afe_internal_context_t *context);
+
+/**
+ * Add the frames allocated by \ref afe_setup_format_conversion to the memory required by the instance
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_require_format_conversion_memory(afe_internal_context_t *context);
+
+/**
+ * Allocate the frames used to convert frames processed in place, the AEC reference and the output, and seed the dither generator
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ * @return    CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t afe_setup_format_conversion(afe_internal_context_t *context);
+
+/**
+ * Free the conversion frames
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_cleanup_format_conversion(afe_internal_context_t *context);
+
+/**
+ * Convert input samples of every channel from the application layout and sample format into a frame.
+ * The dither generator is not locked, so input of an instance must be converted from a single context at a time.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input                 Application input buffer
+ * @param[in]  buffer_samples        Number of samples per channel in input, locating channel-2 of non-interleaved input
+ * @param[in]  offset                Sample index in input of the first sample to convert
+ * @param[out] frame                 Frame of context->frame_samples samples per channel
+ * @param[in]  frame_offset          Sample index in frame to convert to
+ * @param[in]  count                 Number of samples per channel to convert
+ */
+void afe_format_input(afe_internal_context_t *context, const void *input, uint32_t buffer_samples, uint32_t offset,
+        CY_AFE_DATA_T *frame, uint32_t frame_offset, uint32_t count);
+
+/**
+ * Convert AEC reference samples from the application layout and sample format, downmixing
+ * a reference of more than one channel to mono
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  aec_ref               Application AEC reference buffer
+ * @param[in]  buffer_samples        Number of samples per channel in aec_ref, locating the channels of non-interleaved reference
+ * @param[in]  offset                Sample index in aec_ref of the first sample to convert
+ * @param[out] output                16 bit mono samples
+ * @param[in]  count                 Number of samples per channel to convert, at most context->frame_samples
+ */
+void afe_format_aec_ref(afe_internal_context_t *context, const void *aec_ref, uint32_t buffer_samples, uint32_t offset,
+        CY_AFE_DATA_T *output, uint32_t count);
+
+/**
+ * Convert 16 bit output samples to the application output sample format
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input                 16 bit output samples
+ * @param[out] output                Application output buffer
+ * @param[in]  count                 Number of samples to convert
+ */
+void afe_format_output(afe_internal_context_t *context, const CY_AFE_DATA_T *input, void *output, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_AUDIO_FORMAT_H__ */
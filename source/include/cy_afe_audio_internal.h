@@ -45,6 +45,9 @@
 #include "cy_afe_audio_log_msg.h"
 #include "cy_afe_audio_defines.h"
 #include "cy_afe_audio_debug.h"
+#include "cy_afe_audio_ring.h"
+#include "cy_afe_audio_pool.h"
+#include "cy_afe_audio_resample.h"
 #include "cyabs_rtos_internal.h"
 #include "stdlib.h"
 #include "stdio.h"
@@ -58,15 +61,36 @@ extern "C" {
 /******************************************************
  *                     Macros
  ******************************************************/
+/* Default size of the tuner request buffer, overridden by tuner_request_buffer_size of the configuration */
+#ifndef CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE
 #define CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE  100
-#define CY_AFE_TUNER_MAX_RESPONSE_BUFFER_SIZE 100
+#endif
+#define CY_AFE_TUNER_MAX_RESPONSE_BUFFER_SIZE 320
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+/* Speech enhancement components whose parameters are staged by the tuner */
+#define AFE_TUNER_PARAMS_COMPONENTS  (10)
+/* Maximum number of parameters read from one component */
+#define AFE_TUNER_PARAMS_MAX_VALUES  (5)
+/* Maximum number of settings notified to the application when a tuner transaction is committed */
+#ifndef AFE_TUNER_TRANSACTION_MAX_NOTIFY
+#define AFE_TUNER_TRANSACTION_MAX_NOTIFY (16)
+#endif
+#endif
+
+/* Number of memory blocks of the speech enhancement library tracked per instance */
+#ifndef AFE_SP_MAX_MEMORY_BLOCKS
+#define AFE_SP_MAX_MEMORY_BLOCKS (16)
+#endif
+
+/* Number of live allocations tracked per instance, AFE buffers and the memory of the speech enhancement library */
+#ifndef AFE_MEMORY_MAX_BLOCKS
+#define AFE_MEMORY_MAX_BLOCKS (24 + AFE_SP_MAX_MEMORY_BLOCKS)
+#endif
 /******************************************************
  *                    Constants
  ******************************************************/
 
-extern cy_afe_alloc_memory_callback_t afe_alloc_memory;
-extern cy_afe_free_memory_callback_t  afe_free_memory;
-
 /******************************************************
  *                   Enumerations
  ******************************************************/
@@ -74,25 +98,170 @@ extern cy_afe_free_memory_callback_t  afe_free_memory;
 /******************************************************
  *                    Structures
  ******************************************************/
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+/* Bulk delay measurement state, defined in cy_afe_audio_bd_calc.h */
+typedef struct afe_bdm_context_s afe_bdm_context_t;
+
+/* Parameters of a speech enhancement component as last read from the library */
+typedef struct
+{
+    int32_t id;                                   // ifx_sp_enh_ip_component_config_t of the component
+    cy_rslt_t status_result;                      // result of reading the enabled state
+    bool enabled;                                 // component is enabled
+    cy_rslt_t params_result;                      // result of reading the parameters
+    int32_t values[AFE_TUNER_PARAMS_MAX_VALUES];  // parameters, the first one is the value set by the tuner
+    int32_t value_count;                          // number of valid entries of values
+} afe_tuner_component_params_t;
+
+/* State read by the tuner without locking. Written by the processing context only, under params_snapshot_seq. */
+typedef struct
+{
+    afe_tuner_component_params_t component[AFE_TUNER_PARAMS_COMPONENTS]; // indexed as the staged components
+    afe_usb_settings_t usb_settings;                                      // debug output channel selection
+    int16_t audio_meter[CY_AFE_AUDIO_METER_MAX];                          // sound meter of the last processed frame
+    cy_afe_tuner_stats_t stats;                                           // update counters
+} afe_tuner_params_snapshot_t;
+
+/* Tuner updates applied by the processing context at the next frame boundary */
+typedef struct
+{
+    uint32_t sequence;                            // sequence of the latest command merged in
+    cy_time_t staged_time;                        // time the first command was staged
+    uint32_t enable_mask;                         // components to enable or disable, one bit per component index
+    uint32_t enable_value;                        // state to set for the components of enable_mask
+    uint32_t value_mask;                          // components whose configuration value is set
+    int32_t value[AFE_TUNER_PARAMS_COMPONENTS];   // configuration value of the components of value_mask
+    bool usb_settings_valid;                      // debug output channel selection is set
+    afe_usb_settings_t usb_settings;
+    bool atomic;                                  // staged by a transaction, nothing is kept if one setting fails
+} afe_tuner_params_update_t;
+
+/* Tuner transaction, set commands received between begin and commit are applied together */
+typedef struct
+{
+    bool open;                                    // begin received, set commands are staged until commit
+    bool fold_response;                           // response of the running command is folded into the commit response
+    cy_rslt_t result;                             // result of the first failed command, CY_RSLT_SUCCESS if none failed
+    uint32_t count;                               // set commands received
+    uint32_t failed_index;                        // 1 based index of the first failed command
+    uint32_t notify_count;                        // settings notified to the application on commit
+    struct
+    {
+        cy_afe_config_name_t config_name;
+        int value;
+    } notify[AFE_TUNER_TRANSACTION_MAX_NOTIFY];
+} afe_tuner_transaction_t;
+#endif
+
+/* Bump allocator over an application provided region */
+typedef struct
+{
+    uint8_t *base;      // start of the region
+    uint32_t size;      // size of the region in bytes
+    uint32_t used;      // bytes allocated from the start of the region
+    uint32_t last;      // offset of the latest allocation, which can be released
+    uint32_t blocks;    // allocations not yet freed, the whole region is released when it drops to 0
+} afe_memory_arena_t;
+
+/* Memory allocated through afe_memory_alloc and not yet freed */
+typedef struct
+{
+    void *buffer;               // allocated memory, NULL if the entry is free
+    uint32_t size;              // size in bytes, subtracted from the memory usage when the memory is freed
+} afe_memory_block_t;
+
+/* Memory held by the speech enhancement library */
+typedef struct
+{
+    void *buffer;               // allocated memory, NULL if the entry is free
+    uint32_t size;              // size in bytes
+    cy_afe_mem_id_t mem_id;     // AFE memory ID of the library memory ID
+} afe_sp_memory_block_t;
+
+/* Memory of an instance created with cy_afe_create_static */
+typedef struct
+{
+    bool enabled;                                  // instance memory is carved from the arenas
+    afe_memory_arena_t arena;                      // memory IDs without a region of their own
+    afe_memory_arena_t regions[CY_AFE_MEM_ID_MAX]; // region of each memory ID, size 0 if not provided
+    afe_memory_arena_t library;                    // library memory without a region of its own, reserved from the arena at creation
+    uint32_t library_mark;                         // arena offset where library memory starts while the reservation is measured
+    uint32_t library_mark_blocks;                  // arena allocations made before library memory
+} afe_memory_static_t;
+
 typedef struct {
     cy_thread_t audio_processing_thread;                      // audio processing thread
-    cy_queue_t audio_processing_queue;                        // audio processing queue
+    afe_ring_t audio_processing_queue;                        // audio processing queue
+    void *audio_processing_queue_buffer;                      // storage of audio processing queue
+    atomic_uint_fast32_t frames_pending;                      // frames queued or being processed in audio processing task, or 1 while
+                                                              // CY_AFE_PROCESSING_MODE_ADAPTIVE processes a frame in the caller
+    cy_mutex_t process_mutex;                                 // Held while a frame is processed, by any context
+    bool process_mutex_initialized;
+    afe_ring_t discard_queue;                                 // frames dropped by overload policy, to be notified from audio processing task
+    void *discard_queue_buffer;                               // storage of discard queue
+    afe_pool_t input_pool;                                    // internal copies of input and AEC reference, used in CY_AFE_INPUT_MODE_COPY
+    void *input_pool_buffer;                                  // storage of input pool
+    atomic_flag producer_busy;                                // set while a feed queues frames or takes input pool frames
+    atomic_flag reframe_busy;                                 // set while cy_afe_feed_samples gathers samples
+    atomic_uint_fast32_t input_ring_pending;                  // samples notified in input ring and not yet processed
+    uint32_t input_ring_read_index;                           // sample index of the next frame in input ring
+    cy_semaphore_t input_ring_semaphore;                      // signaled when a complete frame is available in input ring
+    uint8_t *input_ring_wrap_buffer;                          // frame crossing the end of input ring, followed by its AEC reference
+    uint8_t *reframe_input_frame;                             // frame being gathered by cy_afe_feed_samples
+    uint32_t reframe_input_samples;                           // samples per channel gathered in reframe_input_frame
+    bool reframe_input_has_ref;                               // AEC reference is gathered for reframe_input_frame
+    uint8_t *reframe_sync_frame;                              // frame gathered by cy_afe_feed_samples in sync mode
+    cy_afe_buffer_info_t reframe_output;                      // output being read by cy_afe_read_output_samples
+    uint32_t reframe_output_samples;                          // samples of reframe_output already read
     volatile bool audio_processing_thread_running;            // flag to check if thread is running or not
 
+    cy_thread_t output_dispatch_thread;                       // output dispatch thread
+    afe_ring_t output_dispatch_queue;                         // processed frames to be delivered to application
+    void *output_dispatch_queue_buffer;                       // storage of output dispatch queue
+    volatile bool output_dispatch_thread_running;             // flag to check if thread is running or not
+    afe_pool_t output_pool;                                   // internal output buffers, used if afe_get_buffer_callback is not registered
+    void *output_pool_buffer;                                 // storage of output pool
+
     cy_afe_config_t config_init;
     cy_afe_get_output_buffer_callback_t get_output_buffer_cb; // callback to get the output buffer
 
-    uint16_t input_frame_size;                                // input frame size
-    uint16_t output_frame_size;                               // output frame size
-    uint32_t *internal_output_buffer;                          // static internal output buffer
+    uint32_t sample_rate;                                     // input sample rate in Hz
+    uint32_t frame_size_ms;                                   // frame duration in ms
+    uint32_t num_channels;                                    // number of input channels
+    uint32_t frame_samples;                                   // samples of one channel in a frame
+    uint32_t mono_frame_size;                                 // bytes of one 16 bit channel in a frame
+    uint32_t input_frame_size;                                // bytes of all 16 bit input channels in a frame
+    bool input_interleaved;                                   // stereo input is fed interleaved
+    bool input_convert;                                       // input layout or sample format differs from the 16 bit frames processed
+    uint32_t input_sample_size;                               // bytes of one application input and AEC reference sample
+    uint32_t aec_ref_channels;                                // number of AEC reference channels, downmixed to mono if more than one
+    bool aec_ref_interleaved;                                 // AEC reference channels are fed interleaved
+    bool aec_ref_convert;                                     // AEC reference sample format or channel count differs from the 16 bit mono processed
+    int16_t aec_ref_weights[CY_AFE_AEC_REF_MAX_CHANNELS];     // Q15 downmix weight of each AEC reference channel
+    CY_AFE_DATA_T *aec_ref_scratch;                           // channels of AEC reference wider than 16 bit are converted here before the downmix, NULL if scratch_arena is used
+    uint32_t app_input_frame_size;                            // bytes of all channels of an application input frame
+    uint32_t app_aec_ref_frame_size;                          // bytes of all channels of an application AEC reference frame
+    uint32_t output_sample_size;                              // bytes of one application output sample
+    uint32_t app_output_frame_size;                           // bytes of an application output frame
+    uint32_t dither_state;                                    // dither generator of input conversion
+    CY_AFE_DATA_T *input_convert_frame;                       // frames used in place are converted here before processing, followed by the AEC reference
+    CY_AFE_DATA_T *output_convert_frame;                      // 16 bit output frame, converted to the application output buffer
+    uint32_t core_sample_rate;                                // sample rate of speech enhancement
+    uint32_t core_frame_samples;                              // samples of one channel in a frame at core_sample_rate
+    uint32_t core_frame_size;                                 // bytes of one channel in a frame at core_sample_rate, also the debug output size
+    afe_resampler_t resampler;                                // resampler between sample_rate and core_sample_rate
+    void *resample_buffer;                                    // resampler storage followed by core rate frames, NULL if not resampled
+    CY_AFE_DATA_T *resample_frames;                           // core rate frames of both channels, AEC reference and output
     uint16_t *ifx_internal_output;							  // Monitor outputs
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
 
-    uint8_t afe_request_buffer[CY_AFE_TUNER_MAX_REQUEST_BUFFER_SIZE];     // Maximum buffer size to hold tuner request
+    uint8_t *afe_request_buffer;              // Buffer passed to read_request_callback
+    uint16_t afe_request_buffer_size;         // Size of afe_request_buffer
     uint8_t afe_response_buffer[CY_AFE_TUNER_MAX_RESPONSE_BUFFER_SIZE];   // Maximum buffer size to hold tuner response
 
     uint8_t *internal_request_cmd_buffer;     // Internal request command buffer to store request
+    uint16_t internal_request_cmd_buffer_size;// Size of internal_request_cmd_buffer
     uint16_t internal_request_cmd_len;        // Internal request command length
 
     cy_afe_tuner_callbacks_t tuner_callbacks; // Tuner callbacks
@@ -101,6 +270,9 @@ typedef struct {
     volatile bool audio_tuner_thread_running; // flag to check if thread is running or not
 
     uint16_t poll_interval_ms;
+    cy_afe_tuner_transport_t tuner_transport; // Tuner task polls or waits for cy_afe_tuner_notify_rx
+    cy_semaphore_t tuner_rx_semaphore;        // Given by cy_afe_tuner_notify_rx, CY_AFE_TUNER_TRANSPORT_NOTIFY only
+    bool tuner_rx_semaphore_initialized;
 
     char** tuner_cmd_params;
     CY_AFE_DATA_T* dbg_output1;
@@ -109,13 +281,42 @@ typedef struct {
     CY_AFE_DATA_T* dbg_output4;
 
     bdm_init_out_params_t bdm_out;
+    afe_bdm_context_t *bdm_context;           // Bulk delay measurement state, valid while BDM is created
 
-    cy_mutex_t audio_tuner_mutex;
+    afe_usb_settings_t usb_settings;          // Debug output channel selection of this instance
+    int32_t ifx_out_locator[AFE_USB_SELECT_SIG_C+1]; // Index of each debug signal in ifx_internal_output
+
+    cy_mutex_t audio_tuner_mutex;             // Serializes the tuner commands staging parameter updates
+
+    afe_tuner_params_update_t params_update[2];         // Staged updates, one is filled while the other may be applied
+    atomic_uint_fast32_t params_pending;                // 1 + index of the update published to the processing context, 0 if none
+    uint32_t params_write_index;                        // Update filled next when none is pending
+    uint32_t params_sequence;                           // Sequence of the latest staged command
+    atomic_uint_fast32_t params_applied_sequence;       // Sequence of the latest update applied
+    cy_rslt_t params_apply_result;                      // Result of the latest update applied
+    cy_semaphore_t params_applied_semaphore;            // Signaled by the processing context when an update is applied
+    atomic_uint_fast32_t params_snapshot_seq;           // Odd while params_snapshot is written
+    afe_tuner_params_snapshot_t params_snapshot;
+    bool params_transaction_open;                       // Updates are merged into params_transaction until committed
+    afe_tuner_params_update_t params_transaction;       // Updates of the open transaction, tuner context only
+    afe_tuner_transaction_t tuner_transaction;          // Tuner command state of the open transaction
 #endif
 
+    int16_t audio_meter[CY_AFE_AUDIO_METER_MAX]; // Sound meter values of last processed frame
+
     int afe_feed_counter;    // AFE feed counter
     int afe_frame_processed; // AFE frame processed counter
-    int afe_frame_queue_push_fail_cnt; // AFE frame queue push failed counter
+    cy_afe_overload_stats_t overload_stats; // Input queue overload counters, updated by the feeding context
+    uint32_t overload_drops_reported;       // Dropped frame count already reported by audio processing task
+    uint32_t memory_usage[CY_AFE_MEM_ID_MAX]; // Bytes currently allocated through afe_memory_alloc, per memory ID
+    afe_memory_block_t memory_blocks[AFE_MEMORY_MAX_BLOCKS]; // Allocations counted in memory_usage
+    uint32_t memory_required[CY_AFE_MEM_ID_MAX]; // memory_usage with each allocation rounded to CY_AFE_MEMORY_ALIGNMENT
+    afe_memory_static_t static_memory;        // Application provided memory of cy_afe_create_static
+    afe_sp_memory_block_t sp_memory_blocks[AFE_SP_MAX_MEMORY_BLOCKS]; // Memory currently held by the speech enhancement library
+    cy_afe_memory_region_t scratch_arena;     // Scratch memory of the library, also used by AFE between library calls
+    uint32_t scratch_arena_min_size;          // Size of the scratch memory needed by AFE, scratch_arena is at least this large
+    cy_mutex_t scratch_mutex;                 // Held while scratch_arena is in use, created with share_scratch_memory
+    bool scratch_mutex_initialized;
 
     void *sp_enh_context; // Speech enhancement context
 
@@ -125,6 +326,7 @@ typedef struct {
 
 typedef struct {
     uint16_t timestamp;
+    bool app_format;            // input is still in application layout and sample format
     uint32_t crc_value;
     CY_AFE_DATA_T *input_data_ptr;
     CY_AFE_DATA_T *aec_ref_ptr;
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_audio_memory.h
+ * @brief Per-instance memory allocation helpers for the audio front end middleware
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_MEMORY_H__
+#define AUDIO_FRONT_END_MEMORY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_afe_audio_internal.h"
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/* Size of an allocation rounded up to CY_AFE_MEMORY_ALIGNMENT */
+#define AFE_MEMORY_ALIGN(size)  (((size) + (CY_AFE_MEMORY_ALIGNMENT - 1u)) & ~(uint32_t)(CY_AFE_MEMORY_ALIGNMENT - 1u))
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Initialize the arenas of an instance created with \ref cy_afe_create_static
+ *
+ * @param[out] static_memory  Arenas of the instance
+ * @param[in]  memory         Application provided memory
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if a region is not aligned to CY_AFE_MEMORY_ALIGNMENT.
+ */
+cy_rslt_t afe_memory_static_init(afe_memory_static_t *static_memory, const cy_afe_static_memory_t *memory);
+
+/**
+ * Carve zero initialized memory from the region of mem_id, else from the arena. The size is
+ * rounded up to CY_AFE_MEMORY_ALIGNMENT.
+ *
+ * @param[in]  static_memory  Arenas of the instance
+ * @param[in]  mem_id         Memory ID
+ * @param[in]  size           Size of the memory in bytes
+ *
+ * @return    Pointer to the memory; NULL if the region is too small.
+ */
+void *afe_memory_static_alloc(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id, uint32_t size);
+
+/**
+ * Return memory to its arena. The latest allocation of the arena is returned at once, other
+ * memory once every allocation of the arena has been freed, so a region dedicated to memory
+ * IDs which are freed together is reused entirely.
+ *
+ * @param[in]  static_memory  Arenas of the instance
+ * @param[in]  mem_id         Memory ID which was used for the allocation
+ * @param[in]  buffer         Pointer to the memory
+ */
+void afe_memory_static_free(afe_memory_static_t *static_memory, cy_afe_mem_id_t mem_id, void *buffer);
+
+/**
+ * Allocate zero initialized memory for an AFE instance. Memory is carved from the application
+ * provided memory of a static instance, else requested through the application registered
+ * alloc_memory callback of the instance, else from the heap. The size is added to the memory
+ * usage of mem_id reported by \ref cy_afe_get_memory_usage until the memory is freed.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  mem_id       Memory ID passed to the application callback
+ * @param[in]  size         Size of the memory in bytes
+ * @param[out] buffer       Pointer to the allocated memory
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_OUT_OF_MEMORY on failure.
+ */
+cy_rslt_t afe_memory_alloc(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size, void **buffer);
+
+/**
+ * Allocate memory requested by the speech enhancement library, as \ref afe_memory_alloc. On a static
+ * instance the memory is carved from the region of a library memory ID, else from the library
+ * reservation made by \ref afe_memory_library_end, so it is never mixed with AFE memory.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  mem_id       Memory ID passed to the application callback
+ * @param[in]  size         Size of the memory in bytes
+ * @param[out] buffer       Pointer to the allocated memory
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_OUT_OF_MEMORY on failure.
+ */
+cy_rslt_t afe_memory_alloc_library(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size, void **buffer);
+
+/**
+ * Start measuring the library memory carved from the arena of a static instance. No-op for
+ * other instances.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ */
+void afe_memory_library_begin(afe_internal_context_t *context);
+
+/**
+ * Reserve the library memory carved from the arena since \ref afe_memory_library_begin as a
+ * region of its own, which later library allocations of the instance reuse. No-op for other
+ * instances.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ */
+void afe_memory_library_end(afe_internal_context_t *context);
+
+/**
+ * Empty the library reservation and the regions of library memory IDs of a static instance,
+ * once the library has released its memory. No-op for other instances.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ */
+void afe_memory_library_reset(afe_internal_context_t *context);
+
+/**
+ * Add an allocation of size bytes for mem_id to the memory required by the instance, without
+ * allocating it. Used to size an instance from its configuration.
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  mem_id       Memory ID of the allocation
+ * @param[in]  size         Size of the memory in bytes
+ */
+void afe_memory_require(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, uint32_t size);
+
+/**
+ * Free memory which was allocated with \ref afe_memory_alloc and subtract its size from the
+ * memory usage of mem_id
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  mem_id       Memory ID which was used for the allocation
+ * @param[in]  buffer       Pointer to the memory. NULL is ignored.
+ */
+void afe_memory_free(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer);
+
+/**
+ * Free memory which was allocated with \ref afe_memory_alloc_library
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  mem_id       Memory ID which was used for the allocation
+ * @param[in]  buffer       Pointer to the memory. NULL is ignored.
+ */
+void afe_memory_free_library(afe_internal_context_t *context, cy_afe_mem_id_t mem_id, void *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_MEMORY_H__ */
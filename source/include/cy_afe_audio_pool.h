@@ -0,0 +1,178 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_pool.h
+ * @brief Pool of fixed size output frames with reference counts. Frames are acquired by
+ *        the single processing context and released from any context once consumed.
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_POOL_H__
+#define AUDIO_FRONT_END_POOL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct
+{
+    atomic_uint_fast32_t *ref_count;        // Number of owners of each frame, 0 if frame is free
+    uint8_t *frames;                        // Frame storage of count * frame_size bytes
+    uint32_t frame_size;                    // Size of one frame in bytes
+    uint32_t count;                         // Number of frames
+    uint32_t next_index;                    // Frame to be checked first by next acquire
+    atomic_bool acquirer_waiting;           // Set while acquirer is (about to be) blocked on free_semaphore
+    cy_semaphore_t free_semaphore;          // Signaled on release only when acquirer is waiting
+    bool initialized;
+} afe_pool_t;
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Get the size of the storage to be passed to \ref afe_pool_init
+ *
+ * @param[in]  frame_size    Size of one frame in bytes
+ * @param[in]  count         Number of frames
+ *
+ * @return    Size in bytes
+ */
+uint32_t afe_pool_buffer_size(uint32_t frame_size, uint32_t count);
+
+/**
+ * Initialize the pool with all frames free
+ *
+ * @param[in]  pool          Pool to be initialized
+ * @param[in]  buffer        Storage of \ref afe_pool_buffer_size bytes, owned by the caller
+ * @param[in]  frame_size    Size of one frame in bytes, multiple of 16 to keep every frame 16 byte aligned
+ * @param[in]  count         Number of frames
+ *
+ * @return    CY_RSLT_SUCCESS on success; error codes on failure.
+ */
+cy_rslt_t afe_pool_init(afe_pool_t *pool, void *buffer, uint32_t frame_size, uint32_t count);
+
+/**
+ * De-initialize the pool. The storage is not freed.
+ *
+ * @param[in]  pool          Pool to be de-initialized
+ */
+void afe_pool_deinit(afe_pool_t *pool);
+
+/**
+ * Acquire a free frame with one reference. Must be called from a single context at a time.
+ *
+ * @param[in]  pool          Pool
+ * @param[in]  timeout_ms    Time to wait for a release if all frames are in use. 0 returns immediately.
+ * @param[out] frame         Acquired frame
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RTOS_TIMEOUT if no frame was released in time.
+ */
+cy_rslt_t afe_pool_acquire(afe_pool_t *pool, cy_time_t timeout_ms, void **frame);
+
+/**
+ * Drop one reference of the frame. Frame is free once the last reference is dropped.
+ * Can be called from any context.
+ *
+ * @param[in]  pool          Pool
+ * @param[in]  frame         Frame returned by \ref afe_pool_acquire
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if frame does not belong to the pool or is not in use.
+ */
+cy_rslt_t afe_pool_release(afe_pool_t *pool, void *frame);
+
+/**
+ * Add one reference to a frame which is in use. Can be called from any context.
+ *
+ * @param[in]  pool          Pool
+ * @param[in]  frame         Frame returned by \ref afe_pool_acquire
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if frame does not belong to the pool or is not in use.
+ */
+cy_rslt_t afe_pool_hold(afe_pool_t *pool, void *frame);
+
+/**
+ * Get the number of free frames. Frames released meanwhile only make the count grow, so it is
+ * a lower bound for the single acquiring context.
+ *
+ * @param[in]  pool          Pool
+ *
+ * @return    Number of frames without a reference
+ */
+uint32_t afe_pool_free_count(afe_pool_t *pool);
+
+/**
+ * Check if the pointer is a frame of the pool
+ *
+ * @param[in]  pool          Pool
+ * @param[in]  frame         Pointer to be checked
+ *
+ * @return    true if frame belongs to the pool
+ */
+bool afe_pool_owns(afe_pool_t *pool, const void *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_POOL_H__ */
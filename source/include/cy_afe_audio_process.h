@@ -80,8 +80,43 @@ extern "C" {
  *
  * @param[in]  context               Audio front end middleware handle
  * @param[in]  queue_item            Queue item to be processed
+ * @param[out] output_info           Output buffer information, can be NULL
  */
-cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data_item_t *queue_item);
+cy_rslt_t afe_process_audio_data(afe_internal_context_t *context, afe_queue_data_item_t *queue_item,
+        cy_afe_buffer_info_t *output_info);
+
+/**
+ * Process incoming audio data with process_mutex already held by the caller
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  queue_item            Queue item to be processed
+ * @param[out] output_info           Output buffer information, can be NULL
+ */
+cy_rslt_t afe_process_audio_data_locked(afe_internal_context_t *context, afe_queue_data_item_t *queue_item,
+        cy_afe_buffer_info_t *output_info);
+
+/**
+ * Add the resampler memory allocated by \ref afe_setup_resampler to the memory required by the instance
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_BAD_ARG if the input sample rate can not be resampled.
+ */
+cy_rslt_t afe_require_resampler_memory(afe_internal_context_t *context);
+
+/**
+ * Setup the resampler if the input sample rate differs from the sample rate of speech enhancement
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+cy_rslt_t afe_setup_resampler(afe_internal_context_t *context);
+
+/**
+ * Release the resampler memory
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_cleanup_resampler(afe_internal_context_t *context);
 
 #ifdef __cplusplus
 }
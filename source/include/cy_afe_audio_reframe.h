@@ -0,0 +1,134 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_reframe.h
+ * @brief Reframing of input and output audio of any sample count to and from the AFE frames
+ *        processed by AFE middleware
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_AUDIO_REFRAME_H__
+#define AUDIO_FRONT_END_AUDIO_REFRAME_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_afe_audio_internal.h"
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Gather input samples into frames and feed every completed frame based on the processing mode
+ * of the instance. Must be called from a single context at a time.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input_audio_data_ptr  num_samples samples of each channel, channels back to back
+ * @param[in]  aec_ref_ptr           num_samples samples of AEC reference, can be NULL
+ * @param[in]  num_samples           Number of samples per channel
+ *
+ * @return    CY_RSLT_SUCCESS on success; error of the first completed frame which could not be fed.
+ */
+cy_rslt_t afe_reframe_feed(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_samples);
+
+/**
+ * Read output samples from the output queue, splitting frames across calls.
+ * Must be called from a single context at a time.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[out] output                Buffer of num_samples samples
+ * @param[in]  num_samples           Number of samples to read
+ * @param[out] samples_read          Number of samples read
+ * @param[in]  timeout_ms            Maximum time to wait for num_samples samples
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TIMEOUT if fewer samples were available in time.
+ */
+cy_rslt_t afe_reframe_read_output(afe_internal_context_t *context, CY_AFE_DATA_T *output, uint32_t num_samples,
+        uint32_t *samples_read, uint32_t timeout_ms);
+
+/**
+ * Add the frame allocated by \ref afe_setup_reframe to the memory required by the instance
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_require_reframe_memory(afe_internal_context_t *context);
+
+/**
+ * Allocate the frame which \ref afe_reframe_feed gathers samples into in sync mode
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_OUT_OF_MEMORY on failure.
+ */
+cy_rslt_t afe_setup_reframe(afe_internal_context_t *context);
+
+/**
+ * Return the partially gathered input frame and partially read output frame, and free the reframing buffers
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_reframe_cleanup(afe_internal_context_t *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_AUDIO_REFRAME_H__ */
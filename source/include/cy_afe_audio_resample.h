@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_resample.h
+ * @brief Polyphase FIR resampling between the input sample rate and the sample rate
+ *        of speech enhancement
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_RESAMPLE_H__
+#define AUDIO_FRONT_END_RESAMPLE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_result.h"
+#include <stdint.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/* Two microphones and the AEC reference */
+#define AFE_RESAMPLE_MAX_STREAMS        (3)
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct
+{
+    uint32_t factor;                                      // input sample rate divided by core sample rate
+    uint32_t taps;                                        // filter length at the input sample rate
+    uint32_t taps_per_phase;                              // filter length of one polyphase branch
+    uint32_t input_samples;                               // samples of one stream in an input frame
+    uint32_t num_streams;                                 // number of decimated streams
+    const int16_t *decimation_coefficients;               // anti-aliasing filter, Q15
+    int16_t *interpolation_coefficients;                  // polyphase branches of the same filter scaled by factor, Q15
+    int16_t *decimation_buffer[AFE_RESAMPLE_MAX_STREAMS]; // taps - 1 history samples followed by an input frame
+    int16_t *interpolation_buffer;                        // taps_per_phase - 1 history samples followed by a core frame
+} afe_resampler_t;
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Get the sample rate at which speech enhancement runs for an input sample rate
+ *
+ * @param[in]  sample_rate      Input sample rate in Hz
+ *
+ * @return Core sample rate, sample_rate itself if input is not resampled
+ */
+uint32_t afe_resample_get_core_rate(uint32_t sample_rate);
+
+/**
+ * Get the filter lengths available for an input sample rate
+ *
+ * @param[in]  sample_rate      Input sample rate in Hz
+ * @param[in]  index            Index of the filter, starting from 0
+ * @param[out] taps             Filter length at the input sample rate
+ *
+ * @return CY_RSLT_SUCCESS, CY_RSLT_AFE_BAD_ARG if there is no filter at index
+ */
+cy_rslt_t afe_resample_get_filter_taps(uint32_t sample_rate, uint32_t index, uint32_t *taps);
+
+/**
+ * Get the size of the buffer to be passed to \ref afe_resample_init
+ *
+ * @param[in]  sample_rate      Input sample rate in Hz
+ * @param[in]  taps             Filter length
+ * @param[in]  input_samples    Samples of one stream in an input frame
+ * @param[in]  num_streams      Number of decimated streams, up to AFE_RESAMPLE_MAX_STREAMS
+ *
+ * @return Buffer size in bytes, 0 if the configuration is not supported
+ */
+uint32_t afe_resample_get_buffer_size(uint32_t sample_rate, uint32_t taps, uint32_t input_samples, uint32_t num_streams);
+
+/**
+ * Initialize a resampler. Streams are decimated with the same filter at the same frame
+ * boundaries, keeping microphones and AEC reference phase aligned.
+ *
+ * @param[out] resampler        Resampler to initialize
+ * @param[in]  sample_rate      Input sample rate in Hz
+ * @param[in]  taps             Filter length
+ * @param[in]  input_samples    Samples of one stream in an input frame
+ * @param[in]  num_streams      Number of decimated streams, up to AFE_RESAMPLE_MAX_STREAMS
+ * @param[in]  buffer           Zero initialized buffer of \ref afe_resample_get_buffer_size bytes
+ *
+ * @return CY_RSLT_SUCCESS, CY_RSLT_AFE_BAD_ARG if the configuration is not supported
+ */
+cy_rslt_t afe_resample_init(afe_resampler_t *resampler, uint32_t sample_rate, uint32_t taps,
+        uint32_t input_samples, uint32_t num_streams, void *buffer);
+
+/**
+ * Decimate one input frame of a stream to the core sample rate
+ *
+ * @param[in]  resampler        Resampler
+ * @param[in]  stream           Stream index
+ * @param[in]  input            input_samples samples at the input sample rate
+ * @param[out] output           input_samples / factor samples at the core sample rate
+ */
+void afe_resample_decimate(afe_resampler_t *resampler, uint32_t stream, const int16_t *input, int16_t *output);
+
+/**
+ * Clear the history of a stream, used when a stream is not fed for a frame
+ *
+ * @param[in]  resampler        Resampler
+ * @param[in]  stream           Stream index
+ */
+void afe_resample_reset_stream(afe_resampler_t *resampler, uint32_t stream);
+
+/**
+ * Interpolate one core frame back to the input sample rate
+ *
+ * @param[in]  resampler        Resampler
+ * @param[in]  input            input_samples / factor samples at the core sample rate
+ * @param[out] output           input_samples samples at the input sample rate
+ */
+void afe_resample_interpolate(afe_resampler_t *resampler, const int16_t *input, int16_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_RESAMPLE_H__ */
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+
+/**
+ * @file cy_afe_audio_ring.h
+ * @brief Single producer/single consumer ring of fixed size items, used to pass
+ *        audio frames from cy_afe_feed (which may run in ISR context) to the
+ *        audio processing task without a kernel queue operation per frame.
+ *
+ */
+
+#ifndef AUDIO_FRONT_END_RING_H__
+#define AUDIO_FRONT_END_RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cy_result.h"
+#include "cyabs_rtos.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct
+{
+    uint8_t *buffer;                        // Item storage of (index_mask + 1) * item_size bytes
+    uint32_t item_size;                     // Size of one item in bytes
+    uint32_t capacity;                      // Maximum number of queued items
+    uint32_t index_mask;                    // Number of slots (power of 2) - 1
+    atomic_uint_fast32_t write_count;       // Free running count of published items, updated only by producer
+    atomic_uint_fast32_t read_count;        // Free running count of removed items
+    atomic_bool consumer_waiting;           // Set while consumer is (about to be) blocked on data_semaphore
+    atomic_bool producer_waiting;           // Set while producer is (about to be) blocked on space_semaphore
+    cy_semaphore_t data_semaphore;          // Signaled by producer only when consumer is waiting
+    cy_semaphore_t space_semaphore;         // Signaled by consumer only when producer is waiting
+    bool initialized;
+} afe_ring_t;
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Get the size of the item storage to be passed to \ref afe_ring_init
+ *
+ * @param[in]  item_size     Size of one item in bytes
+ * @param[in]  capacity      Maximum number of items which can be queued
+ *
+ * @return    Size in bytes
+ */
+uint32_t afe_ring_buffer_size(uint32_t item_size, uint32_t capacity);
+
+/**
+ * Initialize the ring
+ *
+ * @param[in]  ring          Ring to be initialized
+ * @param[in]  buffer        Item storage of \ref afe_ring_buffer_size bytes, owned by the caller
+ * @param[in]  item_size     Size of one item in bytes
+ * @param[in]  capacity      Maximum number of items which can be queued
+ *
+ * @return    CY_RSLT_SUCCESS on success; error codes on failure.
+ */
+cy_rslt_t afe_ring_init(afe_ring_t *ring, void *buffer, uint32_t item_size, uint32_t capacity);
+
+/**
+ * De-initialize the ring. The item storage is not freed.
+ *
+ * @param[in]  ring          Ring to be de-initialized
+ */
+void afe_ring_deinit(afe_ring_t *ring);
+
+/**
+ * Copy an item into the ring and wake up the consumer if it is waiting for data.
+ * Must be called from a single producer, can be called from ISR context.
+ *
+ * @param[in]  ring          Ring
+ * @param[in]  item          Item of item_size bytes
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_QUEUE_FULL when there is no free slot.
+ */
+cy_rslt_t afe_ring_push(afe_ring_t *ring, const void *item);
+
+/**
+ * Get the slot which follows the last published item by offset items, for filling it in place.
+ * Must be called from the single producer. Slots are made visible to the consumer by \ref afe_ring_commit.
+ *
+ * @param[in]  ring          Ring
+ * @param[in]  offset        Offset from the first unpublished slot, must be less than \ref afe_ring_free_count
+ *
+ * @return    Pointer to the slot of item_size bytes
+ */
+void *afe_ring_write_slot(afe_ring_t *ring, uint32_t offset);
+
+/**
+ * Publish count slots filled through \ref afe_ring_write_slot and wake up the consumer if it
+ * is waiting for data. Consumer is notified only once for all the slots.
+ *
+ * @param[in]  ring          Ring
+ * @param[in]  count         Number of slots to publish, must not be more than \ref afe_ring_free_count
+ */
+void afe_ring_commit(afe_ring_t *ring, uint32_t count);
+
+/**
+ * Wait till at least count slots are free. Must be called from the single producer, in task context.
+ *
+ * @param[in]  ring          Ring
+ * @param[in]  count         Number of free slots required
+ * @param[in]  timeout_ms    Time to wait. CY_RTOS_NEVER_TIMEOUT waits forever.
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RTOS_TIMEOUT if the slots did not become free in time.
+ */
+cy_rslt_t afe_ring_wait_for_space(afe_ring_t *ring, uint32_t count, cy_time_t timeout_ms);
+
+/**
+ * Remove the oldest item from the producer side to make room for a new item.
+ * Must be called from the single producer.
+ *
+ * @param[in]  ring          Ring
+ * @param[out] item          Buffer of item_size bytes to receive the removed item
+ *
+ * @return    true if an item was removed; false if the consumer has freed a slot meanwhile or ring is empty.
+ */
+bool afe_ring_drop_oldest(afe_ring_t *ring, void *item);
+
+/**
+ * Copy the oldest item out of the ring, waiting for the producer if the ring is empty.
+ * Must be called from a single consumer task.
+ *
+ * @param[in]  ring          Ring
+ * @param[out] item          Buffer of item_size bytes
+ * @param[in]  timeout_ms    Time to wait for an item. 0 returns immediately, CY_RTOS_NEVER_TIMEOUT waits forever.
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RTOS_TIMEOUT if no item was available in time.
+ */
+cy_rslt_t afe_ring_pop(afe_ring_t *ring, void *item, cy_time_t timeout_ms);
+
+/**
+ * Get the number of items currently queued
+ *
+ * @param[in]  ring          Ring
+ *
+ * @return    Number of items
+ */
+uint32_t afe_ring_count(afe_ring_t *ring);
+
+/**
+ * Get the number of items which can be pushed before the ring is full
+ *
+ * @param[in]  ring          Ring
+ *
+ * @return    Number of free slots
+ */
+uint32_t afe_ring_free_count(afe_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_RING_H__ */
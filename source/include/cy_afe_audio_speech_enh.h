@@ -96,6 +96,16 @@ typedef struct
      */
     CY_AFE_DATA_T *ifx_internal_output;
 
+    /*
+     * Pointer to sound meter values updated on every process call
+     */
+    int16_t *audio_meter;
+
+    /*
+     * Size of one channel frame in bytes
+     */
+    uint32_t frame_size;
+
 } afe_sp_enh_input_output_t;
 
 typedef struct
@@ -121,17 +131,36 @@ typedef struct
 /******************************************************
  *               Function Declarations
  ******************************************************/
+/**
+ * Memory callbacks registered with the speech enhancement library. Memory is requested
+ * through the allocator callbacks of the AFE instance being initialized.
+ */
+cy_rslt_t afe_sp_alloc_memory_callback_t(ifx_sp_mem_id mem_id, uint32_t size, void **buffer);
+
+cy_rslt_t afe_sp_free_memory_callback_t(ifx_sp_mem_id mem_id, void *buffer);
+
+/**
+ * Validate the audio format against the formats supported by speech enhancement
+ *
+ * @param[in] sample_rate           Input sample rate in Hz
+ * @param[in] frame_size_ms         Frame duration in ms
+ * @param[in] num_channels          Number of input channels
+ * @return cy_rslt_t
+ */
+cy_rslt_t afe_speech_enhancement_validate_format(uint32_t sample_rate, uint32_t frame_size_ms, uint32_t num_channels);
+
 /**
  * Initialize the system audio front end APIs for speech enhancement
  *
+ * @param[in] context               Pointer to internal AFE context, speech enhancement
+ *                                  handle is stored in context->sp_enh_context
  * @param[in] filter_settings       filter settings format generated
  * @param[in] mw_settings           Middleware settings format generated
  * @param[in] mw_settings_length    Middleware settings length
- * @param[in] context               Pointer to internal AFE context
  * @return cy_rslt_t
  */
-cy_rslt_t afe_speech_enhancement_init(int32_t *filter_settings,uint8_t *mw_settings,
-                                    uint32_t mw_settings_length, void **context);
+cy_rslt_t afe_speech_enhancement_init(afe_internal_context_t *context, int32_t *filter_settings,
+                                    uint8_t *mw_settings, uint32_t mw_settings_length);
 
 /**
  * Process the incoming audio data and generate the output
@@ -151,7 +180,29 @@ cy_rslt_t afe_speech_enhancement_process(void *context, afe_sp_enh_input_output_
  *
  * @return    cy_rslt_t
  */
-cy_rslt_t afe_speech_enhancement_deinit(void *context);
+cy_rslt_t afe_speech_enhancement_deinit(afe_internal_context_t *context);
+
+/**
+ * Re-create the speech enhancement library instance with other filter settings. The
+ * previous settings are restored if the new settings can not be applied. Must not run
+ * concurrently with processing.
+ *
+ * @param[in] context               Pointer to internal AFE context
+ * @param[in] filter_settings       filter settings format generated
+ * @param[in] mw_settings           Middleware settings format generated
+ * @param[in] mw_settings_length    Middleware settings length
+ * @return cy_rslt_t
+ */
+cy_rslt_t afe_speech_enhancement_reinit(afe_internal_context_t *context, int32_t *filter_settings,
+                                    uint8_t *mw_settings, uint32_t mw_settings_length);
+
+/**
+ * Get the memory currently held by the speech enhancement library per component
+ *
+ * @param[in]  context              Pointer to internal AFE context
+ * @param[out] report               Bytes held per component
+ */
+void afe_speech_enhancement_get_memory(afe_internal_context_t *context, cy_afe_component_memory_t *report);
 
 /**
  * Enable/disable component
@@ -196,7 +247,91 @@ cy_rslt_t afe_speech_enhancement_get_config_value(void *context, ifx_sp_enh_ip_c
 cy_rslt_t afe_speech_enhancement_get_component_status(void *context, ifx_sp_enh_ip_component_config_t component_name, bool* enable);
 
 #ifdef CY_AFE_ENABLE_TUNING_FEATURE
-cy_rslt_t afe_speech_enhancement_update_dbg_out_config(void *sp_enh_context,afe_usb_settings_t *pMY_AFE_USB_SETTINGS);
+cy_rslt_t afe_speech_enhancement_update_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *pMY_AFE_USB_SETTINGS);
+
+/**
+ * Stage a debug output channel selection and wait for the processing context to apply it
+ *
+ * @param[in] context              Pointer to internal AFE context
+ * @param[in] usb_settings         Debug output channel selection
+ *
+ * @return    CY_RSLT_SUCCESS on success or if no frame is processed meanwhile; an error code on failure.
+ */
+cy_rslt_t afe_speech_enhancement_set_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *usb_settings);
+
+/**
+ * Get the debug output channel selection last applied
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ * @param[out] usb_settings        Debug output channel selection
+ */
+void afe_speech_enhancement_get_dbg_out_config(afe_internal_context_t *context, afe_usb_settings_t *usb_settings);
+
+/**
+ * Get the tuner parameter update counters
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ * @param[out] stats               Tuner parameter update counters
+ */
+void afe_speech_enhancement_get_tuner_stats(afe_internal_context_t *context, cy_afe_tuner_stats_t *stats);
+
+/**
+ * Get the state and parameters of all components, debug output selection and update counters
+ * as last published by the processing context
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ * @param[out] snapshot            Published tuner state
+ */
+void afe_speech_enhancement_get_all_params(afe_internal_context_t *context, afe_tuner_params_snapshot_t *snapshot);
+
+/**
+ * Open a transaction. Updates are kept until committed instead of being applied one by one.
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TUNER_INALID_CMD if a transaction is already open.
+ */
+cy_rslt_t afe_speech_enhancement_begin_params_transaction(afe_internal_context_t *context);
+
+/**
+ * Close the transaction and apply its updates in a single frame boundary. If the library rejects
+ * one of them, the components are restored to their previous state in that same frame boundary.
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ *
+ * @return    CY_RSLT_SUCCESS on success; an error code on failure.
+ */
+cy_rslt_t afe_speech_enhancement_commit_params_transaction(afe_internal_context_t *context);
+
+/**
+ * Close the transaction and drop its updates
+ *
+ * @param[in]  context             Pointer to internal AFE context
+ */
+void afe_speech_enhancement_abort_params_transaction(afe_internal_context_t *context);
+
+/**
+ * Read the state and parameters of all components into the snapshot read by the tuner.
+ * Called when the library is initialized, before frames are processed.
+ *
+ * @param[in] context              Pointer to internal AFE context
+ */
+void afe_speech_enhancement_refresh_params(afe_internal_context_t *context);
+
+/**
+ * Apply the tuner update staged since the previous frame, if any. Called by the processing
+ * context at a frame boundary; the library is only changed from there.
+ *
+ * @param[in] context              Pointer to internal AFE context
+ */
+void afe_speech_enhancement_apply_params(afe_internal_context_t *context);
+
+/**
+ * Publish the sound meter of the frame just processed to the tuner
+ *
+ * @param[in] context              Pointer to internal AFE context
+ */
+void afe_speech_enhancement_publish_meter(afe_internal_context_t *context);
 
 cy_rslt_t afe_speech_enhancement_get_sound_meter(void *context, int16_t *audio_meter);
 
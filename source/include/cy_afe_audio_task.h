@@ -74,6 +74,14 @@ extern "C" {
  *               Function Declarations
  ******************************************************/
 
+/**
+ * Add the memory allocated by \ref afe_setup_audio_processing_task to the memory required by the
+ * instance, without allocating it
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_require_audio_processing_memory(afe_internal_context_t *context);
+
 /**
  * Setup audio processing task and queue
  *
@@ -88,6 +96,24 @@ cy_rslt_t afe_setup_audio_processing_task(afe_internal_context_t *context);
  */
 cy_rslt_t afe_cleanup_audio_processing_task(afe_internal_context_t *context);
 
+/**
+ * Take the producer side of the audio processing queue and input pool, which take one
+ * producer at a time. Fails at once if another feed holds it.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  num_frames            Number of frames accounted as not queued on failure
+ *
+ * @return     CY_RSLT_SUCCESS, or CY_RSLT_AFE_BUSY if another feed is in progress
+ */
+cy_rslt_t afe_enter_producer(afe_internal_context_t *context, uint32_t num_frames);
+
+/**
+ * Release the producer side taken by \ref afe_enter_producer
+ *
+ * @param[in]  context               Audio front end middleware handle
+ */
+void afe_exit_producer(afe_internal_context_t *context);
+
 /**
  * Push audio data to task for further processing
  *
@@ -99,6 +125,72 @@ cy_rslt_t afe_cleanup_audio_processing_task(afe_internal_context_t *context);
 cy_rslt_t afe_push_audio_data_to_queue(afe_internal_context_t *context,
         CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr);
 
+/**
+ * Push a block of audio frames to task for further processing. Either all or none of
+ * the frames are queued.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input_audio_data_ptr  Input audio data pointer to num_frames contiguous frames
+ * @param[in]  aec_ref_ptr           Input AEC reference pointer to num_frames contiguous frames, can be NULL
+ * @param[in]  num_frames            Number of frames
+ *
+ */
+cy_rslt_t afe_push_audio_data_batch_to_queue(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames);
+
+/**
+ * Process audio data in the caller context, without the audio processing task
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input_audio_data_ptr  Input audio data pointer
+ * @param[in]  aec_ref_ptr           Input AEC reference pointer
+ * @param[out] output_info           Output buffer information, can be NULL
+ *
+ */
+cy_rslt_t afe_process_audio_data_in_caller(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, cy_afe_buffer_info_t *output_info);
+
+/**
+ * Feed audio data for processing based on the processing mode of the instance.
+ * Frames are either queued to the audio processing task or processed in the caller context.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input_audio_data_ptr  Input audio data pointer
+ * @param[in]  aec_ref_ptr           Input AEC reference pointer
+ *
+ */
+cy_rslt_t afe_feed_audio_data(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr);
+
+/**
+ * Feed a block of audio frames for processing based on the processing mode of the instance
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  input_audio_data_ptr  Input audio data pointer to num_frames contiguous frames
+ * @param[in]  aec_ref_ptr           Input AEC reference pointer to num_frames contiguous frames, can be NULL
+ * @param[in]  num_frames            Number of frames
+ *
+ */
+cy_rslt_t afe_feed_audio_data_batch(afe_internal_context_t *context,
+        CY_AFE_DATA_T *input_audio_data_ptr, CY_AFE_DATA_T *aec_ref_ptr, uint32_t num_frames);
+
+/**
+ * Notify new samples written to the input ring. Can be called from ISR.
+ *
+ * @param[in]  context               Audio front end middleware handle
+ * @param[in]  num_samples           Number of new samples per channel
+ *
+ */
+cy_rslt_t afe_notify_input_ring_samples(afe_internal_context_t *context, uint32_t num_samples);
+
+/**
+ * Get the number of input frames waiting to be processed, in the input queue or in the input ring
+ *
+ * @param[in]  context               Audio front end middleware handle
+ *
+ */
+uint32_t afe_get_pending_input_frames(afe_internal_context_t *context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,8 +48,10 @@ extern "C" {
 #endif
 
 #include "cy_result.h"
+#include "cy_audio_front_end.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef COMPONENT_PROFILER
 typedef enum
@@ -77,6 +79,36 @@ typedef struct
 cy_rslt_t cy_afe_profile(afe_profile_command cmd,
         afe_profile_data_t *data);
 
+/* Benchmark decimation of two microphones and AEC reference and interpolation of the
+ * output, printing cycles per frame for each filter length available for sample_rate */
+cy_rslt_t cy_afe_profile_resampler(uint32_t sample_rate, uint32_t frame_size_ms);
+
+/* Benchmark afe_ring_push/afe_ring_pop against cy_rtos_put_queue/cy_rtos_get_queue with the
+ * audio processing task queue item, printing cycles per item over iterations items */
+cy_rslt_t cy_afe_profile_ring(uint32_t iterations);
+
+/* Benchmark every sample format conversion, with and without dither where it applies,
+ * printing cycles per frame of samples samples */
+cy_rslt_t cy_afe_profile_format_conversion(uint32_t samples);
+
+/* Create a mono and a stereo instance from the given configurations, each with filter settings
+ * of its own number of microphones, process frames frames with each in sync mode and print the
+ * memory requested per memory ID and the speech enhancement cycles per frame of both */
+cy_rslt_t cy_afe_profile_mono_stereo(const cy_afe_config_t *mono_config, const cy_afe_config_t *stereo_config,
+        uint32_t frames);
+
+/* Process frames frames with each configuration alone and with both instances alive, in sync mode,
+ * and create and delete both iterations times from two threads at once. Returns
+ * CY_RSLT_AFE_GENERIC_ERROR if the memory requested or the output of an instance differs from its
+ * run alone */
+cy_rslt_t cy_afe_profile_multi_instance(const cy_afe_config_t *config_a, const cy_afe_config_t *config_b,
+        uint32_t frames, uint32_t iterations);
+
+/* Feed frames frames back to back to a task mode instance with an input queue of queue_size frames and an
+ * output consumer slower than real time, once per overload policy. Returns CY_RSLT_AFE_GENERIC_ERROR if the
+ * overload counters do not match the frames fed and processed, or if a feed waits longer than the policy allows */
+cy_rslt_t cy_afe_profile_overload(const cy_afe_config_t *config, uint32_t frames, uint32_t queue_size);
+
 #endif /* COMPONENT_PROFILER */
 #endif  /*__CY_AFE_PROFILER_H__ */
 
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file cy_afe_tuner_binary.h
+ * @brief Binary tuner protocol, framed requests dispatched by command ID without heap use.
+ *
+ * Request and response frame, multi-byte fields are little endian:
+ *
+ *     offset  size  field
+ *     0       1     sync, AFE_TUNER_BIN_SYNC. Text commands never start with this byte.
+ *     1       1     command ID, AFE_TUNER_BIN_CMD_*. Set to (ID | AFE_TUNER_BIN_RESPONSE) in the response.
+ *     2       1     sequence, echoed in the response
+ *     3       1     status, 0 in requests, AFE_TUNER_BIN_STATUS_* in responses
+ *     4       2     payload length
+ *     6       n     payload, TLV parameters: type (1 byte), length (1 byte), value
+ *     6 + n   2     CRC-16/CCITT-FALSE of bytes 0 .. 5 + n
+ *
+ * Components are identified by their ifx_sp_enh_ip_component_config_t value.
+ */
+
+#ifndef AUDIO_FRONT_END_TUNER_BINARY_H__
+#define AUDIO_FRONT_END_TUNER_BINARY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CY_AFE_ENABLE_TUNING_FEATURE
+#include "cy_afe_audio_internal.h"
+/******************************************************
+ *                     Macros
+ ******************************************************/
+#define AFE_TUNER_BIN_SYNC                   (0xA5)
+#define AFE_TUNER_BIN_RESPONSE               (0x80)
+#define AFE_TUNER_BIN_HEADER_LEN             (6)
+#define AFE_TUNER_BIN_CRC_LEN                (2)
+
+/** Returned by afe_tuner_binary_frame_length when the data does not start with a valid header */
+#define AFE_TUNER_BIN_FRAME_INVALID          (0xFFFF)
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+/**
+ * Binary command IDs, index of the dispatch table
+ */
+typedef enum
+{
+    AFE_TUNER_BIN_CMD_NONE = 0,
+    AFE_TUNER_BIN_CMD_GET_COMPONENT_STATE,   /**< COMPONENT -> ENABLE */
+    AFE_TUNER_BIN_CMD_SET_COMPONENT_STATE,   /**< COMPONENT, ENABLE */
+    AFE_TUNER_BIN_CMD_GET_CONFIG_VALUE,      /**< COMPONENT -> VALUE */
+    AFE_TUNER_BIN_CMD_SET_CONFIG_VALUE,      /**< COMPONENT, VALUE */
+    AFE_TUNER_BIN_CMD_GET_COMPONENT_PARAMS,  /**< COMPONENT -> VALUES */
+    AFE_TUNER_BIN_CMD_GET_SOUND_METER,       /**< -> METER */
+    AFE_TUNER_BIN_CMD_GET_AUDIO_CHANNELS,    /**< -> CHANNELS */
+    AFE_TUNER_BIN_CMD_SET_AUDIO_CHANNELS,    /**< CHANNELS */
+    AFE_TUNER_BIN_CMD_GET_ALL_PARAMS,        /**< -> (COMPONENT, ENABLE[, VALUES]) per component, CHANNELS */
+    AFE_TUNER_BIN_CMD_BEGIN,                 /**< Open a transaction, set commands are staged without response */
+    AFE_TUNER_BIN_CMD_COMMIT,                /**< -> COUNT on success, INDEX of the first set command rejected on receipt otherwise */
+    AFE_TUNER_BIN_CMD_ABORT,                 /**< Drop the staged settings */
+    AFE_TUNER_BIN_CMD_GET_TUNER_STATS,       /**< -> STATS */
+    AFE_TUNER_BIN_CMD_MAX
+} afe_tuner_bin_cmd_t;
+
+/**
+ * TLV parameter types
+ */
+typedef enum
+{
+    AFE_TUNER_BIN_TLV_COMPONENT = 1,         /**< uint8, component */
+    AFE_TUNER_BIN_TLV_ENABLE,                /**< uint8, 0 disabled, 1 enabled */
+    AFE_TUNER_BIN_TLV_VALUE,                 /**< int32, configuration value */
+    AFE_TUNER_BIN_TLV_VALUES,                /**< int32 array, component parameters */
+    AFE_TUNER_BIN_TLV_METER,                 /**< int16 array, sound meter */
+    AFE_TUNER_BIN_TLV_CHANNELS,              /**< 4 x uint8, debug output channel selection */
+    AFE_TUNER_BIN_TLV_STATS,                 /**< 3 x uint32, cy_afe_tuner_stats_t */
+    AFE_TUNER_BIN_TLV_COUNT,                 /**< uint32, set commands of a committed transaction */
+    AFE_TUNER_BIN_TLV_INDEX,                 /**< uint32, 1 based index of the failed set command */
+} afe_tuner_bin_tlv_t;
+
+/**
+ * Response status
+ */
+typedef enum
+{
+    AFE_TUNER_BIN_STATUS_OK = 0,
+    AFE_TUNER_BIN_STATUS_INVALID_CMD,
+    AFE_TUNER_BIN_STATUS_INVALID_PARAMS,
+    AFE_TUNER_BIN_STATUS_ERROR,
+    AFE_TUNER_BIN_STATUS_INTERNAL_ERROR,
+    AFE_TUNER_BIN_STATUS_COMPONENT_NOT_ENABLED,
+    AFE_TUNER_BIN_STATUS_NOT_SUPPORTED,
+    AFE_TUNER_BIN_STATUS_CRC_ERROR,
+} afe_tuner_bin_status_t;
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Get the length of the binary frame at the start of data
+ *
+ * @param[in]  data         Received data starting with AFE_TUNER_BIN_SYNC
+ * @param[in]  length       Number of bytes received
+ * @param[in]  max_length   Longest frame which can be received
+ *
+ * @return    Frame length including header and CRC, 0 if more data is needed to complete the frame,
+ *            AFE_TUNER_BIN_FRAME_INVALID if the header is not valid.
+ */
+uint16_t afe_tuner_binary_frame_length(const uint8_t *data, uint16_t length, uint16_t max_length);
+
+/**
+ * Check and dispatch a complete binary frame, then send its response
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  frame        Frame returned complete by afe_tuner_binary_frame_length
+ * @param[in]  length       Frame length
+ */
+void afe_tuner_binary_process_frame(afe_internal_context_t *context, const uint8_t *frame, uint16_t length);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_FRONT_END_TUNER_BINARY_H__ */
@@ -48,14 +48,19 @@
 /******************************************************
  *                     Macros
  ******************************************************/
+#define SET_CMD "set"
+#define GET_CMD "get"
 
 /******************************************************
  *                    Constants
  ******************************************************/
 /**
- * Maximum command buffer size as request from configurator tool
+ * Default command buffer size as request from configurator tool, overridden by
+ * tuner_command_buffer_size of the configuration
  */
+#ifndef CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE
 #define CY_AFE_TUNER_MAX_COMMAND_BUFFER_SIZE (500)
+#endif
 
 /** Maximum number of paramaters any tuner commands can have */
 #define MAX_NUM_PARAMS                       (10)
@@ -81,6 +86,7 @@ typedef struct
     command_function_t command;             /**< Function that runs the command. */
     uint32_t arg_count;                     /**< Minimum number of arguments. */
     const char* delimit;                    /**< Custom string of characters that may delimit the arguments for this command - NULL value will use the default for the console. */
+    bool transaction;                       /**< Set command applied by AFE, can be staged by a transaction. */
 } cy_afe_tuner_cmd_t;
 
 /******************************************************
@@ -123,6 +129,35 @@ cy_rslt_t afe_receive_tuner_command_req(afe_internal_context_t* context);
  */
 const char* get_status_string_from_result(cy_rslt_t result);
 
+/**
+ * Notify the application of a setting applied by AFE. Settings staged by an open transaction
+ * are notified once the transaction is committed.
+ *
+ * @param[in]  handle           Audio front end middleware handle
+ * @param[in]  config_setting   Setting to notify, value points to an int
+ */
+void afe_tuner_notify_settings(afe_internal_context_t *handle, cy_afe_config_setting_t *config_setting);
+
+/**
+ * Open a tuner transaction. Set commands received until it is closed are staged.
+ *
+ * @param[in]  handle           Audio front end middleware handle
+ *
+ * @return    CY_RSLT_SUCCESS on success; CY_RSLT_AFE_TUNER_INALID_CMD if a transaction is already open.
+ */
+cy_rslt_t afe_tuner_transaction_begin(afe_internal_context_t *handle);
+
+/**
+ * Close the tuner transaction
+ *
+ * @param[in]  handle           Audio front end middleware handle
+ * @param[in]  commit           true to apply the staged settings in a single frame boundary, false to drop them
+ *
+ * @return    CY_RSLT_SUCCESS on success; the result of the first failed set command of the
+ *            transaction (tuner_transaction.failed_index) or an error code on failure.
+ */
+cy_rslt_t afe_tuner_transaction_end(afe_internal_context_t *handle, bool commit);
+
 #endif
 
 #endif /* AUDIO_FRONT_END_TUNER_PROCESS_H__ */
@@ -89,6 +89,15 @@ cy_rslt_t afe_setup_audio_tuner_task(afe_internal_context_t *context, cy_afe_con
  */
 cy_rslt_t afe_cleanup_audio_tuner_task(afe_internal_context_t *context);
 
+/**
+ * Add the tuner command buffers of \ref afe_setup_audio_tuner_task and the debug outputs of
+ * \ref afe_allocate_memory_for_dbg_output to the memory required by the instance
+ *
+ * @param[in]  context      Audio front end middleware handle
+ * @param[in]  config       Audio front end configuration
+ */
+void afe_require_audio_tuner_memory(afe_internal_context_t *context, cy_afe_config_t *config);
+
 /**
  * Allocate memory for AFE debug output
  *
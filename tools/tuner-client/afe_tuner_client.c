@@ -0,0 +1,740 @@
+/*
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ */
+
+/**
+ * @file afe_tuner_client.c
+ * @brief Host command-line client replaying a script of tuner commands over the socket tuner transport
+ *        (cy_afe_tuner_socket.h), measuring command round-trip and parameter apply latency.
+ *
+ * Script lines:
+ *
+ *     # comment
+ *     sleep,<ms>                     pause the script
+ *     stats                          print the tuner update counters of AFE
+ *     bin,<cmd>[,<type>:<hex>]...    binary frame, e.g. bin,2,1:02,2:01 enables component 2
+ *     <any other line>               text command, sent with <CR><LF>, e.g. set,ns,15
+ *
+ * Set commands inside a transaction (begin ... commit / abort) are answered by the commit only.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/******************************************************
+ *                     Macros
+ ******************************************************/
+/* Binary protocol, refer cy_afe_tuner_binary.h */
+#define BIN_SYNC                    (0xA5)
+#define BIN_RESPONSE                (0x80)
+#define BIN_HEADER_LEN              (6)
+#define BIN_CRC_LEN                 (2)
+#define BIN_CMD_SET_COMPONENT_STATE (2)
+#define BIN_CMD_SET_CONFIG_VALUE    (4)
+#define BIN_CMD_SET_AUDIO_CHANNELS  (8)
+#define BIN_CMD_BEGIN               (10)
+#define BIN_CMD_COMMIT              (11)
+#define BIN_CMD_ABORT               (12)
+#define BIN_CMD_GET_TUNER_STATS     (13)
+#define BIN_TLV_STATS               (7)
+
+#define TEXT_RESPONSE_HEADER        "AFERSP,"
+#define TEXT_RESPONSE_OK            "AFERSP,ok"
+
+#define MAX_LINE_LEN                (1024)
+#define MAX_FRAME_LEN               (65535 + BIN_HEADER_LEN + BIN_CRC_LEN)
+#define DEFAULT_TIMEOUT_MS          (2000)
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct
+{
+    int fd;
+    int timeout_ms;
+    uint8_t rx[MAX_FRAME_LEN];
+    uint32_t rx_len;
+    uint8_t sequence;
+    bool transaction_open;
+} client_t;
+
+typedef struct
+{
+    double *values;
+    uint32_t count;
+    uint32_t capacity;
+} samples_t;
+
+typedef struct
+{
+    uint32_t updates_applied;
+    uint32_t last_apply_latency_ms;
+    uint32_t max_apply_latency_ms;
+} tuner_stats_t;
+
+/******************************************************
+ *               Static Functions
+ ******************************************************/
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1000.0) + ((double) ts.tv_nsec / 1000000.0);
+}
+
+/* usleep is obsolete in POSIX.1-2008 and limited to less than a second on some systems */
+static void sleep_ms(unsigned long ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t) (ms / 1000);
+    ts.tv_nsec = (long) (ms % 1000) * 1000000L;
+    while((0 != nanosleep(&ts, &ts)) && (EINTR == errno))
+    {
+    }
+}
+
+static uint16_t crc16(const uint8_t *data, uint32_t length)
+{
+    uint16_t crc = 0xFFFF;
+    uint32_t index = 0;
+    int bit = 0;
+
+    for(index = 0; index < length; index++)
+    {
+        crc ^= (uint16_t)(data[index] << 8);
+        for(bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint32_t get_u32(const uint8_t *data)
+{
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+static void samples_add(samples_t *samples, double value)
+{
+    if(samples->count == samples->capacity)
+    {
+        samples->capacity = (0 == samples->capacity) ? 64 : (samples->capacity * 2);
+        samples->values = realloc(samples->values, samples->capacity * sizeof(double));
+        if(NULL == samples->values)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+    }
+    samples->values[samples->count++] = value;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double*) a;
+    double y = *(const double*) b;
+
+    return (x > y) - (x < y);
+}
+
+static void samples_print(const char *name, samples_t *samples)
+{
+    double sum = 0;
+    uint32_t index = 0;
+
+    if(0 == samples->count)
+    {
+        printf("%-12s no samples\n", name);
+        return;
+    }
+
+    qsort(samples->values, samples->count, sizeof(double), compare_double);
+    for(index = 0; index < samples->count; index++)
+    {
+        sum += samples->values[index];
+    }
+
+    printf("%-12s n=%"PRIu32" min=%.3f avg=%.3f p50=%.3f p99=%.3f max=%.3f ms\n", name, samples->count,
+            samples->values[0], sum / samples->count, samples->values[samples->count / 2],
+            samples->values[(uint32_t)((samples->count - 1) * 0.99)], samples->values[samples->count - 1]);
+}
+
+static int client_connect(client_t *client, const char *unix_path, const char *host, uint16_t port)
+{
+    struct sockaddr_un unix_addr;
+    struct sockaddr_in tcp_addr;
+    int enable = 1;
+
+    if(NULL != unix_path)
+    {
+        memset(&unix_addr, 0, sizeof(unix_addr));
+        unix_addr.sun_family = AF_UNIX;
+        strncpy(unix_addr.sun_path, unix_path, sizeof(unix_addr.sun_path) - 1);
+        client->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if((client->fd < 0) || (0 != connect(client->fd, (struct sockaddr*) &unix_addr, sizeof(unix_addr))))
+        {
+            fprintf(stderr, "Cannot connect to %s: %s\n", unix_path, strerror(errno));
+            return -1;
+        }
+        return 0;
+    }
+
+    memset(&tcp_addr, 0, sizeof(tcp_addr));
+    tcp_addr.sin_family = AF_INET;
+    tcp_addr.sin_port = htons(port);
+    if(1 != inet_pton(AF_INET, host, &tcp_addr.sin_addr))
+    {
+        fprintf(stderr, "Invalid address %s\n", host);
+        return -1;
+    }
+
+    client->fd = socket(AF_INET, SOCK_STREAM, 0);
+    if((client->fd < 0) || (0 != connect(client->fd, (struct sockaddr*) &tcp_addr, sizeof(tcp_addr))))
+    {
+        fprintf(stderr, "Cannot connect to %s:%u: %s\n", host, port, strerror(errno));
+        return -1;
+    }
+    setsockopt(client->fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    return 0;
+}
+
+static int client_send(client_t *client, const uint8_t *data, uint32_t length)
+{
+    ssize_t sent = 0;
+    uint32_t offset = 0;
+
+    while(offset < length)
+    {
+        sent = send(client->fd, data + offset, length - offset, MSG_NOSIGNAL);
+        if(sent < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            fprintf(stderr, "send failed: %s\n", strerror(errno));
+            return -1;
+        }
+        offset += (uint32_t) sent;
+    }
+
+    return 0;
+}
+
+/*
+ * Receive till at least length bytes are buffered
+ */
+static int client_fill(client_t *client, uint32_t length, double deadline)
+{
+    struct pollfd poll_fd;
+    ssize_t received = 0;
+    int timeout = 0;
+
+    while(client->rx_len < length)
+    {
+        timeout = (int)(deadline - now_ms());
+        if(timeout <= 0)
+        {
+            fprintf(stderr, "Response timeout\n");
+            return -1;
+        }
+
+        poll_fd.fd = client->fd;
+        poll_fd.events = POLLIN;
+        poll_fd.revents = 0;
+        if(poll(&poll_fd, 1, timeout) <= 0)
+        {
+            continue;
+        }
+
+        received = recv(client->fd, client->rx + client->rx_len, sizeof(client->rx) - client->rx_len, 0);
+        if(0 == received)
+        {
+            fprintf(stderr, "Connection closed by AFE\n");
+            return -1;
+        }
+        if(received < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            fprintf(stderr, "recv failed: %s\n", strerror(errno));
+            return -1;
+        }
+        client->rx_len += (uint32_t) received;
+    }
+
+    return 0;
+}
+
+/*
+ * Receive one response, text line or binary frame, into response. Returns its length or -1.
+ */
+static int client_receive(client_t *client, uint8_t *response)
+{
+    double deadline = now_ms() + client->timeout_ms;
+    uint8_t *newline = NULL;
+    uint32_t length = 0;
+
+    if(0 != client_fill(client, 1, deadline))
+    {
+        return -1;
+    }
+
+    if(BIN_SYNC == client->rx[0])
+    {
+        if(0 != client_fill(client, BIN_HEADER_LEN, deadline))
+        {
+            return -1;
+        }
+        length = BIN_HEADER_LEN + (uint32_t)(client->rx[4] | (client->rx[5] << 8)) + BIN_CRC_LEN;
+        if(0 != client_fill(client, length, deadline))
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        while(NULL == (newline = memchr(client->rx, '\n', client->rx_len)))
+        {
+            if((client->rx_len >= sizeof(client->rx)) || (0 != client_fill(client, client->rx_len + 1, deadline)))
+            {
+                return -1;
+            }
+        }
+        length = (uint32_t)(newline - client->rx) + 1;
+    }
+
+    memcpy(response, client->rx, length);
+    client->rx_len -= length;
+    memmove(client->rx, client->rx + length, client->rx_len);
+
+    return (int) length;
+}
+
+/*
+ * Build a binary request from "bin,<cmd>[,<type>:<hex>]..." arguments
+ */
+static int build_binary_request(client_t *client, uint8_t command, char *tlvs, uint8_t *frame)
+{
+    uint32_t length = BIN_HEADER_LEN;
+    char *saveptr = NULL;
+    char *tlv = NULL;
+    char *hex = NULL;
+    uint32_t value_len = 0;
+    uint16_t crc = 0;
+    unsigned int byte = 0;
+
+    for(tlv = strtok_r(tlvs, ",", &saveptr); NULL != tlv; tlv = strtok_r(NULL, ",", &saveptr))
+    {
+        hex = strchr(tlv, ':');
+        if(NULL == hex)
+        {
+            fprintf(stderr, "Invalid TLV %s, expected <type>:<hex>\n", tlv);
+            return -1;
+        }
+        hex++;
+        value_len = (uint32_t)(strlen(hex) / 2);
+        if((value_len > 255) || (length + 2 + value_len + BIN_CRC_LEN > MAX_FRAME_LEN))
+        {
+            fprintf(stderr, "TLV %s too long\n", tlv);
+            return -1;
+        }
+
+        frame[length++] = (uint8_t) strtoul(tlv, NULL, 0);
+        frame[length++] = (uint8_t) value_len;
+        while(value_len-- > 0)
+        {
+            if(1 != sscanf(hex, "%2x", &byte))
+            {
+                fprintf(stderr, "Invalid hex value in TLV %s\n", tlv);
+                return -1;
+            }
+            frame[length++] = (uint8_t) byte;
+            hex += 2;
+        }
+    }
+
+    frame[0] = BIN_SYNC;
+    frame[1] = command;
+    frame[2] = client->sequence++;
+    frame[3] = 0;
+    frame[4] = (uint8_t)((length - BIN_HEADER_LEN) & 0xFF);
+    frame[5] = (uint8_t)((length - BIN_HEADER_LEN) >> 8);
+    crc = crc16(frame, length);
+    frame[length++] = (uint8_t)(crc & 0xFF);
+    frame[length++] = (uint8_t)(crc >> 8);
+
+    return (int) length;
+}
+
+static void print_response(const uint8_t *response, int length)
+{
+    int index = 0;
+
+    if(BIN_SYNC == response[0])
+    {
+        printf("  <- bin cmd:%u seq:%u status:%u payload:", response[1] & ~BIN_RESPONSE, response[2], response[3]);
+        for(index = BIN_HEADER_LEN; index < (length - BIN_CRC_LEN); index++)
+        {
+            printf("%02X", response[index]);
+        }
+        printf("\n");
+    }
+    else
+    {
+        printf("  <- %.*s\n", (int) strcspn((const char*) response, "\r\n"), response);
+    }
+}
+
+static bool response_ok(const uint8_t *response, int length)
+{
+    if(BIN_SYNC == response[0])
+    {
+        return (0 == response[3]);
+    }
+
+    return ((length >= (int) strlen(TEXT_RESPONSE_OK)) &&
+            (0 == memcmp(response, TEXT_RESPONSE_OK, strlen(TEXT_RESPONSE_OK))));
+}
+
+static int client_get_stats(client_t *client, tuner_stats_t *stats)
+{
+    uint8_t frame[BIN_HEADER_LEN + BIN_CRC_LEN];
+    uint8_t response[MAX_FRAME_LEN];
+    char no_tlv[] = "";
+    int length = 0;
+    int index = 0;
+
+    length = build_binary_request(client, BIN_CMD_GET_TUNER_STATS, no_tlv, frame);
+    if((length < 0) || (0 != client_send(client, frame, (uint32_t) length)))
+    {
+        return -1;
+    }
+
+    length = client_receive(client, response);
+    if(length < 0)
+    {
+        return -1;
+    }
+
+    /* STATS TLV: 3 x uint32 little endian */
+    for(index = BIN_HEADER_LEN; (index + 2 + 12) <= (length - BIN_CRC_LEN); index += 2 + response[index + 1])
+    {
+        if((BIN_TLV_STATS == response[index]) && (12 == response[index + 1]))
+        {
+            stats->updates_applied = get_u32(&response[index + 2]);
+            stats->last_apply_latency_ms = get_u32(&response[index + 6]);
+            stats->max_apply_latency_ms = get_u32(&response[index + 10]);
+            return 0;
+        }
+    }
+
+    fprintf(stderr, "Tuner stats not supported by AFE\n");
+    return -1;
+}
+
+/*
+ * Wait till AFE applied an update after updates_before, returns the time from send_time in ms
+ */
+static int client_wait_applied(client_t *client, uint32_t updates_before, double send_time, double *apply_ms,
+        tuner_stats_t *stats)
+{
+    double deadline = now_ms() + client->timeout_ms;
+
+    do
+    {
+        if(0 != client_get_stats(client, stats))
+        {
+            return -1;
+        }
+        if(stats->updates_applied != updates_before)
+        {
+            *apply_ms = now_ms() - send_time;
+            return 0;
+        }
+    } while(now_ms() < deadline);
+
+    fprintf(stderr, "Update not applied within %d ms\n", client->timeout_ms);
+    return -1;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s (-u <path> | -p <port> [-h <host>]) [-n <repeat>] [-a] [-t <timeout_ms>] [-q] <script|->\n"
+            "  -u  Unix domain socket path of the AFE tuner transport\n"
+            "  -p  TCP port of the AFE tuner transport, host defaults to 127.0.0.1\n"
+            "  -n  Replay the script n times\n"
+            "  -a  After each accepted set or commit, wait till AFE applied it and measure apply latency\n"
+            "  -t  Response timeout, default %d ms\n"
+            "  -q  Do not print the commands and responses\n", name, DEFAULT_TIMEOUT_MS);
+}
+
+/******************************************************
+ *               Functions
+ ******************************************************/
+int main(int argc, char *argv[])
+{
+    static client_t client;
+    static uint8_t frame[MAX_FRAME_LEN];
+    static uint8_t response[MAX_FRAME_LEN];
+    samples_t round_trip = { NULL, 0, 0 };
+    samples_t apply = { NULL, 0, 0 };
+    samples_t afe_apply = { NULL, 0, 0 };
+    tuner_stats_t stats;
+    const char *unix_path = NULL;
+    const char *host = "127.0.0.1";
+    const char *script_name = NULL;
+    char line[MAX_LINE_LEN];
+    FILE *script = NULL;
+    uint16_t port = 0;
+    uint32_t repeat = 1;
+    uint32_t iteration = 0;
+    uint32_t failures = 0;
+    uint32_t updates_before = 0;
+    bool measure_apply = false;
+    bool quiet = false;
+    bool expect_response = false;
+    bool is_set = false;
+    bool is_commit = false;
+    uint8_t command = 0;
+    double send_time = 0;
+    double elapsed = 0;
+    double apply_ms = 0;
+    double start = 0;
+    int length = 0;
+    int opt = 0;
+
+    client.timeout_ms = DEFAULT_TIMEOUT_MS;
+
+    while(-1 != (opt = getopt(argc, argv, "u:p:h:n:at:q")))
+    {
+        switch(opt)
+        {
+            case 'u': unix_path = optarg; break;
+            case 'p': port = (uint16_t) strtoul(optarg, NULL, 0); break;
+            case 'h': host = optarg; break;
+            case 'n': repeat = (uint32_t) strtoul(optarg, NULL, 0); break;
+            case 'a': measure_apply = true; break;
+            case 't': client.timeout_ms = atoi(optarg); break;
+            case 'q': quiet = true; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+
+    if((optind != (argc - 1)) || ((NULL == unix_path) && (0 == port)))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    script_name = argv[optind];
+
+    if(0 != client_connect(&client, unix_path, host, port))
+    {
+        return 1;
+    }
+
+    start = now_ms();
+    for(iteration = 0; iteration < repeat; iteration++)
+    {
+        script = (0 == strcmp(script_name, "-")) ? stdin : fopen(script_name, "r");
+        if(NULL == script)
+        {
+            fprintf(stderr, "Cannot open %s: %s\n", script_name, strerror(errno));
+            return 1;
+        }
+
+        while(NULL != fgets(line, sizeof(line), script))
+        {
+            line[strcspn(line, "\r\n")] = '\0';
+            if(('\0' == line[0]) || ('#' == line[0]))
+            {
+                continue;
+            }
+
+            if(0 == strncmp(line, "sleep,", strlen("sleep,")))
+            {
+                sleep_ms(strtoul(line + strlen("sleep,"), NULL, 0));
+                continue;
+            }
+
+            if(0 == strcmp(line, "stats"))
+            {
+                if(0 != client_get_stats(&client, &stats))
+                {
+                    return 1;
+                }
+                printf("stats: updates_applied=%"PRIu32" last_apply_latency=%"PRIu32" ms max_apply_latency=%"PRIu32" ms\n",
+                        stats.updates_applied, stats.last_apply_latency_ms, stats.max_apply_latency_ms);
+                continue;
+            }
+
+            if(!quiet)
+            {
+                printf("-> %s\n", line);
+            }
+
+            if(0 == strncmp(line, "bin,", strlen("bin,")))
+            {
+                command = (uint8_t) strtoul(line + strlen("bin,"), NULL, 0);
+                length = build_binary_request(&client, command, strchr(line + strlen("bin,"), ',') ?
+                        strchr(line + strlen("bin,"), ',') + 1 : line + strlen(line), frame);
+                if(length < 0)
+                {
+                    return 1;
+                }
+                is_set = (BIN_CMD_SET_COMPONENT_STATE == command) || (BIN_CMD_SET_CONFIG_VALUE == command) ||
+                        (BIN_CMD_SET_AUDIO_CHANNELS == command);
+                is_commit = (BIN_CMD_COMMIT == command);
+                if(BIN_CMD_BEGIN == command)
+                {
+                    client.transaction_open = true;
+                }
+                else if((BIN_CMD_COMMIT == command) || (BIN_CMD_ABORT == command))
+                {
+                    client.transaction_open = false;
+                }
+            }
+            else
+            {
+                length = snprintf((char*) frame, sizeof(frame), "%s\r\n", line);
+                is_set = (0 == strncmp(line, "set,", strlen("set,")));
+                is_commit = (0 == strcmp(line, "commit"));
+                if(0 == strcmp(line, "begin"))
+                {
+                    client.transaction_open = true;
+                }
+                else if((0 == strcmp(line, "commit")) || (0 == strcmp(line, "abort")))
+                {
+                    client.transaction_open = false;
+                }
+            }
+
+            /* Staged set commands are answered by the commit */
+            expect_response = !(is_set && client.transaction_open);
+
+            if(measure_apply && (is_set || is_commit) && expect_response)
+            {
+                if(0 != client_get_stats(&client, &stats))
+                {
+                    return 1;
+                }
+                updates_before = stats.updates_applied;
+            }
+
+            send_time = now_ms();
+            if(0 != client_send(&client, frame, (uint32_t) length))
+            {
+                return 1;
+            }
+
+            if(!expect_response)
+            {
+                continue;
+            }
+
+            length = client_receive(&client, response);
+            if(length < 0)
+            {
+                return 1;
+            }
+            elapsed = now_ms() - send_time;
+            samples_add(&round_trip, elapsed);
+
+            if(!quiet)
+            {
+                print_response(response, length);
+                printf("     round trip %.3f ms\n", elapsed);
+            }
+
+            if(!response_ok(response, length))
+            {
+                failures++;
+                continue;
+            }
+
+            if(measure_apply && (is_set || is_commit))
+            {
+                if(0 != client_wait_applied(&client, updates_before, send_time, &apply_ms, &stats))
+                {
+                    return 1;
+                }
+                samples_add(&apply, apply_ms);
+                samples_add(&afe_apply, (double) stats.last_apply_latency_ms);
+                if(!quiet)
+                {
+                    printf("     applied after %.3f ms, AFE reported %"PRIu32" ms\n", apply_ms, stats.last_apply_latency_ms);
+                }
+            }
+        }
+
+        if(stdin != script)
+        {
+            fclose(script);
+        }
+    }
+
+    printf("\n%"PRIu32" iteration(s) in %.3f ms, %"PRIu32" command(s) failed\n", repeat, now_ms() - start, failures);
+    samples_print("round trip", &round_trip);
+    if(measure_apply)
+    {
+        samples_print("apply", &apply);
+        samples_print("AFE apply", &afe_apply);
+    }
+
+    close(client.fd);
+    free(round_trip.values);
+    free(apply.values);
+    free(afe_apply.values);
+
+    return (0 == failures) ? 0 : 3;
+}